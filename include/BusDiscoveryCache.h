@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @brief Devices found on the I2C and OneWire buses, kept across wakes
+ *
+ * A full I2C scan probes 126 addresses and a OneWire enumeration runs one
+ * ROM search per device plus a final empty one. The results are kept in RTC
+ * memory so later wakes can address devices directly. A copy is written to
+ * NVS whenever it changes; it is used after a software, watchdog or brown-out
+ * reset, which clears RTC memory but leaves the buses as they were. Only a
+ * power-on rescans the buses, since devices can only have been swapped with
+ * the power off. Drivers invalidate their bus after a failed read so the next
+ * wake rescans it.
+ */
+class BusDiscoveryCache {
+public:
+    static constexpr uint8_t ROM_SIZE = 8;
+
+    /**
+     * @brief Check if a cached I2C scan exists
+     */
+    static bool hasI2CScan();
+
+    /**
+     * @brief Check if the cached I2C scan found a device
+     * @return false if the device was not found or no scan is cached
+     */
+    static bool isI2CDevicePresent(uint8_t address);
+
+    /**
+     * @brief Remember the result of a full I2C scan
+     * @param addresses 7-bit addresses that acknowledged
+     * @param count Number of addresses
+     */
+    static void storeI2CScan(const uint8_t* addresses, size_t count);
+
+    /**
+     * @brief Force a full I2C scan on the next wake
+     */
+    static void invalidateI2C();
+
+    /**
+     * @brief Check if a cached OneWire enumeration exists
+     */
+    static bool hasOneWireScan();
+
+    /**
+     * @brief Number of cached OneWire devices
+     */
+    static uint8_t getOneWireCount();
+
+    /**
+     * @brief Check if the cached OneWire bus uses parasite power
+     */
+    static bool isOneWireParasite();
+
+    /**
+     * @brief Copy the ROM code of a cached OneWire device
+     * @return false if no device with that index is cached
+     */
+    static bool getOneWireDevice(uint8_t index, uint8_t* rom);
+
+    /**
+     * @brief Remember the result of a full OneWire enumeration
+     * @param roms ROM codes in enumeration order (at most Config::ONEWIRE_MAX_DEVICES are kept)
+     * @param count Number of devices
+     * @param parasite Whether any device uses parasite power
+     */
+    static void storeOneWireScan(const uint8_t (*roms)[ROM_SIZE], uint8_t count, bool parasite);
+
+    /**
+     * @brief Force a full OneWire enumeration on the next wake
+     */
+    static void invalidateOneWire();
+
+#ifdef NATIVE_BUILD
+    /**
+     * @brief Check the reset reason and reload the record on next use, as the
+     *        next boot does
+     */
+    static void reload();
+#endif
+};
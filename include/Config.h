@@ -10,8 +10,41 @@
  */
 class Config {
 public:
+    /**
+     * @brief SCD-41 acquisition mode
+     */
+    enum class SCD41Mode : uint8_t {
+        PERIODIC,               // Continuous 5 s measurements, restarted on every wake
+        PERIODIC_PERSISTENT,    // Continuous measurements left running across deep sleep (mains-powered nodes)
+        SINGLE_SHOT,            // One CO2 + temperature + humidity measurement per wake, then power down
+        SINGLE_SHOT_RHT_ONLY    // Temperature + humidity only (no CO2), then power down
+    };
+
+    /**
+     * @brief DS18B20 conversion resolution policy
+     */
+    enum class DS18B20ResolutionMode : uint8_t {
+        FIXED,      // Always DS18B20_RESOLUTION
+        ADAPTIVE    // DS18B20_FAST_RESOLUTION while stable, DS18B20_RESOLUTION when moving or near an alert
+    };
+
+    /**
+     * @brief How often the node samples and what it uploads
+     */
+    enum class SamplingMode : uint8_t {
+        ADAPTIVE,       // Sleep from the readings' rate of change, upload readings that moved plus aggregates
+        AGGREGATE_ONLY  // Sample every FAST_SAMPLING_SECONDS, upload window aggregates only (no raw rows)
+    };
+
     // Deep Sleep Configuration
-    static constexpr unsigned long SLEEP_DURATION_SECONDS = 900; // 15 minutes
+    static constexpr SamplingMode SAMPLING_MODE = SamplingMode::ADAPTIVE;
+    static constexpr uint32_t FAST_SAMPLING_SECONDS = 60;        // AGGREGATE_ONLY: 60 samples per window
+    static constexpr unsigned long SLEEP_DURATION_SECONDS = 900; // 15 minutes, until trends are known
+    static constexpr uint32_t SLEEP_MIN_SECONDS = 300;           // Fast-moving or near an alert threshold
+    static constexpr uint32_t SLEEP_MAX_SECONDS = 3600;          // Flat readings
+    static constexpr uint8_t SLEEP_HISTORY_SAMPLES = 6;          // Readings per stream for the rate of change
+    static constexpr float SLEEP_CO2_ALERT_PPM = 1000.0f;        // Ventilation threshold
+    static constexpr float SLEEP_CO2_ALERT_MARGIN_PPM = 100.0f;
     static constexpr uint64_t uS_TO_S_FACTOR = 1000000ULL;
 
     // I2C Configuration for ESP32-C3
@@ -25,21 +58,97 @@ public:
 
     // DS18B20 Configuration  
     static constexpr uint8_t DS18B20_PIN = 8;
-    static constexpr uint16_t DS18B20_CONVERSION_DELAY_MS = 1000;
+    static constexpr uint8_t DS18B20_RESOLUTION = 12;  // 0.0625 °C steps, 750 ms conversion
+    static constexpr DS18B20ResolutionMode DS18B20_RESOLUTION_MODE = DS18B20ResolutionMode::ADAPTIVE;
+    static constexpr uint8_t DS18B20_FAST_RESOLUTION = 9;        // 0.5 °C steps, 94 ms conversion
+    static constexpr float DS18B20_STABLE_DELTA_C = 0.5f;        // Drift from the last full reading still counted as stable
+    static constexpr float DS18B20_ALERT_LOW_C = 0.0f;           // Frost
+    static constexpr float DS18B20_ALERT_HIGH_C = 30.0f;
+    static constexpr float DS18B20_ALERT_MARGIN_C = 1.0f;        // Full resolution this close to an alert threshold
 
     // SCD-41 Configuration
     static constexpr uint8_t SCD41_I2C_ADDRESS = 0x62;
     static constexpr uint16_t SCD41_STARTUP_DELAY_MS = 6000;
     static constexpr uint16_t SCD41_RETRY_ATTEMPTS = 100;
     static constexpr uint16_t SCD41_RETRY_DELAY_MS = 100;
+    static constexpr SCD41Mode SCD41_MODE = SCD41Mode::PERIODIC;  // SINGLE_SHOT suits battery nodes
+    static constexpr uint16_t SCD41_SINGLE_SHOT_DURATION_MS = 5000;
+    static constexpr uint16_t SCD41_SINGLE_SHOT_RHT_DURATION_MS = 50;
+
+    // Bus Discovery Cache (I2C scan and OneWire ROM codes kept across wakes)
+    static constexpr uint8_t ONEWIRE_MAX_DEVICES = 8;
+    static constexpr const char* BUS_CACHE_NVS_NAMESPACE = "bus-cache";
+
+    // Sensor Acquisition Configuration
+    static constexpr uint16_t SENSOR_POLL_INTERVAL_MS = 10;
+    static constexpr uint32_t SENSOR_ACQUISITION_TIMEOUT_MS = 20000;
 
     // WiFi Configuration
     static constexpr uint32_t WIFI_TIMEOUT_MS = 30000;
-    static constexpr uint16_t WIFI_RETRY_DELAY_MS = 500;
+    static constexpr uint16_t WIFI_POLL_INTERVAL_MS = 50;
+    static constexpr uint32_t WIFI_FAST_CONNECT_TIMEOUT_MS = 3000; // Cached AP/lease, then full connect
+    static constexpr uint32_t WIFI_CACHE_MAX_REUSES = 24;          // Full DHCP connect to renew the lease
+
+    // Time Synchronization (timestamps buffered readings before upload)
+    static constexpr const char* NTP_SERVER = "pool.ntp.org";
+    static constexpr uint32_t NTP_TIMEOUT_MS = 2000;
+
+    // MQTT Configuration (broker address and credentials in credentials.h)
+    static constexpr bool MQTT_ENABLED = true;
+    static constexpr const char* MQTT_DEVICE_ID = "sensor-node-01";
+    static constexpr const char* MQTT_TOPIC_PREFIX = "sensors";
+    static constexpr uint16_t MQTT_BUFFER_SIZE = 1024;          // Largest message, topic included
+    static constexpr uint16_t MQTT_KEEPALIVE_SECONDS = 60;
+    static constexpr uint16_t MQTT_SOCKET_TIMEOUT_SECONDS = 2;  // Library default is 15 s
+    static constexpr uint32_t MQTT_CONNECT_BUDGET_MS = 5000;     // Total time one reconnect may block
+    static constexpr uint32_t MQTT_RETRY_DELAY_MS = 250;
+    static constexpr uint32_t MQTT_RECONNECT_INTERVAL_MS = 30000; // Fail fast after a failed reconnect
+
+    // Fan-out Publishing (Supabase as the primary, MQTT as a secondary)
+    static constexpr size_t FANOUT_MAX_BACKENDS = 2;
+
+    // Reading Buffer Configuration (readings kept in RTC memory between uploads)
+    static constexpr size_t READING_BUFFER_CAPACITY = 128;          // 8 bytes per entry
+    static constexpr uint32_t READING_BUFFER_UPLOAD_INTERVAL_SECONDS = 3600; // On the buffer clock, whatever the sleep
+    static constexpr bool READING_BUFFER_UPLOAD_ON_POWER_ON = true;  // Verify connectivity after reset
+
+    // Deadband Filtering (readings buffered only when they moved, plus a heartbeat)
+    static constexpr float DEADBAND_TEMPERATURE_C = 0.2f;
+    static constexpr float DEADBAND_HUMIDITY_PERCENT = 2.0f;        // DHT11 reports whole percent
+    static constexpr float DEADBAND_CO2_PPM = 30.0f;                // About the SCD-41 accuracy
+    static constexpr uint32_t DEADBAND_MAX_SILENCE_SECONDS = 21600; // Heartbeat every 6 hours
+
+    // Streaming Aggregation (min/max/mean/stddev per window, separate table)
+    static constexpr uint32_t AGGREGATE_WINDOW_SECONDS = 3600;
+    static constexpr size_t AGGREGATE_PENDING_CAPACITY = 48;        // 32 bytes per window
+    static constexpr size_t AGGREGATE_UPLOAD_MIN_WINDOWS = 24;      // Upload for aggregates alone from here
+
+    // Outage Log Configuration (failed uploads stored in LittleFS for replay)
+    static constexpr uint32_t OUTAGE_LOG_SEGMENT_BYTES = 4096;      // One flash sector
+    static constexpr uint32_t OUTAGE_LOG_MAX_SEGMENTS = 8;          // About 9 days of readings
+    static constexpr size_t OUTAGE_LOG_REPLAY_BATCH_SIZE = 64;
+    static constexpr uint8_t OUTAGE_LOG_REPLAY_BATCHES_PER_WAKE = 4;
+    static constexpr uint32_t OUTAGE_LOG_REPLAY_INTERVAL_MS = 250;
+
+    // Display History (RTC ring of slot averages, drawn as a sparkline)
+    static constexpr uint32_t HISTORY_SLOT_SECONDS = 900;           // 15-minute resolution
+    static constexpr size_t HISTORY_SLOTS = 96;                     // 24 hours, 2 bytes per slot
+
+    // Wake Profiler Configuration
+    static constexpr uint32_t PROFILER_SUMMARY_INTERVAL_SECONDS = 86400; // Daily on the ReadingBuffer clock
 
     // Serial Configuration
     static constexpr uint32_t SERIAL_BAUD_RATE = 115200;
 
+    // Default sensor locations and tables. Plain literals, so globals can be
+    // constructed from them before initialize() has run
+    static constexpr const char* DEFAULT_DHT_LOCATION = "alex-room";
+    static constexpr const char* DEFAULT_DS18B20_LOCATION = "alex-outside";
+    static constexpr const char* DEFAULT_SCD41_LOCATION = "alex-room";
+    static constexpr const char* DEFAULT_SUPABASE_TABLE_NAME = "environment_measurements";
+    static constexpr const char* DEFAULT_PROFILER_TABLE_NAME = "wake_profiles";
+    static constexpr const char* DEFAULT_AGGREGATE_TABLE_NAME = "environment_aggregates";
+
     // Sensor Locations (can be overridden at runtime)
     static String DHT_LOCATION;
     static String DS18B20_LOCATION;
@@ -47,6 +156,8 @@ public:
 
     // Supabase Configuration
     static String SUPABASE_TABLE_NAME;
+    static String PROFILER_TABLE_NAME;
+    static String AGGREGATE_TABLE_NAME;
 
     /**
      * @brief Initialize default configuration values
@@ -10,35 +10,38 @@
  * Implements the ISensor interface for DHT11 sensor.
  * Provides temperature and humidity readings.
  */
-class DHT11Sensor : public ISensor {
+class DHT11Sensor final : public ISensor {
 public:
-    enum class ReadingType {
-        TEMPERATURE = 0,
-        HUMIDITY = 1
-    };
-
     /**
      * @brief Constructor
-     * @param location Sensor location identifier
+     * @param location Sensor location identifier (kept by pointer, e.g. a Config constant)
      */
-    explicit DHT11Sensor(const String& location = Config::DHT_LOCATION);
+    explicit DHT11Sensor(const char* location = Config::DEFAULT_DHT_LOCATION);
 
     /**
      * @brief Destructor
      */
     ~DHT11Sensor() override = default;
 
+    // Measurement kinds in collectReading() order, and the ones that are uploaded
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::TEMPERATURE, MeasurementKind::HUMIDITY};
+    static constexpr MeasurementKind PUBLISHED_KINDS[] = {MeasurementKind::TEMPERATURE, MeasurementKind::HUMIDITY};
+
     // ISensor interface implementation
     bool initialize() override;
     bool isReady() const override;
-    String getName() const override { return "DHT11"; }
-    String getLocation() const override { return location; }
-    bool readSensor(std::vector<Reading>& readings) override;
+    const char* getName() const override { return "DHT11"; }
+    const char* getLocation() const override { return location; }
+    bool startReading() override;
+    bool isReadingComplete() override;
+    bool collectReading(Readings& readings) override;
 
 private:
-    String location;
+    const char* location;
     DHT dht;
     unsigned long lastReadTime;
+    unsigned long acquisitionStartTime;
+    bool acquisitionPending;
     static constexpr unsigned long MIN_READ_INTERVAL_MS = 2000;
 
     bool isValidReading(float value) const;
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include "Config.h"
+
+/**
+ * @brief OneWire bus shared by all DS18B20 probes on one pin
+ *
+ * Every probe on the bus converts at once on a single Skip ROM broadcast, so
+ * N probes cost one conversion time instead of N. The conversion is started
+ * by the first probe that asks for it and waited for without blocking, for
+ * exactly as long as the resolution needs. Probes are then read one by one
+ * by their ROM code (kept in BusDiscoveryCache), which avoids a ROM search
+ * per read.
+ *
+ * In ADAPTIVE mode each wake first converts at the fast resolution. If any
+ * requested probe has drifted from its last full-resolution reading (kept in
+ * RTC memory) or is close to an alert threshold, the bus converts again at
+ * full resolution before the readings are handed out. Otherwise each stable
+ * probe reports its full-resolution reference, so only full-resolution values
+ * are ever published and the fast conversion's rounding never shows up as a
+ * change. The resolution is switched in the probes' scratchpads only; their
+ * EEPROM keeps the full resolution as the power-on default and is not worn by
+ * the switching.
+ */
+class DS18B20Bus {
+public:
+    /**
+     * @brief Constructor
+     * @param pin OneWire data pin
+     * @param resolution Full conversion resolution in bits (9-12)
+     * @param mode Resolution policy
+     */
+    explicit DS18B20Bus(uint8_t pin = Config::DS18B20_PIN,
+                        uint8_t resolution = Config::DS18B20_RESOLUTION,
+                        Config::DS18B20ResolutionMode mode = Config::DS18B20_RESOLUTION_MODE);
+
+    /**
+     * @brief Find the probes on the bus (once per wake, cached across wakes)
+     * @return true if at least one probe is present
+     */
+    bool begin();
+
+    /**
+     * @brief Request a reading of one probe, starting a broadcast conversion
+     *        unless one is already running
+     * @param index Probe index in enumeration order
+     */
+    bool requestConversion(uint8_t index);
+
+    /**
+     * @brief Advance the running conversion (may restart it at full resolution)
+     * @return true once the requested readings are available
+     */
+    bool poll();
+
+    /**
+     * @brief Check if the requested readings are available
+     */
+    bool isConversionComplete() const;
+
+    /**
+     * @brief Get the reading of one probe from the completed conversion
+     * @param index Probe index in enumeration order
+     * @return Temperature in °C, or DEVICE_DISCONNECTED_C
+     */
+    float readTemperature(uint8_t index);
+
+    /**
+     * @brief Release a reading obtained with requestConversion()
+     */
+    void releaseConversion(uint8_t index);
+
+    /**
+     * @brief Mark the probe list stale so the next wake re-enumerates the bus
+     */
+    void invalidate();
+
+    /**
+     * @brief Time a conversion takes at a resolution (datasheet maximum)
+     */
+    static uint32_t getConversionTimeMs(uint8_t resolution);
+
+    /**
+     * @brief Check if a value is a plausible DS18B20 temperature
+     */
+    static bool isValidTemperature(float temperature);
+
+    uint8_t getDeviceCount() const { return deviceCount; }
+    bool isParasitePowerMode() const { return parasitePower; }
+    /**
+     * @brief Resolution of the last conversion; stable probes still report
+     *        their full-resolution reference
+     */
+    uint8_t getResolution() const { return conversionResolution; }
+    const char* getLastError() const { return lastError; }
+
+private:
+    enum class Phase : uint8_t {
+        IDLE,
+        CONVERTING,
+        DONE
+    };
+
+    OneWire oneWire;
+    DallasTemperature dallas;
+    uint8_t resolution;
+    Config::DS18B20ResolutionMode mode;
+    DeviceAddress roms[Config::ONEWIRE_MAX_DEVICES];
+    float temperatures[Config::ONEWIRE_MAX_DEVICES];
+    uint8_t deviceCount;
+    bool parasitePower;
+    bool started;
+    Phase phase;
+    uint8_t requestedMask;
+    uint8_t readMask;
+    uint8_t conversionResolution;
+    unsigned long conversionStartTime;
+    const char* lastError;
+
+    bool enumerateDevices();
+    uint8_t chooseResolution() const;
+    void startConversion(uint8_t bits);
+    void applyResolution(uint8_t bits);
+    bool needsFullResolution(uint8_t index) const;
+    void updateReferences();
+    void useReferences();
+};
@@ -2,35 +2,43 @@
 
 #include "ISensor.h"
 #include "Config.h"
-#include <OneWire.h>
-#include <DallasTemperature.h>
+#include "DS18B20Bus.h"
 
 /**
  * @brief DS18B20 Digital Temperature Sensor
  * 
- * Implements the ISensor interface for DS18B20 OneWire temperature sensor.
- * Supports multiple sensors on the same bus.
+ * Implements the ISensor interface for one DS18B20 probe on a DS18B20Bus.
+ * Probes sharing a bus share one broadcast conversion: the first probe to
+ * start a reading starts it for all of them.
  */
-class DS18B20Sensor : public ISensor {
+class DS18B20Sensor final : public ISensor {
 public:
     /**
      * @brief Constructor
-     * @param location Sensor location identifier
+     * @param bus OneWire bus the probe is connected to
+     * @param location Sensor location identifier (kept by pointer, e.g. a Config constant)
      * @param deviceIndex Index of device on OneWire bus (default: 0)
      */
-    explicit DS18B20Sensor(const String& location = Config::DS18B20_LOCATION, uint8_t deviceIndex = 0);
+    explicit DS18B20Sensor(DS18B20Bus& bus, const char* location = Config::DEFAULT_DS18B20_LOCATION,
+                           uint8_t deviceIndex = 0);
 
     /**
      * @brief Destructor
      */
     ~DS18B20Sensor() override = default;
 
+    // Measurement kinds in collectReading() order, and the ones that are uploaded
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::TEMPERATURE};
+    static constexpr MeasurementKind PUBLISHED_KINDS[] = {MeasurementKind::TEMPERATURE};
+
     // ISensor interface implementation
     bool initialize() override;
     bool isReady() const override;
-    String getName() const override { return "DS18B20"; }
-    String getLocation() const override { return location; }
-    bool readSensor(std::vector<Reading>& readings) override;
+    const char* getName() const override { return "DS18B20"; }
+    const char* getLocation() const override { return location; }
+    bool startReading() override;
+    bool isReadingComplete() override;
+    bool collectReading(Readings& readings) override;
 
     /**
      * @brief Get number of devices found on the bus
@@ -43,13 +51,8 @@ public:
     bool isParasitePowerMode();
 
 private:
-    String location;
+    DS18B20Bus& bus;
+    const char* location;
     uint8_t deviceIndex;
-    OneWire oneWire;
-    DallasTemperature dallas;
-    unsigned long lastConversionTime;
-    static constexpr float INVALID_TEMPERATURE = -127.0f;
-    static constexpr unsigned long CONVERSION_TIMEOUT_MS = 2000;
-
-    bool isValidTemperature(float temperature) const;
-};
\ No newline at end of file
+    bool conversionPending;
+};
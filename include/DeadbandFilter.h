@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Config.h"
+#include "IDataPublisher.h"
+
+/**
+ * @brief Change-threshold filter that drops readings which have not moved
+ *
+ * For every location and measurement kind, the last value passed on and its
+ * time on the ReadingBuffer clock are kept in RTC memory. A new reading is
+ * passed on only if it differs from that value by at least the kind's
+ * deadband (Config::DEADBAND_TEMPERATURE_C, DEADBAND_HUMIDITY_PERCENT,
+ * DEADBAND_CO2_PPM), or if nothing was passed on for
+ * Config::DEADBAND_MAX_SILENCE_SECONDS. The heartbeat shows the node is still
+ * alive. Readings that pass are buffered for upload, and failed uploads go to
+ * the outage log, so passing on counts as published.
+ *
+ * After a power-on, or if the RTC copy is damaged, every reading passes.
+ */
+class DeadbandFilter {
+public:
+    /**
+     * @brief Remove data points that stay within their deadband
+     * @param points Data points of this wake; the ones passing remain, in order
+     * @param clockNow Current ReadingBuffer clock
+     * @return Number of data points removed
+     */
+    static size_t apply(std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow);
+
+    /**
+     * @brief Check if some reading will pass regardless of its value
+     *
+     * True after a power-on or once any stream's heartbeat is due. An upload
+     * wake can then start WiFi before the sensors are read.
+     */
+    static bool isHeartbeatDue(uint32_t clockNow);
+
+    /**
+     * @brief Smallest change of a kind that is passed on
+     */
+    static float getDeadband(MeasurementKind kind);
+};
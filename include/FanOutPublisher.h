@@ -0,0 +1,69 @@
+#pragma once
+
+#include "IDataPublisher.h"
+#include "Config.h"
+
+/**
+ * @brief Publishes the same readings to several backends
+ *
+ * Every backend (Supabase, MQTT, ...) gets each cycle in one publishCycle()
+ * call, so it goes out as one request per backend. The secondary backends
+ * publish first and the primary (the store of record) last, which leaves the
+ * points' published flags as the primary set them. A backend that fails to
+ * initialize is skipped for the rest of the wake, and a failing secondary
+ * does not affect what the primary stores.
+ *
+ * Backends publish one after the other on the calling task. A wake only
+ * uploads once its readings are in hand and sleeps right after, so there is
+ * no sampling left to overlap with the network work.
+ */
+class FanOutPublisher : public IDataPublisher {
+public:
+    FanOutPublisher();
+
+    /**
+     * @brief Destructor
+     */
+    ~FanOutPublisher() override = default;
+
+    /**
+     * @brief Add a backend; the first one added is the primary
+     * @param backend Publisher to forward readings to
+     * @return false if Config::FANOUT_MAX_BACKENDS backends are already added
+     */
+    bool addBackend(IDataPublisher& backend);
+
+    // IDataPublisher interface implementation
+    bool initialize() override;
+    bool isReady() const override;
+    PublishResult publish(const String& location, const String& type, float value) override;
+    int publishBatch(const String& sensorName, const String& location,
+                    const ISensor::Readings& readings) override;
+
+    /**
+     * @brief Publish a cycle to every backend
+     * @return Number of points the primary backend stored (the store of
+     *         record); the points' published flags follow the primary
+     */
+    int publishCycle(std::vector<DataPoint>& points) override;
+    String getName() const override { return "Fan-out"; }
+
+    size_t getBackendCount() const { return backendCount; }
+    const IDataPublisher& getBackend(size_t index) const { return *backends[index].publisher; }
+
+    /**
+     * @brief Points a backend stored since initialize()
+     */
+    uint32_t getDeliveredCount(size_t index) const { return backends[index].delivered; }
+
+private:
+    struct Backend {
+        IDataPublisher* publisher = nullptr;
+        bool enabled = false;       // initialize() succeeded
+        uint32_t delivered = 0;
+    };
+
+    Backend backends[Config::FANOUT_MAX_BACKENDS];
+    size_t backendCount;
+    bool initialized;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stddef.h>
+#include <initializer_list>
+#include <type_traits>
+
+/**
+ * @brief Vector with inline storage and a compile-time capacity
+ *
+ * Never allocates: elements live inside the object, so it can be kept in
+ * globals, on the stack or in RTC memory. push_back() on a full vector is
+ * rejected instead of growing. Limited to trivially copyable elements.
+ */
+template <typename T, size_t Capacity>
+class FixedVector {
+    static_assert(std::is_trivially_copyable<T>::value, "FixedVector holds trivially copyable types only");
+
+public:
+    FixedVector() = default;
+
+    FixedVector(std::initializer_list<T> values) {
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * @brief Append an element
+     * @return false if the vector is full (the element is dropped)
+     */
+    bool push_back(const T& value) {
+        if (count == Capacity) {
+            return false;
+        }
+        items[count++] = value;
+        return true;
+    }
+
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+private:
+    T items[Capacity] = {};
+    size_t count = 0;
+};
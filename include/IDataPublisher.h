@@ -1,8 +1,10 @@
 #pragma once
 
 #include <Arduino.h>
+#include <algorithm>
 #include <vector>
 #include "ISensor.h"
+#include "MeasurementKind.h"
 
 /**
  * @brief Abstract interface for data publishers
@@ -23,6 +25,37 @@ public:
             : success(success), responseCode(code), timestamp(millis()) {}
     };
 
+    /**
+     * @brief One row of a wake cycle's upload
+     */
+    struct DataPoint {
+        const char* location;   // Owned by the source (sensor, buffer, log); copy it to keep the point
+        MeasurementKind kind;
+        float value;
+        uint32_t timestamp; // UTC epoch seconds of the measurement, 0 = time of upload
+        bool published;
+
+        DataPoint(const char* location, MeasurementKind kind, float value, uint32_t timestamp = 0)
+            : location(location), kind(kind), value(value), timestamp(timestamp), published(false) {}
+    };
+
+    /**
+     * @brief Statistics of one location and kind over an aggregation window
+     */
+    struct Aggregate {
+        const char* location;   // Owned by StreamingAggregator until clearPending()
+        MeasurementKind kind;
+        uint32_t count;
+        float mean;
+        float stddev;           // Sample standard deviation, 0 for a single sample
+        float min;
+        float max;
+        float last;
+        uint32_t windowStart;   // UTC epoch seconds of the first sample, 0 = unknown
+        uint32_t windowEnd;     // UTC epoch seconds of the last sample, 0 = unknown
+        bool published;
+    };
+
     virtual ~IDataPublisher() = default;
 
     /**
@@ -50,13 +83,52 @@ public:
      * @brief Publish multiple readings from a sensor
      * @param sensorName Name/type of the sensor
      * @param location Sensor location
-     * @param readings Vector of sensor readings
-     * @param dataTypes Vector of data type names (temperature, humidity, etc.)
+     * @param readings Sensor readings (each carries its measurement kind)
      * @return Number of successfully published readings
      */
     virtual int publishBatch(const String& sensorName, const String& location, 
-                           const std::vector<ISensor::Reading>& readings,
-                           const std::vector<String>& dataTypes) = 0;
+                           const ISensor::Readings& readings) = 0;
+
+    /**
+     * @brief Publish all data points of a wake cycle at once
+     * 
+     * The default implementation publishes the points one by one; publishers
+     * that support bulk inserts override it to send a single request.
+     * @param points Data points to publish; each point's published flag is updated
+     * @return Number of successfully published data points
+     */
+    virtual int publishCycle(std::vector<DataPoint>& points) {
+        int successCount = 0;
+        for (auto& point : points) {
+            point.published = publish(point.location, measurementName(point.kind), point.value).success;
+            if (point.published) {
+                successCount++;
+            }
+        }
+        return successCount;
+    }
+
+    /**
+     * @brief Append the valid readings of a sensor as data points
+     * @param points Destination list
+     * @param location Sensor location
+     * @param readings Sensor readings
+     * @param kinds Measurement kinds to keep
+     * @return Number of data points appended
+     */
+    template <size_t N>
+    static size_t appendDataPoints(std::vector<DataPoint>& points, const char* location,
+                                   const ISensor::Readings& readings, const MeasurementKind (&kinds)[N]) {
+        return appendDataPoints(points, location, readings, kinds, N);
+    }
+
+    /**
+     * @brief Append all valid readings of a sensor as data points
+     */
+    static size_t appendDataPoints(std::vector<DataPoint>& points, const char* location,
+                                   const ISensor::Readings& readings) {
+        return appendDataPoints(points, location, readings, nullptr, 0);
+    }
 
     /**
      * @brief Get publisher name/type
@@ -71,6 +143,25 @@ public:
 protected:
     String lastError;
 
+    static size_t appendDataPoints(std::vector<DataPoint>& points, const char* location,
+                                   const ISensor::Readings& readings,
+                                   const MeasurementKind* kinds, size_t kindCount) {
+        size_t appended = 0;
+        for (const auto& reading : readings) {
+            if (kinds != nullptr && std::find(kinds, kinds + kindCount, reading.kind) == kinds + kindCount) {
+                continue;
+            }
+            if (reading.status == ISensor::Status::SUCCESS) {
+                points.emplace_back(location, reading.kind, reading.value);
+                appended++;
+            } else {
+                Serial.printf("⚠ Skipping invalid %s reading: %s\n", 
+                             measurementName(reading.kind), ISensor::errorCodeName(reading.error));
+            }
+        }
+        return appended;
+    }
+
     void setError(const String& error) {
         lastError = error;
         Serial.println("Publisher Error: " + error);
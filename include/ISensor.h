@@ -1,17 +1,29 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
+#include <stdarg.h>
+#include "Config.h"
+#include "FixedVector.h"
+#include "MeasurementKind.h"
 
 /**
  * @brief Abstract base class for all environmental sensors
  * 
  * Provides a common interface for reading sensor data and checking sensor status.
  * All concrete sensor implementations should inherit from this class.
+ * 
+ * Acquisition is split into startReading() / isReadingComplete() / collectReading()
+ * so that several sensors can convert at the same time (see SensorSet).
+ * readSensor() remains available as a blocking wrapper around those three steps.
+ *
+ * The acquisition path does not touch the heap: readings are plain structs in
+ * a fixed-capacity Readings container, and errors are an ErrorCode plus a
+ * message formatted into a fixed buffer. getLastError() builds a String for
+ * diagnostics only.
  */
 class ISensor {
 public:
-    enum class Status {
+    enum class Status : uint8_t {
         SUCCESS,
         FAILED,
         NOT_INITIALIZED,
@@ -19,17 +31,60 @@ public:
         INVALID_DATA
     };
 
+    enum class ErrorCode : uint8_t {
+        NONE = 0,
+        NOT_INITIALIZED,        // Used before initialize() succeeded
+        NOT_STARTED,            // collectReading() without startReading()
+        DEVICE_NOT_FOUND,       // Nothing answers on the bus
+        COMMUNICATION,          // Bus error, NACK or CRC failure
+        TIMEOUT,                // Measurement did not complete in time
+        INVALID_DATA,           // Value outside the sensor's valid range
+        NOT_MEASURED            // Quantity not measured in the current mode
+    };
+
     struct Reading {
+        MeasurementKind kind;
         float value;
         Status status;
-        String errorMessage;
-        unsigned long timestamp;
+        ErrorCode error;
+        uint32_t timestamp;
+
+        Reading()
+            : kind(MeasurementKind::TEMPERATURE), value(NAN), status(Status::NOT_INITIALIZED),
+              error(ErrorCode::NONE), timestamp(0) {}
+        Reading(MeasurementKind kind, float val, Status stat = Status::SUCCESS) 
+            : kind(kind), value(val), status(stat), error(ErrorCode::NONE), timestamp(millis()) {}
 
-        Reading() : value(NAN), status(Status::NOT_INITIALIZED), timestamp(0) {}
-        Reading(float val, Status stat = Status::SUCCESS) 
-            : value(val), status(stat), timestamp(millis()) {}
+        static Reading failed(MeasurementKind kind, Status status, ErrorCode error) {
+            Reading reading;
+            reading.kind = kind;
+            reading.status = status;
+            reading.error = error;
+            return reading;
+        }
     };
 
+    // CO2 + temperature + humidity is the most any sensor delivers
+    static constexpr size_t MAX_READINGS = 3;
+    using Readings = FixedVector<Reading, MAX_READINGS>;
+
+    /**
+     * @brief Short description of an error code (static string, for logs)
+     */
+    static const char* errorCodeName(ErrorCode error) {
+        switch (error) {
+            case ErrorCode::NONE: return "none";
+            case ErrorCode::NOT_INITIALIZED: return "not initialized";
+            case ErrorCode::NOT_STARTED: return "not started";
+            case ErrorCode::DEVICE_NOT_FOUND: return "device not found";
+            case ErrorCode::COMMUNICATION: return "communication error";
+            case ErrorCode::TIMEOUT: return "timeout";
+            case ErrorCode::INVALID_DATA: return "invalid data";
+            case ErrorCode::NOT_MEASURED: return "not measured";
+        }
+        return "unknown";
+    }
+
     virtual ~ISensor() = default;
 
     /**
@@ -46,35 +101,93 @@ public:
 
     /**
      * @brief Get sensor name/type
-     * @return String containing sensor name
+     * @return Static string containing sensor name (does not allocate)
      */
-    virtual String getName() const = 0;
+    virtual const char* getName() const = 0;
 
     /**
      * @brief Get sensor location identifier
-     * @return String containing location
+     * @return Location string that lives as long as the sensor (does not allocate)
+     */
+    virtual const char* getLocation() const = 0;
+
+    /**
+     * @brief Start a measurement without waiting for it
+     * @return true if the measurement was started, false otherwise
+     */
+    virtual bool startReading() = 0;
+
+    /**
+     * @brief Poll a started measurement
+     * @return true once collectReading() can be called (result may still be a failure)
+     */
+    virtual bool isReadingComplete() = 0;
+
+    /**
+     * @brief Collect the result of a completed measurement
+     * @param readings Container to store readings (sensor may provide multiple values)
+     * @return true if read successful, false otherwise
      */
-    virtual String getLocation() const = 0;
+    virtual bool collectReading(Readings& readings) = 0;
 
     /**
-     * @brief Read sensor data
-     * @param readings Vector to store readings (sensor may provide multiple values)
+     * @brief Read sensor data (blocking: start, wait for completion, collect)
+     * @param readings Container to store readings (sensor may provide multiple values)
      * @return true if read successful, false otherwise
      */
-    virtual bool readSensor(std::vector<Reading>& readings) = 0;
+    virtual bool readSensor(Readings& readings) {
+        readings.clear();
+
+        if (!startReading()) {
+            return false;
+        }
+
+        unsigned long startTime = millis();
+        while (!isReadingComplete()) {
+            if (millis() - startTime >= Config::SENSOR_ACQUISITION_TIMEOUT_MS) {
+                setError(ErrorCode::TIMEOUT, "%s measurement timed out", getName());
+                return false;
+            }
+            delay(Config::SENSOR_POLL_INTERVAL_MS);
+        }
+
+        return collectReading(readings);
+    }
 
     /**
-     * @brief Get last error message
+     * @brief Get last error message (diagnostics only: allocates)
      * @return String containing error description
      */
-    virtual String getLastError() const { return lastError; }
+    virtual String getLastError() const { return String(lastErrorMessage); }
+
+    /**
+     * @brief Get the code of the last error
+     */
+    ErrorCode getErrorCode() const { return lastErrorCode; }
+
+    /**
+     * @brief Get last error message without allocating
+     */
+    const char* getErrorMessage() const { return lastErrorMessage; }
 
 protected:
-    String lastError;
     bool initialized = false;
 
-    void setError(const String& error) {
-        lastError = error;
-        Serial.println("Sensor Error: " + error);
+    void setError(ErrorCode code, const char* format, ...) __attribute__((format(printf, 3, 4))) {
+        lastErrorCode = code;
+        va_list args;
+        va_start(args, format);
+        vsnprintf(lastErrorMessage, sizeof(lastErrorMessage), format, args);
+        va_end(args);
+        Serial.printf("Sensor Error: %s\n", lastErrorMessage);
+    }
+
+    void clearError() {
+        lastErrorCode = ErrorCode::NONE;
+        lastErrorMessage[0] = '\0';
     }
-};
\ No newline at end of file
+
+private:
+    ErrorCode lastErrorCode = ErrorCode::NONE;
+    char lastErrorMessage[80] = {};
+};
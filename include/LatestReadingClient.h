@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESPSupabase.h>
+
+/**
+ * @brief Incremental poll for the newest measurement of one location and type
+ *
+ * Remembers the created_at of the newest row seen and asks Supabase only for
+ * rows newer than that, using the PostgREST gt filter. While nothing new has
+ * been stored, the answer is an empty array that is recognized without
+ * parsing. A new row is parsed with an ArduinoJson filter that keeps only
+ * value and created_at, so the document stays a few dozen bytes whatever
+ * else the row carries.
+ *
+ * PostgREST does not send ETags for table reads, so If-None-Match is not
+ * used; the gt filter gives the same tiny "not modified" answer.
+ */
+class LatestReadingClient {
+public:
+    enum class Result {
+        UPDATED,    // A newer row was found; getValue() returns it
+        UNCHANGED,  // No row newer than the last one seen
+        FAILED      // Request or parse error; the last value is kept
+    };
+
+    /**
+     * @brief Constructor
+     * @param supabase Client initialized with begin()
+     * @param table Table to read
+     * @param location Location to filter on
+     * @param type Measurement type to filter on
+     */
+    LatestReadingClient(Supabase& supabase, const char* table, const char* location, const char* type);
+
+    /**
+     * @brief Ask for a row newer than the last one seen
+     */
+    Result poll();
+
+    /**
+     * @brief Check if any row has been received
+     */
+    bool hasValue() const { return newestCreatedAt[0] != '\0'; }
+
+    /**
+     * @brief Value of the newest row received
+     */
+    float getValue() const { return value; }
+
+    /**
+     * @brief created_at of the newest row received (empty if none)
+     */
+    const char* getCreatedAt() const { return newestCreatedAt; }
+
+private:
+    static constexpr size_t CREATED_AT_SIZE = 40;
+
+    Supabase& supabase;
+    const char* table;
+    const char* location;
+    const char* type;
+    char newestCreatedAt[CREATED_AT_SIZE];
+    float value;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Physical quantity a reading measures
+ *
+ * Every reading carries its kind, so publishers serialize straight from the
+ * reading instead of pairing it with a separate list of type names by index.
+ * Names are the values of the database's `type` column.
+ */
+enum class MeasurementKind : uint8_t {
+    TEMPERATURE = 0,
+    HUMIDITY,
+    CO2
+};
+
+constexpr size_t MEASUREMENT_KIND_COUNT = 3;
+
+struct MeasurementInfo {
+    const char* name;
+    const char* unit;
+    float scale;    // Factor for compact int16 storage
+};
+
+// int16 with these factors covers -327..327 °C / %RH and 0..32767 ppm CO2
+constexpr MeasurementInfo MEASUREMENT_INFO[MEASUREMENT_KIND_COUNT] = {
+    {"temperature", "°C", 100.0f},
+    {"humidity", "%", 100.0f},
+    {"co2", "ppm", 1.0f}
+};
+
+/**
+ * @brief Database/wire name of a kind (e.g. "temperature")
+ */
+constexpr const char* measurementName(MeasurementKind kind) {
+    return MEASUREMENT_INFO[static_cast<size_t>(kind)].name;
+}
+
+/**
+ * @brief Unit of a kind (e.g. "ppm")
+ */
+constexpr const char* measurementUnit(MeasurementKind kind) {
+    return MEASUREMENT_INFO[static_cast<size_t>(kind)].unit;
+}
+
+/**
+ * @brief Scale factor of a kind for storing values as int16
+ */
+constexpr float measurementScale(MeasurementKind kind) {
+    return MEASUREMENT_INFO[static_cast<size_t>(kind)].scale;
+}
+
+/**
+ * @brief Look up a kind by its database/wire name
+ * @return false if the name is unknown
+ */
+inline bool measurementKindFromName(const char* name, MeasurementKind& kind) {
+    for (size_t i = 0; i < MEASUREMENT_KIND_COUNT; i++) {
+        if (strcmp(MEASUREMENT_INFO[i].name, name) == 0) {
+            kind = static_cast<MeasurementKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
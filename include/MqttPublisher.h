@@ -0,0 +1,117 @@
+#pragma once
+
+#include "IDataPublisher.h"
+#include "Config.h"
+#include <WiFi.h>
+#include <PubSubClient.h>
+
+/**
+ * @brief MQTT data publisher implementation
+ *
+ * Implements the IDataPublisher interface on one PubSubClient session that is
+ * kept open between publishes. A whole cycle of readings is packed into a
+ * single JSON message on <prefix>/<device>/readings (split only if it would
+ * not fit Config::MQTT_BUFFER_SIZE), so an upload costs one PUBLISH instead
+ * of one request per reading.
+ *
+ * Retained messages are used where a new subscriber should see the latest
+ * state: the device status (online, with a retained "offline" last will) and
+ * single readings published with publish(). Cycle batches carry timestamped
+ * history and are sent non-retained.
+ *
+ * Topics are formatted once into fixed buffers and payloads are built in a
+ * fixed buffer, so publishing does not allocate. A reconnect blocks for at
+ * most Config::MQTT_CONNECT_BUDGET_MS; after a failed one, further attempts
+ * fail fast until Config::MQTT_RECONNECT_INTERVAL_MS has passed.
+ */
+class MqttPublisher : public IDataPublisher {
+public:
+    /**
+     * @brief Constructor
+     * @param server Broker host name or address
+     * @param port Broker port
+     * @param user Broker user name (nullptr for anonymous)
+     * @param password Broker password
+     * @param deviceId Client id and topic segment of this node
+     */
+    MqttPublisher(const char* server, uint16_t port, const char* user, const char* password,
+                  const char* deviceId = Config::MQTT_DEVICE_ID);
+
+    /**
+     * @brief Destructor
+     */
+    ~MqttPublisher() override = default;
+
+    // IDataPublisher interface implementation
+    bool initialize() override;
+    bool isReady() const override;
+    PublishResult publish(const String& location, const String& type, float value) override;
+    int publishBatch(const String& sensorName, const String& location,
+                    const ISensor::Readings& readings) override;
+    int publishCycle(std::vector<DataPoint>& points) override;
+    String getName() const override { return "MQTT"; }
+
+    /**
+     * @brief Service the session (keepalive) and reconnect if it dropped;
+     *        call regularly on always-on nodes
+     * @return true if connected
+     */
+    bool loop();
+
+    /**
+     * @brief Mark the device offline and close the session cleanly
+     */
+    void disconnect();
+
+    /**
+     * @brief Get the topic cycle batches are published to
+     */
+    const char* getReadingsTopic() const { return readingsTopic; }
+
+private:
+    static constexpr size_t TOPIC_SIZE = 96;
+
+    const char* server;
+    uint16_t port;
+    const char* user;
+    const char* password;
+    const char* deviceId;
+    WiFiClient wifiClient;
+    mutable PubSubClient client;    // connected() is not const in the library
+    bool initialized;
+    bool reconnectFailed;
+    unsigned long lastReconnectAttempt;
+
+    char readingsTopic[TOPIC_SIZE];
+    char statusTopic[TOPIC_SIZE];
+    char payload[Config::MQTT_BUFFER_SIZE];
+    size_t payloadLength;
+    size_t entryCount;
+
+    /**
+     * @brief Connect within the time budget unless a recent attempt failed
+     */
+    bool connect();
+
+    /**
+     * @brief Start a batch message in the payload buffer
+     * @param sensorName Sensor the batch comes from (nullptr for a whole cycle)
+     */
+    void beginBatch(const char* sensorName);
+
+    /**
+     * @brief Add one reading to the batch
+     * @return false if it does not fit; the batch is left unchanged
+     */
+    bool appendEntry(const char* location, const char* type, float value, uint32_t timestamp);
+
+    /**
+     * @brief Close the batch and publish it to the readings topic
+     */
+    bool sendBatch();
+
+    /**
+     * @brief Largest payload that fits the client buffer on a topic
+     */
+    size_t maxPayloadLength(const char* topic) const;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "Sparkline.h"
+
+/**
+ * @brief Text screen model for a small U8g2 OLED that sends only what changed
+ *
+ * A layout is a fixed list of text fields, each with a position, font and
+ * maximum width. render() compares every field's text with what was last
+ * sent and pushes only the 8x8 tiles covered by changed fields: with a full
+ * frame buffer (_F_ constructor) through updateDisplayArea(), with a page
+ * buffer (_1_/_2_ constructor) by redrawing only the affected tile rows.
+ * Updating one digit of the reading then costs a few dozen I2C bytes
+ * instead of the whole 360-byte frame.
+ *
+ * A layout can also carry a Sparkline, whose tiles are sent when the graph
+ * moved.
+ *
+ * The page buffer mode frees the full frame buffer; it is detected from the
+ * display object, so the sketch only picks the constructor.
+ */
+class OledScreen {
+public:
+    struct Field {
+        uint8_t x;              // drawStr() position, y is the baseline
+        uint8_t y;
+        uint8_t width;          // Widest text the field will show, in pixels
+        const uint8_t* font;
+    };
+
+    static constexpr size_t MAX_FIELDS = 8;
+    static constexpr size_t MAX_TEXT_LENGTH = 16;
+
+    /**
+     * @brief Constructor
+     * @param display Display already started with begin()
+     */
+    explicit OledScreen(U8G2& display);
+
+    /**
+     * @brief Switch to another layout; the next render() redraws everything
+     * @param fields Field list that outlives the screen (usually a static array)
+     * @param count Number of fields (at most MAX_FIELDS)
+     * Switching to the current layout keeps the texts and sends nothing.
+     */
+    void setLayout(const Field* fields, size_t count);
+
+    template<size_t N>
+    void setLayout(const Field (&fields)[N]) {
+        static_assert(N <= MAX_FIELDS, "Too many fields for OledScreen");
+        setLayout(fields, N);
+    }
+
+    /**
+     * @brief Set the text of a field (truncated to MAX_TEXT_LENGTH - 1)
+     */
+    void setText(size_t field, const char* text);
+
+    /**
+     * @brief Show a sparkline with the current layout (cleared by setLayout)
+     */
+    void setSparkline(Sparkline* graph);
+
+    /**
+     * @brief Show up to four lines of text in the built-in message layout
+     */
+    void showMessage(const char* line1, const char* line2 = "", const char* line3 = "",
+                     const char* line4 = "");
+
+    /**
+     * @brief Send the tiles of fields that changed since the last render
+     * @return Number of bytes of display data sent
+     */
+    size_t render();
+
+    /**
+     * @brief Force the next render() to send the whole screen
+     * Use after the display has been cleared or lost power.
+     */
+    void invalidate();
+
+    /**
+     * @brief Clear the display and forget what it shows
+     */
+    void clear();
+
+    /**
+     * @brief Display data bytes sent since startup (without I2C framing)
+     */
+    uint32_t getBytesSent() const { return bytesSent; }
+
+private:
+    static constexpr size_t MAX_TILE_ROWS = 8;  // 64 pixel high panels
+
+    U8G2& display;
+    const Field* layout;
+    Sparkline* sparkline;
+    size_t fieldCount;
+    bool fullRedraw;
+    uint32_t bytesSent;
+    char text[MAX_FIELDS][MAX_TEXT_LENGTH];
+    char sent[MAX_FIELDS][MAX_TEXT_LENGTH];
+
+    bool isPageBuffer();
+    void markField(size_t field, uint16_t* dirtyColumns);
+    void markSparkline(uint16_t* dirtyColumns);
+    void drawFields();
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Config.h"
+#include "IDataPublisher.h"
+
+/**
+ * @brief Store-and-forward log on LittleFS for readings that could not be
+ *        uploaded
+ *
+ * When an upload fails (no WiFi, publisher error), the readings are appended
+ * here instead of being kept in RTC memory, where a long outage would
+ * overwrite them and a power loss would erase them. Once a later upload
+ * succeeds, the log is replayed in batches of up to
+ * Config::OUTAGE_LOG_REPLAY_BATCH_SIZE readings. Each wake replays at most
+ * Config::OUTAGE_LOG_REPLAY_BATCHES_PER_WAKE batches, spaced
+ * Config::OUTAGE_LOG_REPLAY_INTERVAL_MS apart. A cursor file records how far
+ * replay got.
+ *
+ * The log is a set of append-only segment files of about
+ * Config::OUTAGE_LOG_SEGMENT_BYTES each. Segments are only appended to and
+ * are deleted once replayed, never rewritten. When
+ * Config::OUTAGE_LOG_MAX_SEGMENTS are in use, the oldest segment is
+ * dropped.
+ *
+ * Each append is one frame: a header, the frame's location names, then
+ * 6-byte entries (time offset, int16 value, kind, location), closed by a
+ * CRC32. A frame torn by a power loss is detected and skipped, and new
+ * frames go to a fresh segment. An hour of readings takes about 150
+ * bytes.
+ */
+class OutageLog {
+public:
+    /**
+     * @brief Clock the timestamps of appended data points are on
+     */
+    enum class TimeBase : uint8_t {
+        UTC,            // UTC epoch seconds
+        BUFFER_CLOCK    // ReadingBuffer clock, converted to UTC at replay
+    };
+
+    /**
+     * @brief Append data points that could not be published
+     * @return true once the points are stored in flash
+     */
+    static bool append(const std::vector<IDataPublisher::DataPoint>& points, TimeBase timeBase);
+
+    /**
+     * @brief Replay logged data points through a publisher
+     * @param publisher Publisher with a working connection
+     * @param utcNow Current UTC epoch seconds (0 if unknown)
+     * @param clockNow Current ReadingBuffer clock
+     * @return Number of data points replayed
+     */
+    static size_t replay(IDataPublisher& publisher, uint32_t utcNow, uint32_t clockNow);
+
+    /**
+     * @brief Check if the log holds data points not replayed yet
+     */
+    static bool hasPending();
+
+    /**
+     * @brief Bytes of the log not replayed yet
+     */
+    static uint32_t getPendingBytes();
+
+#ifdef NATIVE_BUILD
+    /**
+     * @brief Forget the mount and the cached cursor, as a reboot does
+     */
+    static void unmount();
+#endif
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Config.h"
+#include "IDataPublisher.h"
+
+/**
+ * @brief Store-and-forward buffer for readings in RTC memory
+ *
+ * Wakes that only sample append their data points here and go straight back
+ * to sleep; the radio is brought up only when an upload is due (on the
+ * first wake Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS after the last
+ * upload, or earlier when the next wake's readings would no longer fit).
+ * The interval is measured on the buffer clock, so it holds while the sleep
+ * scheduler varies the wake rate. Entries are stored as 8-byte
+ * records and the whole buffer is protected by a CRC32, so a buffer damaged
+ * by a brown-out is discarded instead of uploaded.
+ *
+ * Timestamps are kept on a buffer-local clock (awake time plus configured
+ * sleep time since power-on) and converted to UTC at upload time.
+ */
+class ReadingBuffer {
+public:
+    /**
+     * @brief Start a new wake cycle (validates RTC storage, counts the wake)
+     */
+    static void beginWake();
+
+    /**
+     * @brief Buffer a data point measured during this wake
+     * @return false if the type or location cannot be encoded
+     */
+    static bool append(const IDataPublisher::DataPoint& point);
+
+    /**
+     * @brief Buffer all data points of this wake
+     * @return Number of data points buffered
+     */
+    static size_t appendAll(const std::vector<IDataPublisher::DataPoint>& points);
+
+    /**
+     * @brief Check if this wake should connect and upload the buffer
+     */
+    static bool isUploadDue();
+
+    /**
+     * @brief Number of buffered entries
+     */
+    static size_t getCount();
+
+    /**
+     * @brief Number of entries overwritten because the buffer was full
+     */
+    static uint32_t getDroppedCount();
+
+    /**
+     * @brief Buffer clock seconds remaining until the next scheduled upload
+     */
+    static uint32_t getSecondsUntilUpload();
+
+    /**
+     * @brief Expand all buffered entries, oldest first
+     * @param utcNow Current UTC epoch seconds, or 0 to leave timestamps unset
+     */
+    static std::vector<IDataPublisher::DataPoint> getDataPoints(uint32_t utcNow);
+
+    /**
+     * @brief Current time on the buffer clock (seconds since power-on,
+     *        deep sleep included); getDataPoints(getClockSeconds()) yields
+     *        timestamps on this clock
+     */
+    static uint32_t getClockSeconds();
+
+    /**
+     * @brief Drop all entries after a successful upload
+     */
+    static void clear();
+
+    /**
+     * @brief Advance the buffer clock past the coming deep sleep
+     */
+    static void prepareSleep(uint32_t sleepSeconds);
+};
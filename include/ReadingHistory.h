@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @brief 24-hour history of one reading for local display, in RTC memory
+ *
+ * Readings are averaged into slots of Config::HISTORY_SLOT_SECONDS and the
+ * closed slots kept in a ring of Config::HISTORY_SLOTS int16 values in
+ * hundredths (centi-degrees for a temperature), so a day at 15-minute
+ * resolution costs 192 bytes. Slots without any reading are stored as
+ * NO_SAMPLE. The ring lives in RTC_NOINIT_ATTR memory, which the bootloader
+ * leaves alone, so it survives sleep and software, watchdog and brown-out
+ * resets; magic and CRC reject what a power-on leaves there. A display node
+ * can then draw its history without querying Supabase.
+ *
+ * Time is whatever monotonic seconds the caller passes (millis() / 1000 on
+ * an always-on node); a clock that goes backwards, as after a reset, only
+ * restarts the open slot.
+ */
+class ReadingHistory {
+public:
+    static constexpr int16_t NO_SAMPLE = INT16_MIN;
+
+    /**
+     * @brief Add a reading to the open slot, closing slots that have elapsed
+     * @param value Reading in whole units (e.g. °C)
+     * @param clockSeconds Current time in seconds
+     */
+    static void add(float value, uint32_t clockSeconds);
+
+    /**
+     * @brief Close slots that have elapsed without adding a reading
+     *
+     * Call before drawing, so time without readings shows up as gaps
+     * instead of waiting for the next add().
+     * @param clockSeconds Current time in seconds
+     */
+    static void advance(uint32_t clockSeconds);
+
+    /**
+     * @brief Copy the newest closed slots, oldest first
+     * @param samples Destination for up to maxCount values in hundredths
+     * @return Number of slots copied
+     */
+    static size_t getSamples(int16_t* samples, size_t maxCount);
+
+    /**
+     * @brief Number of slots closed since the ring was last reset
+     *
+     * Grows by one per slot; a change of exactly one means the newest
+     * getSamples() entry is the only new one.
+     */
+    static uint32_t getClosedCount();
+
+    /**
+     * @brief Lowest and highest slot average over the last hours
+     * @return false if no slot in that period has a reading
+     */
+    static bool getRange(uint32_t hours, float& min, float& max);
+};
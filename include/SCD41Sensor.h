@@ -5,26 +5,45 @@
 #include <SensirionI2cScd4x.h>
 #include <Wire.h>
 
+/**
+ * @brief Measurement kinds an SCD-41 uploads in a given mode
+ */
+template <Config::SCD41Mode Mode>
+struct SCD41PublishedKinds {
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::CO2};
+};
+
+template <>
+struct SCD41PublishedKinds<Config::SCD41Mode::SINGLE_SHOT_RHT_ONLY> {
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::TEMPERATURE, MeasurementKind::HUMIDITY};
+};
+
 /**
  * @brief SCD-41 CO2, Temperature and Humidity Sensor
  * 
  * Implements the ISensor interface for SCD-41 I2C sensor.
  * Provides CO2, temperature, and humidity readings.
+ *
+ * In Config::SCD41Mode::PERIODIC the sensor measures continuously and the
+ * first sample is available ~5 s after start. PERIODIC_PERSISTENT starts the
+ * measurement once and leaves it running while the MCU deep-sleeps, so later
+ * wakes read the latest buffered sample immediately. The single-shot modes wake the
+ * sensor, trigger one measurement per wake and power it down again after
+ * reading, which suits nodes that deep-sleep between samples. Sensirion
+ * specifies that the first single shot after wake_up is not valid, so each
+ * wake takes a discarded shot before the one that is reported.
+ *
+ * The mode is Config::SCD41_MODE, fixed at compile time because the kinds
+ * worth uploading depend on it.
  */
-class SCD41Sensor : public ISensor {
+class SCD41Sensor final : public ISensor {
 public:
-    enum class ReadingType {
-        CO2 = 0,
-        TEMPERATURE = 1,
-        HUMIDITY = 2
-    };
-
     /**
      * @brief Constructor
-     * @param location Sensor location identifier
+     * @param location Sensor location identifier (kept by pointer, e.g. a Config constant)
      * @param i2cAddress I2C address (default: 0x62)
      */
-    explicit SCD41Sensor(const String& location = Config::SCD41_LOCATION, 
+    explicit SCD41Sensor(const char* location = Config::DEFAULT_SCD41_LOCATION, 
                         uint8_t i2cAddress = Config::SCD41_I2C_ADDRESS);
 
     /**
@@ -32,24 +51,50 @@ public:
      */
     ~SCD41Sensor() override = default;
 
+    // Measurement kinds in collectReading() order, and the ones that are uploaded:
+    // CO2, or temperature and humidity in RHT-only mode where there is no CO2
+    // (otherwise those two are for reference only; the DHT11 reports them)
+    static constexpr MeasurementKind KINDS[] = {
+        MeasurementKind::CO2, MeasurementKind::TEMPERATURE, MeasurementKind::HUMIDITY};
+    static constexpr auto& PUBLISHED_KINDS = SCD41PublishedKinds<Config::SCD41_MODE>::KINDS;
+
     // ISensor interface implementation
     bool initialize() override;
     bool isReady() const override;
-    String getName() const override { return "SCD-41"; }
-    String getLocation() const override { return location; }
-    bool readSensor(std::vector<Reading>& readings) override;
+    const char* getName() const override { return "SCD-41"; }
+    const char* getLocation() const override { return location; }
+    bool startReading() override;
+    bool isReadingComplete() override;
+    bool collectReading(Readings& readings) override;
 
     /**
-     * @brief Scan for I2C devices on the bus
+     * @brief Scan for I2C devices on the bus and cache the result
      */
     static void scanI2CDevices();
 
+    /**
+     * @brief Get the configured acquisition mode
+     */
+    Config::SCD41Mode getMode() const { return mode; }
+
 private:
-    String location;
+    const char* location;
     uint8_t i2cAddress;
+    const Config::SCD41Mode mode;
     SensirionI2cScd4x scd4x;
     unsigned long initializationTime;
     bool measurementStarted;
+    unsigned long acquisitionStartTime;
+    bool resumedMeasurement;
+    bool discardNextSample;     // First single shot after wake_up
+    
+    // Non-blocking acquisition state
+    bool acquisitionPending;
+    bool acquisitionFailed;
+    bool dataReady;
+    uint16_t pollAttempts;
+    uint8_t communicationRetries;
+    unsigned long lastPollTime;
     
     static char errorMessage[64];
     
@@ -62,11 +107,26 @@ private:
     static constexpr float MIN_VALID_HUMIDITY = 0.0f;
     static constexpr float MAX_VALID_HUMIDITY = 100.0f;
 
+    // Single-shot commands are sent directly: the driver's measureSingleShot()
+    // blocks for the whole 5 s measurement
+    static constexpr uint16_t CMD_MEASURE_SINGLE_SHOT = 0x219D;
+    static constexpr uint16_t CMD_MEASURE_SINGLE_SHOT_RHT_ONLY = 0x2196;
+
     bool initializeI2C();
+    bool initializeSingleShot();
     bool startMeasurement();
-    bool waitForDataReady();
+    bool startSingleShot();
+    bool sendCommand(uint16_t command);
+    bool isSingleShot() const {
+        return mode == Config::SCD41Mode::SINGLE_SHOT || mode == Config::SCD41Mode::SINGLE_SHOT_RHT_ONLY;
+    }
+    uint32_t getMeasurementDuration() const;
+    bool discardSample();
+    void powerDown();
+    bool readMeasurement(Readings& readings);
+    bool pollDataReady();
     bool isValidCO2(uint16_t co2) const;
     bool isValidTemperature(float temperature) const;
     bool isValidHumidity(float humidity) const;
-    String getErrorString(int16_t error) const;
-};
\ No newline at end of file
+    const char* getErrorString(int16_t error) const;
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <Arduino.h>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ISensor.h"
+#include "IDataPublisher.h"
+#include "Config.h"
+
+#ifdef NATIVE_BUILD
+#include "NativeSimulation.h"
+#endif
+
+/**
+ * @brief Fixed set of sensors known at compile time
+ *
+ * Holds the sensors by value and walks them with fold expressions, so every
+ * step (initialize, start, poll, collect, publish) is unrolled into direct
+ * calls on the concrete types. Each sensor type declares the measurement
+ * kinds it reports in KINDS and the ones worth uploading in PUBLISHED_KINDS;
+ * result buffers and the number of data points per cycle follow from those.
+ *
+ * Like the scheduler it replaces, run() starts every measurement at once and
+ * collects each result as soon as that sensor reports completion, so a wake
+ * waits for the slowest sensor instead of the sum of all conversion times.
+ *
+ * Adding a sensor to a build is a matter of adding its type to the list:
+ * @code
+ * SensorSet<DHT11Sensor, DS18B20Sensor, SCD41Sensor> sensors(
+ *     DHT11Sensor(), DS18B20Sensor(bus), SCD41Sensor());
+ * @endcode
+ */
+template <typename... Sensors>
+class SensorSet {
+    static_assert(sizeof...(Sensors) > 0, "SensorSet needs at least one sensor");
+
+    template <typename Sensor>
+    static constexpr size_t kindCount() {
+        static_assert(std::is_base_of<ISensor, Sensor>::value, "SensorSet members must implement ISensor");
+        static_assert(sizeof(Sensor::KINDS) / sizeof(MeasurementKind) <= ISensor::MAX_READINGS,
+                      "sensor reports more readings than ISensor::Readings holds");
+        return sizeof(Sensor::KINDS) / sizeof(MeasurementKind);
+    }
+
+    template <typename Sensor>
+    static constexpr size_t publishedCount() {
+        return sizeof(Sensor::PUBLISHED_KINDS) / sizeof(MeasurementKind);
+    }
+
+public:
+    struct Result {
+        bool success;
+        bool completed;
+        ISensor::Readings readings;
+        unsigned long durationMs;
+
+        Result() : success(false), completed(false), durationMs(0) {}
+    };
+
+    /// Number of sensors in the set
+    static constexpr size_t SIZE = sizeof...(Sensors);
+
+    /// Most readings one acquisition round can produce
+    static constexpr size_t MAX_READINGS = (kindCount<Sensors>() + ...);
+
+    /// Most data points one acquisition round can publish
+    static constexpr size_t MAX_DATA_POINTS = (publishedCount<Sensors>() + ...);
+
+    /**
+     * @brief Constructor
+     * @param sensors Sensor instances, in the order of the type list
+     */
+    explicit SensorSet(Sensors&&... sensors) : sensors(std::move(sensors)...) {}
+
+    /**
+     * @brief Initialize every sensor, reporting each failure
+     * @return true if all sensors initialized
+     */
+    bool initialize() {
+        bool allSuccess = true;
+        forEach([&](auto& sensor, Result&) {
+            if (!sensor.initialize()) {
+                Serial.printf("⚠ %s initialization failed: %s\n",
+                             sensor.getName(), sensor.getErrorMessage());
+                allSuccess = false;
+            }
+        });
+        return allSuccess;
+    }
+
+    /**
+     * @brief Start all sensors and poll until every result is collected
+     * @param onComplete Called as onComplete(sensor, result) as soon as each
+     *        sensor's result has been collected; sensor has its concrete type
+     * @param timeoutMs Time after which unfinished sensors are reported as failed
+     * @return Number of sensors that delivered a successful reading
+     */
+    template <typename Callback>
+    size_t run(Callback&& onComplete, uint32_t timeoutMs = Config::SENSOR_ACQUISITION_TIMEOUT_MS) {
+#ifdef NATIVE_BUILD
+        // The host build fails if acquisition touches the heap
+        native::HeapAllocationGuard allocationGuard("sensor acquisition");
+#endif
+        unsigned long startTime = millis();
+        size_t pending = 0;
+
+        auto complete = [&](auto& sensor, Result& result) {
+            result.completed = true;
+            result.durationMs = millis() - startTime;
+            onComplete(std::as_const(sensor), std::as_const(result));
+        };
+
+        // Kick off every conversion before waiting on any of them
+        forEach([&](auto& sensor, Result& result) {
+            result = Result();
+            if (sensor.startReading()) {
+                pending++;
+            } else {
+                complete(sensor, result);
+            }
+        });
+
+        while (pending > 0) {
+            forEach([&](auto& sensor, Result& result) {
+                if (result.completed || !sensor.isReadingComplete()) {
+                    return;
+                }
+                result.success = sensor.collectReading(result.readings);
+                complete(sensor, result);
+                pending--;
+            });
+
+            if (pending == 0) {
+                break;
+            }
+
+            if (millis() - startTime >= timeoutMs) {
+                forEach([&](auto& sensor, Result& result) {
+                    if (!result.completed) {
+                        Serial.printf("⚠ %s measurement timed out after %lu ms\n",
+                                     sensor.getName(), (unsigned long)timeoutMs);
+                        complete(sensor, result);
+                    }
+                });
+                break;
+            }
+
+            delay(Config::SENSOR_POLL_INTERVAL_MS);
+        }
+
+        size_t successCount = 0;
+        forEach([&](auto&, Result& result) {
+            if (result.success) {
+                successCount++;
+            }
+        });
+
+        Serial.printf("Acquired %d/%d sensors in %lu ms\n",
+                     (int)successCount, (int)SIZE, millis() - startTime);
+        return successCount;
+    }
+
+    /**
+     * @brief Append the published kinds of every successful reading as data points
+     *
+     * The points refer to the sensors' location names, so with points reserved
+     * for MAX_DATA_POINTS up front this does not touch the heap.
+     * @return Number of data points appended
+     */
+    size_t appendDataPoints(std::vector<IDataPublisher::DataPoint>& points) const {
+#ifdef NATIVE_BUILD
+        native::HeapAllocationGuard allocationGuard("data points");
+#endif
+        size_t appended = 0;
+        forEach([&](const auto& sensor, const Result& result) {
+            using Sensor = std::decay_t<decltype(sensor)>;
+            if (result.success) {
+                appended += IDataPublisher::appendDataPoints(points, sensor.getLocation(),
+                                                             result.readings, Sensor::PUBLISHED_KINDS);
+            }
+        });
+        return appended;
+    }
+
+    /**
+     * @brief Get a sensor by position in the type list
+     */
+    template <size_t Index>
+    auto& get() { return std::get<Index>(sensors); }
+
+    /**
+     * @brief Get the latest result of a sensor by position in the type list
+     */
+    template <size_t Index>
+    const Result& getResult() const { return results[Index]; }
+
+private:
+    std::tuple<Sensors...> sensors;
+    std::array<Result, SIZE> results;
+
+    template <typename Function>
+    void forEach(Function&& function) {
+        forEach(function, std::index_sequence_for<Sensors...>());
+    }
+
+    template <typename Function>
+    void forEach(Function&& function) const {
+        forEach(function, std::index_sequence_for<Sensors...>());
+    }
+
+    template <typename Function, size_t... Index>
+    void forEach(Function& function, std::index_sequence<Index...>) {
+        (function(std::get<Index>(sensors), results[Index]), ...);
+    }
+
+    template <typename Function, size_t... Index>
+    void forEach(Function& function, std::index_sequence<Index...>) const {
+        (function(std::get<Index>(sensors), results[Index]), ...);
+    }
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Config.h"
+#include "IDataPublisher.h"
+
+/**
+ * @brief Chooses the deep sleep duration from how fast the readings move
+ *
+ * The last Config::SLEEP_HISTORY_SAMPLES readings of every location and kind
+ * are kept in RTC memory. Each stream's rate of change is the least-squares
+ * slope over that history. The next sleep is about the time the fastest
+ * stream needs to move one deadband (DeadbandFilter::getDeadband()). It is
+ * shorter when a value is close to, or heading for, an alert threshold.
+ * The result is kept between Config::SLEEP_MIN_SECONDS and
+ * Config::SLEEP_MAX_SECONDS. It shortens at once but grows by at most a
+ * factor of two per wake. With no history it is
+ * Config::SLEEP_DURATION_SECONDS.
+ *
+ * The policy itself, computeSleepSeconds(), is a pure function of the
+ * trends and the previous sleep. test/test_sleep_scheduler checks it and
+ * feeds a synthetic trace through record()/nextSleepSeconds(); the native
+ * runner's --trace option drives the whole firmware from a recorded one.
+ */
+class SleepScheduler {
+public:
+    /**
+     * @brief Recent behaviour of one measurement stream
+     */
+    struct Trend {
+        MeasurementKind kind;
+        float value;            // Latest reading
+        float ratePerHour;      // Units per hour, 0 with fewer than two samples
+    };
+
+    /**
+     * @brief Add this wake's readings to the RTC history
+     * @param points All data points read this wake (before deadband filtering)
+     * @param clockNow Current ReadingBuffer clock
+     */
+    static void record(const std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow);
+
+    /**
+     * @brief Choose the coming deep sleep from the recorded history
+     * @return Sleep duration in seconds (also remembered for the next wake)
+     */
+    static uint32_t nextSleepSeconds();
+
+    /**
+     * @brief Sleep policy
+     * @param trends Trends of all streams with at least two samples
+     * @param count Number of trends
+     * @param previousSeconds Previous sleep duration (0 if unknown)
+     * @return Sleep duration in seconds
+     */
+    static uint32_t computeSleepSeconds(const Trend* trends, size_t count, uint32_t previousSeconds);
+
+#ifdef NATIVE_BUILD
+    /**
+     * @brief Forget the history and the previous sleep, as a power-on does
+     */
+    static void reset();
+#endif
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+/**
+ * @brief Sparkline of a sample history for a U8g2 SSD1306 display
+ *
+ * The graph keeps its own pixel columns in the SSD1306 layout (one byte per
+ * column and tile row, least significant bit on top) and is copied into the
+ * U8g2 buffer by OledScreen. When exactly one sample was added and it fits
+ * the current scale, the columns are shifted left by one byte and only the
+ * new column is drawn; otherwise the whole graph is redrawn and rescaled.
+ * The vertical scale spans at least MIN_SPAN hundredths so sensor noise does
+ * not fill the height.
+ */
+class Sparkline {
+public:
+    static constexpr uint8_t MAX_WIDTH = 72;
+    static constexpr uint8_t MAX_TILE_ROWS = 2;
+    static constexpr int16_t MIN_SPAN = 50;
+
+    /**
+     * @brief Constructor
+     * @param x Left pixel column
+     * @param tileRow Top tile row (8 pixel rows each)
+     * @param width Width in pixels, one sample per column (at most MAX_WIDTH)
+     * @param tileRows Height in tile rows (at most MAX_TILE_ROWS)
+     */
+    Sparkline(uint8_t x, uint8_t tileRow, uint8_t width, uint8_t tileRows = 1);
+
+    /**
+     * @brief Bring the graph up to date with a history
+     * @param samples Newest samples oldest first, ReadingHistory::NO_SAMPLE for gaps
+     * @param count Number of samples (only the last width are drawn)
+     * @param closedCount Running sample count of the history
+     */
+    void update(const int16_t* samples, size_t count, uint32_t closedCount);
+
+    /**
+     * @brief Copy the graph into the display buffer (full or page buffer)
+     */
+    void draw(U8G2& display) const;
+
+    /**
+     * @brief Check if the graph changed since it was last sent
+     */
+    bool isChanged() const { return changed; }
+
+    /**
+     * @brief Called by OledScreen once the graph's tiles were sent
+     */
+    void markSent() { changed = false; }
+
+    uint8_t getX() const { return x; }
+    uint8_t getTileRow() const { return tileRow; }
+    uint8_t getWidth() const { return width; }
+    uint8_t getTileRows() const { return tileRows; }
+
+private:
+    uint8_t x;
+    uint8_t tileRow;
+    uint8_t width;
+    uint8_t tileRows;
+    bool drawn;
+    bool changed;
+    uint32_t drawnCount;
+    int16_t scaleMin;
+    int16_t scaleMax;
+    int8_t lastY;           // Pixel row of the newest column, -1 for a gap
+    uint8_t columns[MAX_TILE_ROWS][MAX_WIDTH];
+
+    int8_t toPixelRow(int16_t sample) const;
+    void drawColumn(uint8_t column, int8_t y, int8_t previousY);
+    void redraw(const int16_t* samples, size_t count);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Config.h"
+#include "IDataPublisher.h"
+
+/**
+ * @brief Running statistics of every reading, published once per window
+ *
+ * Every reading goes into a running count, mean and variance (Welford's
+ * method), plus min, max and last value, kept in RTC memory per location and
+ * kind. This happens before deadband filtering, so the statistics see every
+ * reading. Memory use is the same however often the node samples. A stream's
+ * window closes when a reading arrives at least
+ * Config::AGGREGATE_WINDOW_SECONDS after the window's first reading. The
+ * closed window is then kept as a pending aggregate until it has been
+ * uploaded. At most Config::AGGREGATE_PENDING_CAPACITY are kept; the oldest
+ * are overwritten. Aggregates are inserted into their own table
+ * (Config::AGGREGATE_TABLE_NAME, defined in supabase/migrations), because
+ * the measurements table holds one value per row. With
+ * Config::SamplingMode::AGGREGATE_ONLY the node samples every
+ * Config::FAST_SAMPLING_SECONDS and uploads only these aggregates.
+ *
+ * Window times are kept on the ReadingBuffer clock and converted to UTC
+ * when the aggregates are fetched for upload.
+ */
+class StreamingAggregator {
+public:
+    /**
+     * @brief Add this wake's readings to the running windows
+     * @param points All data points read this wake
+     * @param clockNow Current ReadingBuffer clock
+     */
+    static void add(const std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow);
+
+    /**
+     * @brief Number of closed windows waiting for upload
+     */
+    static size_t getPendingCount();
+
+    /**
+     * @brief Check if enough windows are pending to justify an upload on their own
+     *
+     * Fewer windows wait for an upload of buffered readings, so unchanged
+     * readings still let the radio stay off.
+     */
+    static bool isUploadDue();
+
+    /**
+     * @brief Closed windows waiting for upload, oldest first
+     * @param utcNow Current UTC epoch seconds, or 0 to leave window times unset
+     * @param clockNow Current ReadingBuffer clock
+     */
+    static std::vector<IDataPublisher::Aggregate> getPending(uint32_t utcNow, uint32_t clockNow);
+
+    /**
+     * @brief Drop the pending windows after a successful upload
+     */
+    static void clearPending();
+};
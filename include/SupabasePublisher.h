@@ -9,6 +9,8 @@
  * 
  * Implements the IDataPublisher interface for sending data to Supabase database.
  * Handles authentication, JSON formatting, and HTTP communication.
+ * Batches are sent as a single JSON array, which PostgREST inserts in one
+ * transaction - either every row of the request is stored or none is.
  */
 class SupabasePublisher : public IDataPublisher {
 public:
@@ -18,7 +20,7 @@ public:
      * @param apiKey Supabase API key
      * @param tableName Database table name
      */
-    SupabasePublisher(const String& url, const String& apiKey, const String& tableName = Config::SUPABASE_TABLE_NAME);
+    SupabasePublisher(const String& url, const String& apiKey, const String& tableName = Config::DEFAULT_SUPABASE_TABLE_NAME);
 
     /**
      * @brief Destructor
@@ -30,10 +32,26 @@ public:
     bool isReady() const override;
     PublishResult publish(const String& location, const String& type, float value) override;
     int publishBatch(const String& sensorName, const String& location, 
-                    const std::vector<ISensor::Reading>& readings,
-                    const std::vector<String>& dataTypes) override;
+                    const ISensor::Readings& readings) override;
+    int publishCycle(std::vector<DataPoint>& points) override;
     String getName() const override { return "Supabase"; }
 
+    /**
+     * @brief Insert a pre-serialized JSON row into an arbitrary table
+     * @param table Target table name
+     * @param json JSON object (or array of objects) to insert
+     * @return PublishResult containing success status and details
+     */
+    PublishResult publishRow(const String& table, const String& json);
+
+    /**
+     * @brief Insert window aggregates into their own table in one request
+     * @param table Target table name
+     * @param aggregates Aggregates to insert; each one's published flag is updated
+     * @return Number of aggregates stored
+     */
+    int publishAggregates(const String& table, std::vector<Aggregate>& aggregates);
+
     /**
      * @brief Set database table name
      */
@@ -53,8 +71,20 @@ private:
 
     /**
      * @brief Create JSON payload for sensor data
+     * @param timestamp UTC epoch seconds sent as created_at (0 = let the database set it)
+     */
+    String createPayload(const String& location, const char* type, float value,
+                         uint32_t timestamp = 0) const;
+
+    /**
+     * @brief Create JSON payload for one window aggregate
+     */
+    String createAggregatePayload(const Aggregate& aggregate) const;
+
+    /**
+     * @brief Format UTC epoch seconds as an ISO 8601 timestamp
      */
-    String createPayload(const String& location, const String& type, float value) const;
+    static String formatTimestamp(uint32_t timestamp);
 
     /**
      * @brief Check if HTTP response indicates success
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @brief Per-phase wake-cycle profiler
+ *
+ * Measures how long each phase of a wake cycle takes and accumulates
+ * min/mean/max statistics in RTC memory, so they survive deep sleep.
+ * A summary is published every Config::PROFILER_SUMMARY_INTERVAL_SECONDS
+ * on the ReadingBuffer clock to show where awake time goes; the window is
+ * timed rather than counted in wakes because the sleep duration varies.
+ *
+ * A wake's total awake time is only known right before it sleeps, after its
+ * summary went out, so endWake() keeps it in RTC memory and the next wake's
+ * beginWake() records it as AWAKE_TOTAL. That sample then covers everything
+ * up to the deep sleep call, network teardown included.
+ *
+ * Summary rows go to Config::PROFILER_TABLE_NAME with the columns
+ * device_id (text), wake_count (int) and phases (jsonb), see
+ * supabase/migrations.
+ */
+class WakeProfiler {
+public:
+    enum class Phase : uint8_t {
+        SENSOR_INIT = 0,
+        DHT11_READ,
+        DS18B20_READ,
+        SCD41_READ,
+        WIFI_CONNECT,
+        PUBLISHER_INIT,
+        PUBLISH,
+        AWAKE_TOTAL,
+        COUNT
+    };
+
+    struct PhaseStats {
+        uint32_t count;
+        uint32_t minMs;
+        uint32_t maxMs;
+        uint32_t totalMs;
+
+        uint32_t meanMs() const { return count > 0 ? totalMs / count : 0; }
+    };
+
+    /**
+     * @brief RAII timer recording the lifetime of the object as one phase sample
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Phase phase) : phase(phase), startTime(millis()) {}
+        ~ScopedTimer() { WakeProfiler::record(phase, millis() - startTime); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Phase phase;
+        unsigned long startTime;
+    };
+
+    /**
+     * @brief Start a new wake cycle (validates RTC storage, counts the wake and
+     *        records the previous wake's AWAKE_TOTAL)
+     * @param clockNow Current ReadingBuffer clock
+     */
+    static void beginWake(uint32_t clockNow);
+
+    /**
+     * @brief Keep this wake's awake time for the next wake to record
+     * @param awakeMs Time since boot, taken right before the deep sleep starts
+     */
+    static void endWake(uint32_t awakeMs);
+
+    /**
+     * @brief Record one sample for a phase
+     */
+    static void record(Phase phase, uint32_t durationMs);
+
+    /**
+     * @brief Get accumulated statistics for a phase
+     */
+    static const PhaseStats& getStats(Phase phase);
+
+    /**
+     * @brief Get the snake_case name of a phase
+     */
+    static const char* getPhaseName(Phase phase);
+
+    /**
+     * @brief Number of wakes covered by the current statistics window
+     */
+    static uint32_t getWakeCount();
+
+    /**
+     * @brief Check if a summary should be published during this wake
+     * @param clockNow Current ReadingBuffer clock
+     */
+    static bool isSummaryDue(uint32_t clockNow);
+
+    /**
+     * @brief Create a JSON summary row for the profiler table
+     * @param deviceId Identifier of this node (e.g. MAC address)
+     */
+    static String createSummaryPayload(const String& deviceId);
+
+    /**
+     * @brief Print statistics of all phases to Serial
+     */
+    static void printSummary();
+
+    /**
+     * @brief Clear statistics and start a new window
+     * @param clockNow Current ReadingBuffer clock (start of the window)
+     */
+    static void reset(uint32_t clockNow);
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include "Config.h"
+
+/**
+ * @brief Last good WiFi connection parameters for fast reconnects
+ *
+ * Holds the access point (BSSID + channel) and the DHCP lease of the last
+ * full connection. Reconnecting with these skips the channel scan and the
+ * DHCP exchange. The record lives wherever the caller puts it (RTC memory on
+ * the device) and is validated by magic, SSID hash and CRC, so this class has
+ * no dependency on the WiFi stack and can be exercised on the host.
+ */
+class WiFiConnectionCache {
+public:
+    struct Record {
+        uint32_t magic;
+        uint32_t ssidHash;
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint8_t reserved;
+        uint32_t localIP;
+        uint32_t gateway;
+        uint32_t subnet;
+        uint32_t dns;
+        uint32_t reuseCount;    // Fast reconnects since the lease was obtained
+        uint32_t crc;           // Must stay last
+    };
+
+    /**
+     * @brief Constructor
+     * @param record Storage that persists across wakes
+     */
+    explicit WiFiConnectionCache(Record& record) : record(record) {}
+
+    /**
+     * @brief Check if the record can be used to reconnect to a network
+     * @param ssid Network SSID
+     * @return false if empty, corrupted, for another network, or due for a DHCP refresh
+     */
+    bool isUsableFor(const char* ssid) const;
+
+    /**
+     * @brief Remember the parameters of a successful full connection
+     */
+    void store(const char* ssid, const uint8_t* bssid, int32_t channel,
+               uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns);
+
+    /**
+     * @brief Count a successful fast reconnect
+     */
+    void markReused();
+
+    /**
+     * @brief Forget the cached parameters (e.g. after a failed fast reconnect)
+     */
+    void invalidate();
+
+    /**
+     * @brief Get the cached parameters
+     */
+    const Record& get() const { return record; }
+
+private:
+    Record& record;
+
+    static uint32_t hashSsid(const char* ssid);
+    uint32_t computeCrc() const;
+    void seal();
+};
@@ -3,12 +3,22 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include "Config.h"
+#include "WiFiConnectionCache.h"
 
 /**
  * @brief WiFi connection manager
  * 
  * Handles WiFi initialization, connection, and status monitoring.
  * Provides retry logic and connection state management.
+ *
+ * The connection can be started in the background with begin() so that
+ * association and DHCP overlap other work; waitUntilConnected() then only
+ * blocks for whatever part of the connection is still outstanding.
+ *
+ * The access point and DHCP lease of the last full connection are cached in
+ * RTC memory. The next connection goes straight to that BSSID/channel with
+ * the cached static IP, skipping the scan and DHCP, and falls back to a full
+ * connect if that does not succeed within Config::WIFI_FAST_CONNECT_TIMEOUT_MS.
  */
 class WiFiManager {
 public:
@@ -23,13 +33,27 @@ public:
     /**
      * @brief Constructor
      */
-    WiFiManager() = default;
+    WiFiManager();
 
     /**
      * @brief Destructor - ensures proper cleanup
      */
     ~WiFiManager();
 
+    /**
+     * @brief Start connecting to WiFi without waiting for the result
+     * @param ssid Network SSID
+     * @param password Network password
+     */
+    void begin(const char* ssid, const char* password);
+
+    /**
+     * @brief Wait for the connection started by begin()
+     * @param timeoutMs Connection timeout in milliseconds, measured from begin()
+     * @return true if connected successfully
+     */
+    bool waitUntilConnected(uint32_t timeoutMs = Config::WIFI_TIMEOUT_MS);
+
     /**
      * @brief Initialize and connect to WiFi
      * @param ssid Network SSID
@@ -39,6 +63,19 @@ public:
      */
     bool connect(const char* ssid, const char* password, uint32_t timeoutMs = Config::WIFI_TIMEOUT_MS);
 
+    /**
+     * @brief Start SNTP synchronization in the background (requires a connection)
+     */
+    void startTimeSync();
+
+    /**
+     * @brief Get the current UTC time, waiting for SNTP if necessary
+     * @param epochSeconds Receives seconds since 1970-01-01 UTC
+     * @param timeoutMs Maximum time to wait for the first SNTP response
+     * @return true if the clock is synchronized
+     */
+    bool getUtcTime(uint32_t& epochSeconds, uint32_t timeoutMs = Config::NTP_TIMEOUT_MS);
+
     /**
      * @brief Disconnect from WiFi and cleanup
      */
@@ -74,9 +111,22 @@ public:
      */
     void printConnectionInfo() const;
 
+    /**
+     * @brief Check if the current connection attempt uses the cached parameters
+     */
+    bool isUsingCachedConnection() const { return usingCachedConnection; }
+
 private:
     String lastError;
-    unsigned long connectionStartTime;
+    String ssid;
+    String password;
+    unsigned long connectionStartTime = 0;
+    bool connectionStarted = false;
+    bool usingCachedConnection = false;
+    WiFiConnectionCache cache;
+
+    void fallBackToFullConnect();
+    void updateCache();
 
     void setError(const String& error);
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+
+/**
+ * @file Arduino.h
+ * @brief Host-side stand-in for the Arduino core used by the [env:native] build
+ *
+ * Provides just enough of the ESP32 Arduino API (String, Serial, timing, GPIO)
+ * for the modular sensor stack to compile and run on Linux. All timing functions
+ * are driven by a virtual clock (see NativeClock.h), so delay() costs nothing in
+ * wall time but is fully accounted for in millis().
+ */
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <string>
+#include <algorithm>
+
+#include "NativeClock.h"
+
+// ========== ARDUINO TYPES AND CONSTANTS ==========
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// Deep-sleep persistent storage. The native runner snapshots these sections at
+// the end of a wake and restores them into the next forked wake cycle. Like the
+// bootloader, it zeroes rtc_data after any reset other than a deep-sleep wake
+// and leaves rtc_noinit alone.
+#define RTC_DATA_ATTR __attribute__((section("rtc_data")))
+#define RTC_NOINIT_ATTR __attribute__((section("rtc_noinit")))
+
+using std::isnan;
+using std::isfinite;
+
+// ========== STRING ==========
+class String {
+public:
+    String() = default;
+    String(const char* str) : data(str ? str : "") {}
+    String(const std::string& str) : data(str) {}
+    String(char c) : data(1, c) {}
+    String(unsigned char value, unsigned char base = DEC) { fromUnsigned(value, base); }
+    String(int value, unsigned char base = DEC) { fromSigned(value, base); }
+    String(unsigned int value, unsigned char base = DEC) { fromUnsigned(value, base); }
+    String(long value, unsigned char base = DEC) { fromSigned(value, base); }
+    String(unsigned long value, unsigned char base = DEC) { fromUnsigned(value, base); }
+    String(long long value, unsigned char base = DEC) { fromSigned(value, base); }
+    String(unsigned long long value, unsigned char base = DEC) { fromUnsigned(value, base); }
+    String(float value, unsigned int decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+    String(double value, unsigned int decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+
+    const char* c_str() const { return data.c_str(); }
+    unsigned int length() const { return static_cast<unsigned int>(data.length()); }
+    bool isEmpty() const { return data.empty(); }
+    bool reserve(unsigned int size) { data.reserve(size); return true; }
+
+    char charAt(unsigned int index) const { return index < data.size() ? data[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    bool equals(const String& other) const { return data == other.data; }
+    bool equals(const char* other) const { return data == (other ? other : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const { return data.rfind(prefix.data, 0) == 0; }
+    bool endsWith(const String& suffix) const;
+
+    int indexOf(char c, unsigned int from = 0) const { return toIndex(data.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return toIndex(data.find(str.data, from)); }
+    int lastIndexOf(char c) const { return toIndex(data.rfind(c)); }
+    String substring(unsigned int from) const { return from < data.size() ? String(data.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    long toInt() const { return std::strtol(data.c_str(), nullptr, 10); }
+    float toFloat() const { return std::strtof(data.c_str(), nullptr); }
+    double toDouble() const { return std::strtod(data.c_str(), nullptr); }
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index) { if (index < data.size()) data.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < data.size()) data.erase(index, count); }
+
+    bool concat(const String& other) { data += other.data; return true; }
+    bool concat(const char* other) { data += (other ? other : ""); return true; }
+    bool concat(char c) { data += c; return true; }
+
+    String& operator+=(const String& other) { data += other.data; return *this; }
+    String& operator+=(const char* other) { data += (other ? other : ""); return *this; }
+    String& operator+=(char c) { data += c; return *this; }
+    template <typename T>
+    String& operator+=(T value) { return *this += String(value); }
+
+    bool operator==(const String& other) const { return data == other.data; }
+    bool operator==(const char* other) const { return equals(other); }
+    bool operator!=(const String& other) const { return data != other.data; }
+    bool operator!=(const char* other) const { return !equals(other); }
+    bool operator<(const String& other) const { return data < other.data; }
+
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs.data + rhs.data); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs.data + (rhs ? rhs : "")); }
+    friend String operator+(const char* lhs, const String& rhs) { return String((lhs ? lhs : "") + rhs.data); }
+    friend String operator+(const String& lhs, char rhs) { return String(lhs.data + rhs); }
+    template <typename T>
+    friend String operator+(const String& lhs, T rhs) { return lhs + String(rhs); }
+
+private:
+    std::string data;
+
+    static int toIndex(std::string::size_type pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+    void fromSigned(long long value, unsigned char base);
+    void fromUnsigned(unsigned long long value, unsigned char base);
+    void fromDouble(double value, unsigned int decimalPlaces);
+};
+
+// ========== PRINT / SERIAL ==========
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t print(const String& s) { return write(reinterpret_cast<const uint8_t*>(s.c_str()), s.length()); }
+    size_t print(const char* s) { return write(reinterpret_cast<const uint8_t*>(s), std::strlen(s)); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned char value, int base = DEC) { return print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(double value, int digits = 2) { return print(String(value, digits)); }
+
+    size_t println() { return print("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    void flush() { std::fflush(stdout); }
+    int available() { return 0; }
+    int read() { return -1; }
+    operator bool() const { return true; }
+
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Silence serial output (native only, used by the benchmark runner)
+     */
+    void setMuted(bool muted) { this->muted = muted; }
+
+private:
+    bool muted = false;
+};
+
+extern HardwareSerial Serial;
+
+// ========== TIMING ==========
+inline unsigned long millis() { return static_cast<unsigned long>(native::clock().bootMicros() / 1000ULL); }
+inline unsigned long micros() { return static_cast<unsigned long>(native::clock().bootMicros()); }
+inline void delay(unsigned long ms) { native::clock().advanceMicros(static_cast<uint64_t>(ms) * 1000ULL); }
+inline void delayMicroseconds(unsigned int us) { native::clock().advanceMicros(us); }
+inline void yield() {}
+
+// SNTP (esp32-hal-time): the synced wall clock is native::Simulation::epochAtPowerOn
+// plus the virtual time since power-on
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+// ========== GPIO ==========
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+// ========== CHIP ==========
+class EspClass {
+public:
+    uint32_t getFreeHeap() const { return 180000; }
+    uint32_t getHeapSize() const { return 320000; }
+    const char* getChipModel() const { return "native"; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,222 @@
+#pragma once
+
+/**
+ * @file ArduinoJson.h
+ * @brief Host-side stand-in for the subset of ArduinoJson 7 the firmware uses
+ *
+ * Parses complete JSON documents into a small tree and supports filtered
+ * deserialization (DeserializationOption::Filter), JsonDocument building
+ * through operator[], and read access through JsonVariantConst and
+ * JsonObjectConst. Malformed input reports InvalidInput or IncompleteInput
+ * like the library does. Writing through operator[] on a JsonDocument creates
+ * the element right away instead of through a lazy proxy.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Arduino.h"
+
+namespace native {
+namespace json {
+
+struct Node {
+    enum class Type : uint8_t {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<Node> items;
+    std::vector<std::pair<std::string, Node>> members;
+
+    const Node* member(const char* key) const;
+    Node& memberOrAdd(const char* key);
+};
+
+} // namespace json
+} // namespace native
+
+class JsonVariantConst {
+public:
+    JsonVariantConst() : node(nullptr) {}
+    explicit JsonVariantConst(const native::json::Node* node) : node(node) {}
+
+    bool isNull() const { return node == nullptr || node->type == native::json::Node::Type::NUL; }
+
+    JsonVariantConst operator[](const char* key) const;
+    JsonVariantConst operator[](int index) const;
+
+    template <typename T>
+    bool is() const;
+
+    template <typename T>
+    T as() const;
+
+    template <typename T>
+    operator T() const { return as<T>(); }
+
+    const native::json::Node* getNode() const { return node; }
+
+private:
+    const native::json::Node* node;
+};
+
+class JsonObjectConst {
+public:
+    JsonObjectConst() : node(nullptr) {}
+    JsonObjectConst(JsonVariantConst variant);
+
+    bool isNull() const { return node == nullptr; }
+    JsonVariantConst operator[](const char* key) const;
+
+private:
+    const native::json::Node* node;
+};
+
+/**
+ * @brief Writable element of a JsonDocument
+ */
+class JsonVariant {
+public:
+    explicit JsonVariant(native::json::Node* node) : node(node) {}
+
+    JsonVariant operator[](const char* key);
+    JsonVariant operator[](int index);
+
+    JsonVariant& operator=(bool value);
+    JsonVariant& operator=(double value);
+    JsonVariant& operator=(int value) { return *this = static_cast<double>(value); }
+    JsonVariant& operator=(float value) { return *this = static_cast<double>(value); }
+    JsonVariant& operator=(const char* value);
+
+    operator JsonVariantConst() const { return JsonVariantConst(node); }
+    operator JsonObjectConst() const { return JsonObjectConst(JsonVariantConst(node)); }
+
+private:
+    native::json::Node* node;
+};
+
+class JsonDocument {
+public:
+    JsonVariant operator[](const char* key) { return JsonVariant(&root)[key]; }
+    JsonVariant operator[](int index) { return JsonVariant(&root)[index]; }
+    JsonVariantConst operator[](const char* key) const { return JsonVariantConst(&root)[key]; }
+    JsonVariantConst operator[](int index) const { return JsonVariantConst(&root)[index]; }
+
+    bool isNull() const { return root.type == native::json::Node::Type::NUL; }
+    void clear() { root = native::json::Node{}; }
+
+    native::json::Node& getRoot() { return root; }
+    const native::json::Node& getRoot() const { return root; }
+
+private:
+    native::json::Node root;
+};
+
+class DeserializationError {
+public:
+    enum Code {
+        Ok,
+        EmptyInput,
+        IncompleteInput,
+        InvalidInput,
+        NoMemory,
+        TooDeep
+    };
+
+    DeserializationError(Code code = Ok) : code(code) {}
+
+    explicit operator bool() const { return code != Ok; }
+    bool operator==(Code other) const { return code == other; }
+    bool operator!=(Code other) const { return code != other; }
+    Code getCode() const { return code; }
+    const char* c_str() const;
+
+private:
+    Code code;
+};
+
+namespace DeserializationOption {
+
+class Filter {
+public:
+    explicit Filter(const JsonDocument& filter) : filter(filter.getRoot()) {}
+    const native::json::Node& getNode() const { return filter; }
+
+private:
+    const native::json::Node& filter;
+};
+
+} // namespace DeserializationOption
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input);
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::Filter filter);
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+    return deserializeJson(doc, input.c_str());
+}
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& input,
+                                            DeserializationOption::Filter filter) {
+    return deserializeJson(doc, input.c_str(), filter);
+}
+
+// ========== TEMPLATE DEFINITIONS ==========
+
+template <>
+inline bool JsonVariantConst::is<float>() const {
+    return node != nullptr && node->type == native::json::Node::Type::NUMBER;
+}
+
+template <>
+inline bool JsonVariantConst::is<double>() const {
+    return is<float>();
+}
+
+template <>
+inline bool JsonVariantConst::is<int>() const {
+    return is<float>() && static_cast<double>(static_cast<int>(node->number)) == node->number;
+}
+
+template <>
+inline bool JsonVariantConst::is<bool>() const {
+    return node != nullptr && node->type == native::json::Node::Type::BOOLEAN;
+}
+
+template <>
+inline bool JsonVariantConst::is<const char*>() const {
+    return node != nullptr && node->type == native::json::Node::Type::STRING;
+}
+
+template <>
+inline float JsonVariantConst::as<float>() const {
+    return is<float>() ? static_cast<float>(node->number) : 0.0f;
+}
+
+template <>
+inline double JsonVariantConst::as<double>() const {
+    return is<float>() ? node->number : 0.0;
+}
+
+template <>
+inline int JsonVariantConst::as<int>() const {
+    return is<float>() ? static_cast<int>(node->number) : 0;
+}
+
+template <>
+inline bool JsonVariantConst::as<bool>() const {
+    return is<bool>() && node->boolean;
+}
+
+template <>
+inline const char* JsonVariantConst::as<const char*>() const {
+    return is<const char*>() ? node->text.c_str() : nullptr;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * @file DHT.h
+ * @brief Host-side stand-in for the Adafruit DHT sensor library
+ */
+
+#include "Arduino.h"
+
+#define DHT11 11
+#define DHT12 12
+#define DHT22 22
+#define DHT21 21
+#define AM2301 21
+
+class DHT {
+public:
+    DHT(uint8_t pin, uint8_t type, uint8_t count = 6) : pin(pin), type(type) { (void)count; }
+
+    void begin(uint8_t usec = 55);
+    float readTemperature(bool fahrenheit = false, bool force = false);
+    float readHumidity(bool force = false);
+
+private:
+    uint8_t pin;
+    uint8_t type;
+    unsigned long lastReadTime = 0;
+    bool hasRead = false;
+    float temperature = NAN;
+    float humidity = NAN;
+
+    bool read(bool force);
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * @file DallasTemperature.h
+ * @brief Host-side stand-in for the DallasTemperature library (v4 API)
+ *
+ * Simulates native::Simulation::ds18b20Probes probes on one bus. ROM searches,
+ * scratchpad reads and temperature conversions charge their datasheet timing
+ * to the virtual clock; probe resolution lives in simulated hardware and
+ * therefore survives a simulated deep sleep like a powered probe would.
+ * Resolution writes also charge the EEPROM copy unless auto-save is off.
+ */
+
+#include "Arduino.h"
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+#define DEVICE_DISCONNECTED_F -196.6
+#define DEVICE_DISCONNECTED_RAW -7040
+
+typedef uint8_t DeviceAddress[8];
+
+class DallasTemperature {
+public:
+    struct request_t {
+        bool result;
+        unsigned long timestamp;
+        operator bool() const { return result; }
+    };
+
+    DallasTemperature() = default;
+    explicit DallasTemperature(OneWire* oneWire) : bus(oneWire) {}
+
+    void setOneWire(OneWire* oneWire) { bus = oneWire; }
+    void begin();
+
+    uint8_t getDeviceCount() const { return deviceCount; }
+    uint8_t getDS18Count() const { return deviceCount; }
+    bool validAddress(const uint8_t* address) const;
+    bool validFamily(const uint8_t* address) const { return address[0] == 0x28; }
+    bool getAddress(uint8_t* address, uint8_t index);
+    bool isConnected(const uint8_t* address);
+    bool isParasitePowerMode() const { return false; }
+
+    uint8_t getResolution() const { return bitResolution; }
+    void setResolution(uint8_t newResolution);
+    uint8_t getResolution(const uint8_t* address);
+    bool setResolution(const uint8_t* address, uint8_t newResolution, bool skipGlobalBitResolutionCalculation = false);
+
+    void setAutoSaveScratchPad(bool autoSave) { autoSaveScratchPad = autoSave; }
+    bool getAutoSaveScratchPad() const { return autoSaveScratchPad; }
+
+    void setWaitForConversion(bool wait) { waitForConversion = wait; }
+    bool getWaitForConversion() const { return waitForConversion; }
+    void setCheckForConversion(bool check) { checkForConversion = check; }
+    bool getCheckForConversion() const { return checkForConversion; }
+
+    request_t requestTemperatures();
+    request_t requestTemperaturesByAddress(const uint8_t* address);
+    request_t requestTemperaturesByIndex(uint8_t index);
+    bool isConversionComplete();
+    int16_t millisToWaitForConversion(uint8_t resolution) const;
+    int16_t millisToWaitForConversion() const { return millisToWaitForConversion(bitResolution); }
+
+    float getTempC(const uint8_t* address, uint8_t retryCount = 0);
+    float getTempCByIndex(uint8_t index);
+
+private:
+    OneWire* bus = nullptr;
+    uint8_t deviceCount = 0;
+    uint8_t bitResolution = 9;
+    bool waitForConversion = true;
+    bool checkForConversion = true;
+    bool autoSaveScratchPad = true;
+
+    int probeIndexOf(const uint8_t* address) const;
+    void blockTillConversionComplete(uint8_t resolution);
+};
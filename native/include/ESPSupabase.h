@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * @file ESPSupabase.h
+ * @brief Host-side stand-in for the ESPSupabase client
+ *
+ * Every request charges one HTTPS round trip (native::Simulation::httpsRequestMs)
+ * to the virtual clock, matching the library's connection-per-request behaviour,
+ * and answers with native::Simulation::httpsResponseCode while WiFi is up.
+ * Selects return the simulated newest row (selectRowValue, selectRowCreatedAt),
+ * or an empty array when a created_at=gt. filter is not older than it.
+ */
+
+#include "Arduino.h"
+
+class Supabase {
+public:
+    void begin(String url, String key) { baseUrl = url; apiKey = key; }
+
+    int insert(String table, String json, bool upsert);
+
+    Supabase& from(String table);
+    Supabase& select(String columns);
+    Supabase& eq(String column, String value) { return filter(column, "eq", value); }
+    Supabase& neq(String column, String value) { return filter(column, "neq", value); }
+    Supabase& gt(String column, String value) { return filter(column, "gt", value); }
+    Supabase& gte(String column, String value) { return filter(column, "gte", value); }
+    Supabase& lt(String column, String value) { return filter(column, "lt", value); }
+    Supabase& lte(String column, String value) { return filter(column, "lte", value); }
+    Supabase& order(String column, String direction, bool nullsFirst);
+    Supabase& limit(unsigned int count);
+    String doSelect();
+    void urlQuery_reset() { query = ""; }
+
+    /**
+     * @brief Request log for inspection (native only)
+     */
+    int getRequestCount() const { return requestCount; }
+    const String& getLastRequestBody() const { return lastRequestBody; }
+
+private:
+    String baseUrl;
+    String apiKey;
+    String query;
+    String lastRequestBody;
+    int requestCount = 0;
+
+    Supabase& filter(const String& column, const char* op, const String& value);
+    int roundTrip();
+};
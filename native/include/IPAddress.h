@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Arduino.h"
+
+/**
+ * @brief Host-side stand-in for the Arduino IPv4 address type
+ */
+class IPAddress {
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+    IPAddress(uint32_t address) { std::memcpy(octets, &address, sizeof(octets)); }
+
+    operator uint32_t() const {
+        uint32_t address;
+        std::memcpy(&address, octets, sizeof(address));
+        return address;
+    }
+
+    uint8_t operator[](int index) const { return octets[index]; }
+    bool operator==(const IPAddress& other) const { return std::memcmp(octets, other.octets, sizeof(octets)) == 0; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(buffer);
+    }
+
+private:
+    uint8_t octets[4] = {0, 0, 0, 0};
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file LittleFS.h
+ * @brief Host-side stand-in for the ESP32 LittleFS file system
+ *
+ * Files live in a directory on the host (native::Simulation::flashDirectory),
+ * so, like the real flash partition, they survive simulated deep sleep and
+ * can be inspected after a run. Opening, reading and writing charge typical
+ * LittleFS costs to the virtual clock.
+ */
+
+#include <memory>
+#include "Arduino.h"
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+class File {
+public:
+    File() = default;
+
+    size_t write(const uint8_t* buffer, size_t size);
+    size_t read(uint8_t* buffer, size_t size);
+    bool seek(uint32_t position, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close() { handle.reset(); }
+
+    explicit operator bool() const { return handle != nullptr; }
+
+private:
+    friend class LittleFSFS;
+    explicit File(FILE* file) : handle(file, fclose) {}
+
+    std::shared_ptr<FILE> handle;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = "spiffs");
+    void end() { mounted = false; }
+    bool format();
+
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool mkdir(const char* path);
+
+private:
+    bool mounted = false;
+
+    String hostPath(const char* path) const;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace native {
+
+/**
+ * @brief Virtual clock behind millis(), micros() and delay() on the host
+ *
+ * Time only advances when firmware code delays or when a simulated peripheral
+ * charges its bus/conversion cost, so a 15-minute deep-sleep cycle runs in
+ * milliseconds of wall time while awake time is still measured exactly.
+ */
+class VirtualClock {
+public:
+    /**
+     * @brief Microseconds since the current (simulated) boot
+     */
+    uint64_t bootMicros() const { return totalUs - bootStartUs; }
+
+    /**
+     * @brief Microseconds since the first power-on, including deep sleep
+     */
+    uint64_t totalMicros() const { return totalUs; }
+
+    /**
+     * @brief Advance time (delay() or simulated peripheral latency)
+     */
+    void advanceMicros(uint64_t us) { totalUs += us; }
+
+    /**
+     * @brief Start a new boot: millis() restarts at zero
+     */
+    void startBoot() { bootStartUs = totalUs; }
+
+    /**
+     * @brief Restore the total time reported by a finished wake cycle
+     */
+    void setTotalMicros(uint64_t us) { totalUs = us; }
+
+private:
+    uint64_t totalUs = 0;
+    uint64_t bootStartUs = 0;
+};
+
+VirtualClock& clock();
+
+/**
+ * @brief Charge a peripheral cost in milliseconds to the virtual clock
+ */
+inline void spendMillis(uint32_t ms) { clock().advanceMicros(static_cast<uint64_t>(ms) * 1000ULL); }
+
+/**
+ * @brief Charge a peripheral cost in microseconds to the virtual clock
+ */
+inline void spendMicros(uint32_t us) { clock().advanceMicros(us); }
+
+} // namespace native
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_system.h"
+
+// State of simulated external hardware (sensor registers, running conversions).
+// Like RTC memory it is carried across simulated deep sleep, because the real
+// peripherals stay powered while the MCU sleeps.
+#define NATIVE_HW_ATTR __attribute__((section("native_hw")))
+
+namespace native {
+
+/**
+ * @brief Timing and value model for the simulated peripherals
+ *
+ * Defaults approximate what we measured on the ESP32-C3 nodes so the native
+ * benchmark reports realistic awake times. Values can be tweaked from the
+ * runner's command line before the first wake cycle.
+ */
+struct Simulation {
+    // WiFi
+    uint32_t wifiScanMs = 1500;        // Full channel scan before association
+    uint32_t wifiAssociateMs = 900;    // Authentication + association
+    uint32_t wifiDhcpMs = 700;         // DHCP lease exchange
+    bool wifiAvailable = true;
+
+    // SNTP
+    uint32_t ntpSyncMs = 120;          // First SNTP response after configTime()
+    uint32_t epochAtPowerOn = 1767225600; // 2026-01-01T00:00:00Z
+
+    // HTTPS (ESPSupabase opens a new TLS session per request)
+    uint32_t httpsRequestMs = 650;
+    int httpsResponseCode = 201;
+
+    // PostgREST reads: the newest row answered to selects, unless a
+    // created_at=gt. filter already covers it
+    float selectRowValue = 4.5f;
+    const char* selectRowCreatedAt = "2026-01-01T00:00:00+00:00";
+    const char* selectResponseBody = nullptr;  // Answered verbatim instead, if set
+
+    // MQTT (in-process broker on the LAN)
+    uint32_t mqttConnectMs = 40;       // TCP handshake + CONNECT/CONNACK
+    uint32_t mqttPublishMs = 2;        // PUBLISH (QoS 0, no acknowledgement)
+    bool mqttAvailable = true;
+
+    // Flash file system (LittleFS), backed by a host directory
+    const char* flashDirectory = nullptr;
+    uint32_t flashMountMs = 25;
+    uint32_t flashOpenUs = 800;
+    uint32_t flashReadUsPerKb = 250;
+    uint32_t flashWriteUsPerKb = 3000;  // Program plus amortized block erase
+
+    // DHT11
+    float dhtTemperature = 21.5f;
+    float dhtHumidity = 48.0f;
+    uint32_t dhtReadMs = 25;
+
+    // DS18B20
+    uint8_t ds18b20Probes = 1;
+    float ds18b20Temperature = 8.25f;
+
+    // SCD-41
+    bool scd41Present = true;
+    uint16_t scd41Co2 = 612;
+    float scd41Temperature = 22.1f;
+    float scd41Humidity = 45.5f;
+};
+
+Simulation& simulation();
+
+/**
+ * @brief Start the next wake as after a reset of the given kind
+ *
+ * Sets the reset reason and wake-up cause the firmware sees and, for anything
+ * but a deep-sleep wake, zeroes RTC_DATA_ATTR memory like the bootloader.
+ */
+void simulateReset(esp_reset_reason_t reason);
+
+/**
+ * @brief Register the simulated I2C devices that are present on the bus
+ */
+void attachSimulatedDevices();
+
+/**
+ * @brief Number of operator new calls made by the current wake so far
+ */
+size_t heapAllocationCount();
+
+/**
+ * @brief Number of heap allocations made inside HeapAllocationGuard sections
+ *        since the process started; unit tests assert that it stays put
+ */
+size_t guardedAllocationCount();
+
+/**
+ * @brief Flags heap allocations made while the guard is alive
+ *
+ * Firmware code that must not allocate (built with -D NATIVE_BUILD) wraps
+ * itself in a guard. The runner reports guarded allocations per wake and
+ * exits with an error if there were any; unit tests assert on
+ * guardedAllocationCount().
+ */
+class HeapAllocationGuard {
+public:
+    explicit HeapAllocationGuard(const char* section);
+    ~HeapAllocationGuard();
+
+    HeapAllocationGuard(const HeapAllocationGuard&) = delete;
+    HeapAllocationGuard& operator=(const HeapAllocationGuard&) = delete;
+
+private:
+    const char* section;
+    size_t startCount;
+};
+
+} // namespace native
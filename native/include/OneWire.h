@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file OneWire.h
+ * @brief Host-side stand-in for the OneWire bus library
+ *
+ * Bus traffic itself is modelled inside the DallasTemperature stand-in; this
+ * class only carries the pin and the CRC helper used for ROM validation.
+ */
+
+#include "Arduino.h"
+
+class OneWire {
+public:
+    explicit OneWire(uint8_t pin) : pin(pin) {}
+
+    uint8_t getPin() const { return pin; }
+    uint8_t reset();
+
+    static uint8_t crc8(const uint8_t* address, uint8_t length);
+
+private:
+    uint8_t pin;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @file Preferences.h
+ * @brief Host-side stand-in for the ESP32 Preferences (NVS) library
+ *
+ * Stores byte blobs in a small simulated flash area that, like real NVS,
+ * survives simulated deep sleep. Reads and commits charge typical NVS
+ * latencies to the virtual clock.
+ */
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end() { opened = false; }
+
+    size_t putBytes(const char* key, const void* value, size_t length);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+    size_t getBytesLength(const char* key);
+    bool isKey(const char* key) { return getBytesLength(key) > 0; }
+    bool remove(const char* key);
+    bool clear();
+
+private:
+    char nameSpace[16] = {};
+    bool readOnly = false;
+    bool opened = false;
+};
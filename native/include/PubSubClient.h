@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file PubSubClient.h
+ * @brief Host-side stand-in for the PubSubClient MQTT library, with an
+ *        in-process broker behind it
+ *
+ * Connecting charges a TCP + CONNECT/CONNACK round trip
+ * (native::Simulation::mqttConnectMs) and each PUBLISH its send time. The
+ * broker accepts while WiFi is up and native::Simulation::mqttAvailable is
+ * set, logs every message it receives and keeps the retained ones, so that
+ * firmware output can be checked without a mosquitto instance. Size limits
+ * follow the library: a message that does not fit the client buffer is
+ * rejected.
+ */
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+#define MQTT_MAX_HEADER_SIZE 5
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+
+class PubSubClient {
+public:
+    explicit PubSubClient(WiFiClient& client) : client(client) {}
+
+    PubSubClient& setServer(const char* domain, uint16_t port);
+    PubSubClient& setKeepAlive(uint16_t seconds) { keepAliveSeconds = seconds; return *this; }
+    PubSubClient& setSocketTimeout(uint16_t seconds) { socketTimeoutSeconds = seconds; return *this; }
+    bool setBufferSize(uint16_t size);
+    uint16_t getBufferSize() const { return bufferSize; }
+
+    bool connect(const char* id);
+    bool connect(const char* id, const char* user, const char* pass);
+    bool connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                 uint8_t willQos, bool willRetain, const char* willMessage, bool cleanSession = true);
+    void disconnect();
+
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const char* payload, bool retained);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+
+    bool loop();
+    bool connected();
+    int state() const { return currentState; }
+
+    /**
+     * @brief Broker log for inspection (native only)
+     */
+    static int getMessageCount();
+    static int getRetainedCount();
+    static const char* getLastTopic();
+    static const char* getLastPayload();
+    static bool wasLastRetained();
+
+    /**
+     * @brief Retained payload of a topic, or nullptr if none (native only)
+     */
+    static const char* getRetained(const char* topic);
+
+private:
+    WiFiClient& client;
+    const char* domain = nullptr;
+    uint16_t port = 1883;
+    uint16_t bufferSize = 256;
+    uint16_t keepAliveSeconds = 15;
+    uint16_t socketTimeoutSeconds = 15;
+    int currentState = MQTT_DISCONNECTED;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file SensirionI2cScd4x.h
+ * @brief Host-side stand-in for the Sensirion SCD4x Arduino driver
+ *
+ * Mirrors the driver's public API and its built-in execution delays. Commands
+ * are sent as real I2C frames through the Wire stand-in to a simulated SCD-41,
+ * so code that talks to the sensor with raw Wire transactions sees the same
+ * device state as code using the driver.
+ */
+
+#include "Arduino.h"
+#include "Wire.h"
+
+class SensirionI2cScd4x {
+public:
+    void begin(TwoWire& i2cBus, uint8_t i2cAddress) { bus = &i2cBus; address = i2cAddress; }
+
+    int16_t startPeriodicMeasurement();
+    int16_t stopPeriodicMeasurement();
+    int16_t startLowPowerPeriodicMeasurement();
+    int16_t getDataReadyStatus(bool& dataReadyFlag);
+    int16_t readMeasurement(uint16_t& co2Concentration, float& temperature, float& relativeHumidity);
+    int16_t measureSingleShot();
+    int16_t measureSingleShotRhtOnly();
+    int16_t powerDown();
+    int16_t wakeUp();
+    int16_t reinit();
+    int16_t getSerialNumber(uint64_t& serialNumber);
+
+private:
+    TwoWire* bus = nullptr;
+    uint8_t address = 0x62;
+
+    int16_t sendCommand(uint16_t command, uint32_t executionTimeMs);
+    int16_t readWords(uint16_t command, uint32_t executionTimeMs, uint16_t* words, size_t count);
+};
+
+/**
+ * @brief Convert a driver error code to a human readable string
+ */
+void errorToString(int16_t error, char errorMessage[], size_t errorMessageSize);
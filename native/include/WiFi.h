@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file WiFi.h
+ * @brief Host-side stand-in for the ESP32 WiFi station API
+ *
+ * Connection progress is modelled on the virtual clock: begin() schedules the
+ * moment the station reports WL_CONNECTED based on the scan, association and
+ * DHCP costs in native::Simulation. Passing a known BSSID/channel skips the
+ * scan, a static config() skips DHCP.
+ */
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "NativeSimulation.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK
+} wifi_auth_mode_t;
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char* ssid, const char* password = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    bool mode(wifi_mode_t mode) { currentMode = mode; return true; }
+    wifi_mode_t getMode() const { return currentMode; }
+    bool setSleep(bool enabled) { (void)enabled; return true; }
+    void persistent(bool enabled) { (void)enabled; }
+    bool setAutoReconnect(bool enabled) { (void)enabled; return true; }
+
+    wl_status_t status();
+
+    IPAddress localIP() const { return connectedNow() ? ip : IPAddress(); }
+    IPAddress gatewayIP() const { return connectedNow() ? gateway : IPAddress(); }
+    IPAddress subnetMask() const { return connectedNow() ? subnet : IPAddress(); }
+    IPAddress dnsIP(uint8_t index = 0) const { (void)index; return connectedNow() ? dns : IPAddress(); }
+    int32_t RSSI() const { return connectedNow() ? -61 : 0; }
+    uint8_t* BSSID() { return connectedNow() ? accessPoint : nullptr; }
+    int32_t channel() const { return connectedNow() ? 6 : 0; }
+    String macAddress() const { return "24:58:7C:0A:1B:2C"; }
+    String SSID() const { return connectedNow() ? ssid : String(); }
+
+    int16_t scanNetworks();
+    String SSID(uint8_t index) const { return index == 0 ? ssid : String(); }
+    int32_t RSSI(uint8_t index) const { return index == 0 ? -61 : 0; }
+    wifi_auth_mode_t encryptionType(uint8_t index) const { (void)index; return WIFI_AUTH_WPA2_PSK; }
+
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+    bool started = false;
+    bool staticConfig = false;
+    uint64_t connectedAtUs = 0;
+    String ssid;
+    IPAddress ip{192, 168, 1, 87};
+    IPAddress gateway{192, 168, 1, 1};
+    IPAddress subnet{255, 255, 255, 0};
+    IPAddress dns{192, 168, 1, 1};
+    uint8_t accessPoint[6] = {0x9C, 0x53, 0x22, 0x41, 0x7E, 0x10};
+
+    bool connectedNow() const;
+};
+
+extern WiFiClass WiFi;
+
+/**
+ * @brief TCP client placeholder; the PubSubClient stand-in models the
+ *        broker connection itself
+ */
+class WiFiClient {
+public:
+    bool connected() { return WiFi.status() == WL_CONNECTED; }
+    void stop() {}
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file Wire.h
+ * @brief Host-side stand-in for the Arduino I2C master
+ *
+ * Each transaction charges its bit time at the configured clock to the virtual
+ * clock. Devices registered with attachDevice() ACK their address; everything
+ * else NACKs, which is enough for address scans and Sensirion command frames.
+ */
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    /**
+     * @brief Simulated I2C target
+     */
+    class Device {
+    public:
+        virtual ~Device() = default;
+        virtual void onWrite(const uint8_t* data, size_t length) = 0;
+        virtual size_t onRead(uint8_t* data, size_t length) = 0;
+    };
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool setClock(uint32_t frequency) { clockHz = frequency; return true; }
+    uint32_t getClock() const { return clockHz; }
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+    uint8_t endTransmission(bool sendStop = true);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+    int available() const { return static_cast<int>(rxLength - rxIndex); }
+    int read() { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
+
+    /**
+     * @brief Attach a simulated device (native only)
+     */
+    void attachDevice(uint8_t address, Device* device) { devices[address & 0x7F] = device; }
+
+private:
+    uint32_t clockHz = 100000;
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[64] = {};
+    size_t txLength = 0;
+    uint8_t rxBuffer[64] = {};
+    size_t rxLength = 0;
+    size_t rxIndex = 0;
+    Device* devices[128] = {};
+
+    void chargeBytes(size_t bytes) const;
+};
+
+extern TwoWire Wire;
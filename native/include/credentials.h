@@ -0,0 +1,22 @@
+#ifndef CREDENTIALS_H
+#define CREDENTIALS_H
+
+// Placeholder credentials for the native build: the stand-ins in native/
+// never contact these servers, so a clean checkout builds without
+// include/credentials.h
+
+// WiFi credentials
+const char* WIFI_SSID = "your_wifi_ssid";
+const char* WIFI_PASSWORD = "your_wifi_password";
+
+// MQTT credentials (if still needed)
+const char* MQTT_SERVER = "your_mqtt_server";
+const int MQTT_PORT = 1883;
+const char* MQTT_USER = "your_mqtt_user";
+const char* MQTT_PASSWORD = "your_mqtt_password";
+
+// Supabase credentials
+const char* SUPABASE_URL = "https://your-project.supabase.co";
+const char* SUPABASE_KEY = "your_supabase_anon_key";
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file esp_sleep.h
+ * @brief Host-side stand-in for the ESP-IDF sleep API
+ *
+ * esp_deep_sleep_start() ends the current simulated wake cycle: the runner
+ * records the awake time, carries RTC memory over and boots the next cycle
+ * after advancing the virtual clock by the configured wake-up timer.
+ */
+
+#include <cstdint>
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_TOUCHPAD,
+    ESP_SLEEP_WAKEUP_ULP,
+    ESP_SLEEP_WAKEUP_GPIO,
+    ESP_SLEEP_WAKEUP_UART
+} esp_sleep_wakeup_cause_t;
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeInUs);
+[[noreturn]] void esp_deep_sleep_start();
+[[noreturn]] void esp_deep_sleep(uint64_t timeInUs);
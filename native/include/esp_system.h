@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * @file esp_system.h
+ * @brief Host-side stand-in for the ESP-IDF reset reason API
+ *
+ * The runner reports ESP_RST_POWERON for the first wake, ESP_RST_DEEPSLEEP
+ * after a simulated deep sleep and ESP_RST_SW after ESP.restart(). Unit tests
+ * pick the reason with native::simulateReset().
+ */
+
+typedef enum {
+    ESP_RST_UNKNOWN = 0,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+esp_reset_reason_t esp_reset_reason();
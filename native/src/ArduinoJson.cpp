@@ -0,0 +1,328 @@
+#include "ArduinoJson.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+using native::json::Node;
+
+// Same default nesting limit as ArduinoJson (ARDUINOJSON_DEFAULT_NESTING_LIMIT)
+constexpr int NESTING_LIMIT = 10;
+
+class Parser {
+public:
+    explicit Parser(const char* input) : cursor(input) {}
+
+    DeserializationError parse(Node& root) {
+        skipSpace();
+        if (*cursor == '\0') {
+            return DeserializationError::EmptyInput;
+        }
+        return parseValue(root, 0);
+    }
+
+private:
+    const char* cursor;
+
+    void skipSpace() {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n') {
+            cursor++;
+        }
+    }
+
+    DeserializationError parseValue(Node& node, int depth) {
+        skipSpace();
+        switch (*cursor) {
+            case '\0':
+                return DeserializationError::IncompleteInput;
+            case '[':
+                return depth < NESTING_LIMIT ? parseArray(node, depth + 1) : DeserializationError::TooDeep;
+            case '{':
+                return depth < NESTING_LIMIT ? parseObject(node, depth + 1) : DeserializationError::TooDeep;
+            case '"':
+                node.type = Node::Type::STRING;
+                return parseString(node.text);
+            case 't':
+                node.type = Node::Type::BOOLEAN;
+                node.boolean = true;
+                return parseLiteral("true");
+            case 'f':
+                node.type = Node::Type::BOOLEAN;
+                node.boolean = false;
+                return parseLiteral("false");
+            case 'n':
+                node.type = Node::Type::NUL;
+                return parseLiteral("null");
+            default:
+                return parseNumber(node);
+        }
+    }
+
+    DeserializationError parseLiteral(const char* literal) {
+        for (const char* c = literal; *c != '\0'; c++, cursor++) {
+            if (*cursor == '\0') {
+                return DeserializationError::IncompleteInput;
+            }
+            if (*cursor != *c) {
+                return DeserializationError::InvalidInput;
+            }
+        }
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseNumber(Node& node) {
+        char* end = nullptr;
+        double value = strtod(cursor, &end);
+        if (end == cursor) {
+            return DeserializationError::InvalidInput;
+        }
+        cursor = end;
+        node.type = Node::Type::NUMBER;
+        node.number = value;
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseString(std::string& text) {
+        cursor++; // Opening quote
+        text.clear();
+        while (*cursor != '"') {
+            if (*cursor == '\0') {
+                return DeserializationError::IncompleteInput;
+            }
+            if (*cursor == '\\') {
+                cursor++;
+                switch (*cursor) {
+                    case '"':  text += '"'; break;
+                    case '\\': text += '\\'; break;
+                    case '/':  text += '/'; break;
+                    case 'b':  text += '\b'; break;
+                    case 'f':  text += '\f'; break;
+                    case 'n':  text += '\n'; break;
+                    case 'r':  text += '\r'; break;
+                    case 't':  text += '\t'; break;
+                    case '\0': return DeserializationError::IncompleteInput;
+                    default:   return DeserializationError::InvalidInput; // \u is not needed here
+                }
+                cursor++;
+                continue;
+            }
+            text += *cursor++;
+        }
+        cursor++; // Closing quote
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError parseArray(Node& node, int depth) {
+        cursor++; // [
+        node.type = Node::Type::ARRAY;
+        skipSpace();
+        if (*cursor == ']') {
+            cursor++;
+            return DeserializationError::Ok;
+        }
+        while (true) {
+            node.items.emplace_back();
+            DeserializationError error = parseValue(node.items.back(), depth);
+            if (error) {
+                return error;
+            }
+            skipSpace();
+            if (*cursor == ',') {
+                cursor++;
+            } else if (*cursor == ']') {
+                cursor++;
+                return DeserializationError::Ok;
+            } else {
+                return *cursor == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+            }
+        }
+    }
+
+    DeserializationError parseObject(Node& node, int depth) {
+        cursor++; // {
+        node.type = Node::Type::OBJECT;
+        skipSpace();
+        if (*cursor == '}') {
+            cursor++;
+            return DeserializationError::Ok;
+        }
+        while (true) {
+            skipSpace();
+            if (*cursor != '"') {
+                return *cursor == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+            }
+            node.members.emplace_back();
+            DeserializationError error = parseString(node.members.back().first);
+            if (error) {
+                return error;
+            }
+            skipSpace();
+            if (*cursor != ':') {
+                return *cursor == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+            }
+            cursor++;
+            error = parseValue(node.members.back().second, depth);
+            if (error) {
+                return error;
+            }
+            skipSpace();
+            if (*cursor == ',') {
+                cursor++;
+            } else if (*cursor == '}') {
+                cursor++;
+                return DeserializationError::Ok;
+            } else {
+                return *cursor == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Drop what the filter does not ask for, with the library's rules:
+ *        true keeps a value, an object keeps the listed members and the
+ *        first element of an array applies to every element
+ */
+void applyFilter(Node& value, const Node& filter) {
+    if (filter.type == Node::Type::BOOLEAN && filter.boolean) {
+        return;
+    }
+    if (filter.type == Node::Type::ARRAY && value.type == Node::Type::ARRAY && !filter.items.empty()) {
+        for (Node& item : value.items) {
+            applyFilter(item, filter.items[0]);
+        }
+        return;
+    }
+    if (filter.type == Node::Type::OBJECT && value.type == Node::Type::OBJECT) {
+        std::vector<std::pair<std::string, Node>> kept;
+        for (auto& member : value.members) {
+            const Node* memberFilter = filter.member(member.first.c_str());
+            if (memberFilter != nullptr) {
+                applyFilter(member.second, *memberFilter);
+                kept.push_back(std::move(member));
+            }
+        }
+        value.members = std::move(kept);
+        return;
+    }
+    value = Node{};
+}
+
+} // namespace
+
+const Node* Node::member(const char* key) const {
+    for (const auto& entry : members) {
+        if (entry.first == key) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+Node& Node::memberOrAdd(const char* key) {
+    for (auto& entry : members) {
+        if (entry.first == key) {
+            return entry.second;
+        }
+    }
+    members.emplace_back(key, Node{});
+    return members.back().second;
+}
+
+JsonVariantConst JsonVariantConst::operator[](const char* key) const {
+    if (node == nullptr || node->type != Node::Type::OBJECT) {
+        return JsonVariantConst();
+    }
+    return JsonVariantConst(node->member(key));
+}
+
+JsonVariantConst JsonVariantConst::operator[](int index) const {
+    if (node == nullptr || node->type != Node::Type::ARRAY || index < 0 ||
+        static_cast<size_t>(index) >= node->items.size()) {
+        return JsonVariantConst();
+    }
+    return JsonVariantConst(&node->items[index]);
+}
+
+JsonObjectConst::JsonObjectConst(JsonVariantConst variant)
+    : node(variant.getNode() != nullptr && variant.getNode()->type == Node::Type::OBJECT ? variant.getNode()
+                                                                                      : nullptr) {
+}
+
+JsonVariantConst JsonObjectConst::operator[](const char* key) const {
+    return node != nullptr ? JsonVariantConst(node->member(key)) : JsonVariantConst();
+}
+
+JsonVariant JsonVariant::operator[](const char* key) {
+    if (node->type != Node::Type::OBJECT) {
+        *node = Node{};
+        node->type = Node::Type::OBJECT;
+    }
+    return JsonVariant(&node->memberOrAdd(key));
+}
+
+JsonVariant JsonVariant::operator[](int index) {
+    if (node->type != Node::Type::ARRAY) {
+        *node = Node{};
+        node->type = Node::Type::ARRAY;
+    }
+    if (static_cast<size_t>(index) >= node->items.size()) {
+        node->items.resize(static_cast<size_t>(index) + 1);
+    }
+    return JsonVariant(&node->items[index]);
+}
+
+JsonVariant& JsonVariant::operator=(bool value) {
+    *node = Node{};
+    node->type = Node::Type::BOOLEAN;
+    node->boolean = value;
+    return *this;
+}
+
+JsonVariant& JsonVariant::operator=(double value) {
+    *node = Node{};
+    node->type = Node::Type::NUMBER;
+    node->number = value;
+    return *this;
+}
+
+JsonVariant& JsonVariant::operator=(const char* value) {
+    *node = Node{};
+    if (value != nullptr) {
+        node->type = Node::Type::STRING;
+        node->text = value;
+    }
+    return *this;
+}
+
+const char* DeserializationError::c_str() const {
+    switch (code) {
+        case Ok:              return "Ok";
+        case EmptyInput:      return "EmptyInput";
+        case IncompleteInput: return "IncompleteInput";
+        case InvalidInput:    return "InvalidInput";
+        case NoMemory:        return "NoMemory";
+        case TooDeep:         return "TooDeep";
+    }
+    return "???";
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    doc.clear();
+    if (input == nullptr) {
+        return DeserializationError::EmptyInput;
+    }
+    DeserializationError error = Parser(input).parse(doc.getRoot());
+    if (error) {
+        doc.clear();
+    }
+    return error;
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, DeserializationOption::Filter filter) {
+    DeserializationError error = deserializeJson(doc, input);
+    if (!error) {
+        applyFilter(doc.getRoot(), filter.getNode());
+    }
+    return error;
+}
@@ -0,0 +1,319 @@
+#include "Arduino.h"
+#include "WiFi.h"
+#include "Wire.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+TwoWire Wire;
+
+// ========== STRING ==========
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (data.size() != other.data.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < data.size(); i++) {
+        if (std::tolower(static_cast<unsigned char>(data[i])) !=
+            std::tolower(static_cast<unsigned char>(other.data[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return data.size() >= suffix.data.size() &&
+           data.compare(data.size() - suffix.data.size(), suffix.data.size(), suffix.data) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        std::swap(from, to);
+    }
+    if (from >= data.size()) {
+        return String();
+    }
+    return String(data.substr(from, to - from));
+}
+
+void String::trim() {
+    size_t begin = data.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        data.clear();
+        return;
+    }
+    size_t end = data.find_last_not_of(" \t\r\n");
+    data = data.substr(begin, end - begin + 1);
+}
+
+void String::toLowerCase() {
+    for (auto& c : data) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::toUpperCase() {
+    for (auto& c : data) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find.data.empty()) {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = data.find(find.data, pos)) != std::string::npos) {
+        data.replace(pos, find.data.size(), replacement.data);
+        pos += replacement.data.size();
+    }
+}
+
+void String::fromSigned(long long value, unsigned char base) {
+    if (value < 0 && base == DEC) {
+        fromUnsigned(static_cast<unsigned long long>(-value), base);
+        data.insert(data.begin(), '-');
+    } else {
+        fromUnsigned(static_cast<unsigned long long>(value), base);
+    }
+}
+
+void String::fromUnsigned(unsigned long long value, unsigned char base) {
+    static const char digits[] = "0123456789ABCDEF";
+    if (base < 2 || base > 16) {
+        base = DEC;
+    }
+    char buffer[65];
+    int pos = sizeof(buffer) - 1;
+    buffer[pos] = '\0';
+    do {
+        buffer[--pos] = digits[value % base];
+        value /= base;
+    } while (value > 0);
+    data = &buffer[pos];
+}
+
+void String::fromDouble(double value, unsigned int decimalPlaces) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimalPlaces), value);
+    data = buffer;
+}
+
+// ========== PRINT / SERIAL ==========
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+
+    if (length < 0) {
+        return 0;
+    }
+    if (static_cast<size_t>(length) < sizeof(stackBuffer)) {
+        return write(reinterpret_cast<const uint8_t*>(stackBuffer), length);
+    }
+
+    std::string heapBuffer(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&heapBuffer[0], heapBuffer.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t*>(heapBuffer.data()), length);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (!muted) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+// ========== GPIO ==========
+
+namespace {
+uint8_t pinLevels[64];
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < sizeof(pinLevels) && mode == INPUT_PULLUP) {
+        pinLevels[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < sizeof(pinLevels)) {
+        pinLevels[pin] = value;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+// ========== SNTP ==========
+
+namespace {
+bool timeSyncStarted = false;
+uint64_t timeSyncedAtUs = 0;
+}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2, const char* server3) {
+    (void)gmtOffsetSec;
+    (void)daylightOffsetSec;
+    (void)server1;
+    (void)server2;
+    (void)server3;
+    timeSyncStarted = true;
+    timeSyncedAtUs = native::clock().totalMicros() +
+                     static_cast<uint64_t>(native::simulation().ntpSyncMs) * 1000ULL;
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    // Like the ESP32 core: poll until the clock is set or the timeout expires
+    unsigned long start = millis();
+    while (!timeSyncStarted || WiFi.status() != WL_CONNECTED ||
+           native::clock().totalMicros() < timeSyncedAtUs) {
+        if (millis() - start >= ms) {
+            return false;
+        }
+        delay(10);
+    }
+
+    time_t now = static_cast<time_t>(native::simulation().epochAtPowerOn +
+                                     native::clock().totalMicros() / 1000000ULL);
+    localtime_r(&now, info);
+    return true;
+}
+
+// ========== WIFI ==========
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* password, int32_t channel,
+                             const uint8_t* bssid, bool connect) {
+    (void)password;
+    const native::Simulation& sim = native::simulation();
+
+    this->ssid = ssid;
+    currentMode = WIFI_STA;
+    started = connect;
+
+    uint32_t costMs = sim.wifiAssociateMs;
+    if (channel <= 0 || bssid == nullptr) {
+        costMs += sim.wifiScanMs;
+    }
+    if (!staticConfig) {
+        costMs += sim.wifiDhcpMs;
+    }
+    connectedAtUs = native::clock().totalMicros() + static_cast<uint64_t>(costMs) * 1000ULL;
+
+    return status();
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet,
+                       IPAddress dns1, IPAddress dns2) {
+    (void)dns2;
+    staticConfig = static_cast<uint32_t>(localIP) != 0;
+    if (staticConfig) {
+        ip = localIP;
+        this->gateway = gateway;
+        this->subnet = subnet;
+        dns = dns1;
+    }
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    (void)eraseAp;
+    started = false;
+    if (wifiOff) {
+        currentMode = WIFI_OFF;
+    }
+    return true;
+}
+
+wl_status_t WiFiClass::status() {
+    if (!started) {
+        return currentMode == WIFI_OFF ? WL_NO_SHIELD : WL_DISCONNECTED;
+    }
+    if (!native::simulation().wifiAvailable) {
+        return WL_NO_SSID_AVAIL;
+    }
+    return connectedNow() ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+int16_t WiFiClass::scanNetworks() {
+    native::spendMillis(native::simulation().wifiScanMs);
+    return native::simulation().wifiAvailable ? 1 : 0;
+}
+
+bool WiFiClass::connectedNow() const {
+    return started && native::simulation().wifiAvailable &&
+           native::clock().totalMicros() >= connectedAtUs;
+}
+
+// ========== I2C ==========
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)sda;
+    (void)scl;
+    if (frequency != 0) {
+        clockHz = frequency;
+    }
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress = address & 0x7F;
+    txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (txLength >= sizeof(txBuffer)) {
+        return 0;
+    }
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t written = 0;
+    while (written < length && write(data[written])) {
+        written++;
+    }
+    return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    chargeBytes(1 + txLength);
+
+    Device* device = devices[txAddress];
+    if (device == nullptr) {
+        return 2; // Address NACK
+    }
+    if (txLength > 0) {
+        device->onWrite(txBuffer, txLength);
+    }
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+    (void)sendStop;
+    rxIndex = 0;
+    rxLength = 0;
+    Device* device = devices[address & 0x7F];
+    chargeBytes(1 + quantity);
+    if (device == nullptr) {
+        return 0;
+    }
+    rxLength = device->onRead(rxBuffer, std::min<size_t>(quantity, sizeof(rxBuffer)));
+    return static_cast<uint8_t>(rxLength);
+}
+
+void TwoWire::chargeBytes(size_t bytes) const {
+    // 9 clocks per byte (8 data + ACK) plus start/stop overhead
+    uint64_t bits = bytes * 9 + 2;
+    native::clock().advanceMicros((bits * 1000000ULL) / clockHz);
+}
@@ -0,0 +1,71 @@
+#include "ESPSupabase.h"
+#include "NativeSimulation.h"
+#include "WiFi.h"
+
+int Supabase::insert(String table, String json, bool upsert) {
+    (void)table;
+    (void)upsert;
+    lastRequestBody = json;
+    return roundTrip();
+}
+
+Supabase& Supabase::from(String table) {
+    query = table + "?";
+    return *this;
+}
+
+Supabase& Supabase::select(String columns) {
+    query += "select=" + columns;
+    return *this;
+}
+
+Supabase& Supabase::order(String column, String direction, bool nullsFirst) {
+    query += "&order=" + column + "." + direction + (nullsFirst ? ".nullsfirst" : ".nullslast");
+    return *this;
+}
+
+Supabase& Supabase::limit(unsigned int count) {
+    query += "&limit=" + String(count);
+    return *this;
+}
+
+String Supabase::doSelect() {
+    lastRequestBody = "";
+    int code = roundTrip();
+    String request = query;
+    urlQuery_reset();
+    if (code < 200 || code >= 300) {
+        return String();
+    }
+
+    const native::Simulation& sim = native::simulation();
+    if (sim.selectResponseBody != nullptr) {
+        return String(sim.selectResponseBody);
+    }
+
+    // Like PostgREST, answer an empty array once the client has the newest row
+    int filter = request.indexOf("&created_at=gt.");
+    if (filter >= 0) {
+        int end = request.indexOf('&', filter + 1);
+        String after = request.substring(filter + 15, end >= 0 ? end : request.length());
+        after.replace("%2B", "+");
+        if (strcmp(after.c_str(), sim.selectRowCreatedAt) >= 0) {
+            return String("[]");
+        }
+    }
+    return "[{\"value\":" + String(sim.selectRowValue, 2) + ",\"created_at\":\"" + sim.selectRowCreatedAt + "\"}]";
+}
+
+Supabase& Supabase::filter(const String& column, const char* op, const String& value) {
+    query += "&" + column + "=" + op + "." + value;
+    return *this;
+}
+
+int Supabase::roundTrip() {
+    requestCount++;
+    if (WiFi.status() != WL_CONNECTED) {
+        return -1; // HTTPC_ERROR_CONNECTION_REFUSED
+    }
+    native::spendMillis(native::simulation().httpsRequestMs);
+    return native::simulation().httpsResponseCode;
+}
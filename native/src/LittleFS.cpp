@@ -0,0 +1,133 @@
+#include "LittleFS.h"
+#include "NativeSimulation.h"
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <cerrno>
+
+fs::LittleFSFS LittleFS;
+
+namespace {
+
+void chargeTransfer(size_t bytes, uint32_t usPerKilobyte) {
+    native::spendMicros(static_cast<uint32_t>((bytes * usPerKilobyte + 1023) / 1024));
+}
+
+} // namespace
+
+namespace fs {
+
+// ========== FILE ==========
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!handle) {
+        return 0;
+    }
+    chargeTransfer(size, native::simulation().flashWriteUsPerKb);
+    return fwrite(buffer, 1, size, handle.get());
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!handle) {
+        return 0;
+    }
+    size_t received = fread(buffer, 1, size, handle.get());
+    chargeTransfer(received, native::simulation().flashReadUsPerKb);
+    return received;
+}
+
+bool File::seek(uint32_t position, SeekMode mode) {
+    static const int ORIGINS[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+    return handle && fseek(handle.get(), static_cast<long>(position), ORIGINS[mode]) == 0;
+}
+
+size_t File::position() const {
+    return handle ? static_cast<size_t>(ftell(handle.get())) : 0;
+}
+
+size_t File::size() const {
+    if (!handle) {
+        return 0;
+    }
+    struct stat info;
+    fflush(handle.get());
+    return fstat(fileno(handle.get()), &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+}
+
+// ========== FILE SYSTEM ==========
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                       const char* partitionLabel) {
+    (void)formatOnFail;
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+
+    const char* directory = native::simulation().flashDirectory;
+    if (directory == nullptr || (::mkdir(directory, 0755) != 0 && errno != EEXIST)) {
+        return false;
+    }
+    if (!mounted) {
+        native::spendMillis(native::simulation().flashMountMs);
+        mounted = true;
+    }
+    return true;
+}
+
+bool LittleFSFS::format() {
+    // Only plain files and first-level directories are ever created
+    DIR* root = opendir(native::simulation().flashDirectory);
+    if (root == nullptr) {
+        return false;
+    }
+    while (dirent* entry = readdir(root)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        String path = String(native::simulation().flashDirectory) + "/" + entry->d_name;
+        if (DIR* sub = opendir(path.c_str())) {
+            while (dirent* child = readdir(sub)) {
+                if (child->d_name[0] != '.') {
+                    ::remove((path + "/" + child->d_name).c_str());
+                }
+            }
+            closedir(sub);
+        }
+        ::remove(path.c_str());
+    }
+    closedir(root);
+    return true;
+}
+
+File LittleFSFS::open(const char* path, const char* mode, bool create) {
+    (void)create;
+    if (!mounted) {
+        return File();
+    }
+    native::spendMicros(native::simulation().flashOpenUs);
+    FILE* file = fopen(hostPath(path).c_str(), mode[0] == 'r' ? "rb" : mode[0] == 'a' ? "ab" : "wb");
+    return file != nullptr ? File(file) : File();
+}
+
+bool LittleFSFS::exists(const char* path) {
+    struct stat info;
+    return mounted && stat(hostPath(path).c_str(), &info) == 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    if (!mounted) {
+        return false;
+    }
+    native::spendMicros(native::simulation().flashOpenUs);
+    return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool LittleFSFS::mkdir(const char* path) {
+    return mounted && (::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST);
+}
+
+String LittleFSFS::hostPath(const char* path) const {
+    return String(native::simulation().flashDirectory) + path;
+}
+
+} // namespace fs
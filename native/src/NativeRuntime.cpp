@@ -0,0 +1,440 @@
+/**
+ * @file NativeRuntime.cpp
+ * @brief Wake-cycle runner for the [env:native] host build
+ *
+ * Each simulated wake runs setup()/loop() in a forked child so that ordinary
+ * globals start fresh on every boot, exactly like on the ESP32. When the child
+ * enters deep sleep or restarts it ships its RTC memory (the rtc_data and
+ * rtc_noinit sections), the state of the simulated peripherals (native_hw) and
+ * its virtual clock back to the runner, which restores them before forking the
+ * next wake. After a restart rtc_data is zeroed, as the bootloader does.
+ *
+ * Heap allocations are counted so that sections guarded with
+ * native::HeapAllocationGuard can be verified to be allocation-free; the
+ * runner exits with status 1 if any guarded section allocated.
+ *
+ * The LittleFS stand-in keeps its files in a temporary directory that is
+ * removed after the run, unless --flash-dir names one to keep.
+ *
+ * --trace FILE replays recorded sensor values: a CSV of
+ * seconds,dht_temperature,dht_humidity,ds18b20_temperature,co2 rows (lines
+ * starting with # are skipped), interpolated at each wake's virtual time.
+ *
+ * The tests under test/ link the same stand-ins without the runner's main().
+ *
+ * Usage: program [--cycles N] [--quiet] [--probes N] [--no-wifi] [--no-mqtt] [--flash-dir DIR] [--trace FILE]
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "NativeSimulation.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+
+void setup();
+void loop();
+
+extern "C" {
+extern char __start_rtc_data[] __attribute__((weak));
+extern char __stop_rtc_data[] __attribute__((weak));
+extern char __start_rtc_noinit[] __attribute__((weak));
+extern char __stop_rtc_noinit[] __attribute__((weak));
+extern char __start_native_hw[] __attribute__((weak));
+extern char __stop_native_hw[] __attribute__((weak));
+}
+
+namespace native {
+
+VirtualClock& clock() {
+    static VirtualClock instance;
+    return instance;
+}
+
+Simulation& simulation() {
+    static Simulation instance;
+    return instance;
+}
+
+} // namespace native
+
+namespace {
+
+enum class WakeOutcome : uint8_t {
+    DEEP_SLEEP,
+    RESTART,
+    STALLED
+};
+
+struct WakeReport {
+    WakeOutcome outcome;
+    uint64_t totalUs;
+    uint64_t awakeUs;
+    uint64_t sleepUs;
+    uint32_t guardedSections;
+    uint32_t guardedAllocations;
+};
+
+// Give up on a wake that neither sleeps nor restarts within 10 virtual minutes
+constexpr unsigned long STALL_LIMIT_MS = 10UL * 60UL * 1000UL;
+
+int reportFd = -1;
+uint64_t timerWakeupUs = 0;
+esp_sleep_wakeup_cause_t wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+esp_reset_reason_t resetReason = ESP_RST_POWERON;
+
+struct TraceRow {
+    double seconds;
+    float dhtTemperature;
+    float dhtHumidity;
+    float ds18b20Temperature;
+    float co2;
+};
+
+std::vector<TraceRow> trace;
+
+size_t allocationCount = 0;
+uint32_t guardedSections = 0;
+uint32_t guardedAllocations = 0;
+
+size_t sectionSize(const char* start, const char* stop) {
+    return (start != nullptr && stop != nullptr) ? static_cast<size_t>(stop - start) : 0;
+}
+
+bool writeAll(int fd, const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    while (length > 0) {
+        ssize_t written = ::write(fd, bytes, length);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+#ifndef PIO_UNIT_TESTING
+bool readAll(int fd, void* data, size_t length) {
+    char* bytes = static_cast<char*>(data);
+    while (length > 0) {
+        ssize_t received = ::read(fd, bytes, length);
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+#endif
+
+[[noreturn]] void finishWake(WakeOutcome outcome) {
+    Serial.flush();
+
+    WakeReport report{};
+    report.outcome = outcome;
+    report.totalUs = native::clock().totalMicros();
+    report.awakeUs = native::clock().bootMicros();
+    report.sleepUs = timerWakeupUs;
+    report.guardedSections = guardedSections;
+    report.guardedAllocations = guardedAllocations;
+
+    bool ok = writeAll(reportFd, &report, sizeof(report)) &&
+              writeAll(reportFd, __start_rtc_data, sectionSize(__start_rtc_data, __stop_rtc_data)) &&
+              writeAll(reportFd, __start_rtc_noinit, sectionSize(__start_rtc_noinit, __stop_rtc_noinit)) &&
+              writeAll(reportFd, __start_native_hw, sectionSize(__start_native_hw, __stop_native_hw));
+    _exit(ok ? 0 : 1);
+}
+
+#ifndef PIO_UNIT_TESTING
+[[noreturn]] void runWake() {
+    native::clock().startBoot();
+    native::attachSimulatedDevices();
+
+    setup();
+    while (millis() < STALL_LIMIT_MS) {
+        loop();
+    }
+    finishWake(WakeOutcome::STALLED);
+}
+
+bool runCycle(WakeReport& report, bool quiet) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return false;
+    }
+
+    fflush(stdout);
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        return false;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        reportFd = fds[1];
+        Serial.setMuted(quiet);
+        runWake();
+    }
+
+    close(fds[1]);
+    bool ok = readAll(fds[0], &report, sizeof(report)) &&
+              readAll(fds[0], __start_rtc_data, sectionSize(__start_rtc_data, __stop_rtc_data)) &&
+              readAll(fds[0], __start_rtc_noinit, sectionSize(__start_rtc_noinit, __stop_rtc_noinit)) &&
+              readAll(fds[0], __start_native_hw, sectionSize(__start_native_hw, __stop_native_hw));
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+bool loadTrace(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        TraceRow row{};
+        if (line[0] == '#' || sscanf(line, "%lf,%f,%f,%f,%f", &row.seconds, &row.dhtTemperature,
+                                     &row.dhtHumidity, &row.ds18b20Temperature, &row.co2) != 5) {
+            continue;
+        }
+        trace.push_back(row);
+    }
+    fclose(file);
+    if (trace.empty()) {
+        fprintf(stderr, "%s: no trace rows\n", path);
+        return false;
+    }
+    return true;
+}
+
+void applyTrace(double seconds) {
+    if (trace.empty()) {
+        return;
+    }
+    size_t next = 0;
+    while (next < trace.size() && trace[next].seconds <= seconds) {
+        next++;
+    }
+    const TraceRow& a = trace[next == 0 ? 0 : next - 1];
+    const TraceRow& b = trace[next == trace.size() ? trace.size() - 1 : next];
+    double span = b.seconds - a.seconds;
+    float f = span > 0.0 ? static_cast<float>((seconds - a.seconds) / span) : 0.0f;
+
+    native::Simulation& sim = native::simulation();
+    sim.dhtTemperature = a.dhtTemperature + (b.dhtTemperature - a.dhtTemperature) * f;
+    sim.dhtHumidity = a.dhtHumidity + (b.dhtHumidity - a.dhtHumidity) * f;
+    sim.ds18b20Temperature = a.ds18b20Temperature + (b.ds18b20Temperature - a.ds18b20Temperature) * f;
+    sim.scd41Co2 = static_cast<uint16_t>(a.co2 + (b.co2 - a.co2) * f + 0.5f);
+}
+#endif
+
+void* countedAllocate(size_t size) {
+    allocationCount++;
+    void* pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+} // namespace
+
+// ========== HEAP ALLOCATION COUNTING ==========
+
+void* operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+size_t native::heapAllocationCount() {
+    return allocationCount;
+}
+
+size_t native::guardedAllocationCount() {
+    return guardedAllocations;
+}
+
+native::HeapAllocationGuard::HeapAllocationGuard(const char* section)
+    : section(section), startCount(allocationCount) {
+}
+
+native::HeapAllocationGuard::~HeapAllocationGuard() {
+    size_t allocations = allocationCount - startCount;
+    guardedSections++;
+    guardedAllocations += static_cast<uint32_t>(allocations);
+    if (allocations > 0) {
+        fprintf(stderr, "[native] %zu heap allocations in %s\n", allocations, section);
+    }
+}
+
+// ========== ESP-IDF / ARDUINO HOOKS ==========
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+    return wakeCause;
+}
+
+esp_reset_reason_t esp_reset_reason() {
+    return resetReason;
+}
+
+void native::simulateReset(esp_reset_reason_t reason) {
+    resetReason = reason;
+    if (reason == ESP_RST_DEEPSLEEP) {
+        wakeCause = ESP_SLEEP_WAKEUP_TIMER;
+        return;
+    }
+    wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    size_t size = sectionSize(__start_rtc_data, __stop_rtc_data);
+    if (size > 0) {
+        memset(__start_rtc_data, 0, size);
+    }
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeInUs) {
+    timerWakeupUs = timeInUs;
+    return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+    finishWake(WakeOutcome::DEEP_SLEEP);
+}
+
+void esp_deep_sleep(uint64_t timeInUs) {
+    esp_sleep_enable_timer_wakeup(timeInUs);
+    esp_deep_sleep_start();
+}
+
+void EspClass::restart() {
+    finishWake(WakeOutcome::RESTART);
+}
+
+// ========== RUNNER ==========
+
+// Unit tests (pio test -e native) bring their own main and call the firmware
+// modules directly
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+    int cycles = 10;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        String arg(argv[i]);
+        if (arg == "--cycles" && i + 1 < argc) {
+            cycles = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--probes" && i + 1 < argc) {
+            native::simulation().ds18b20Probes = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (arg == "--no-wifi") {
+            native::simulation().wifiAvailable = false;
+        } else if (arg == "--no-mqtt") {
+            native::simulation().mqttAvailable = false;
+        } else if (arg == "--flash-dir" && i + 1 < argc) {
+            native::simulation().flashDirectory = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            if (!loadTrace(argv[++i])) {
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Usage: %s [--cycles N] [--quiet] [--probes N] [--no-wifi] [--no-mqtt] [--flash-dir DIR] [--trace FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char flashTemplate[] = "/tmp/native-flash-XXXXXX";
+    bool temporaryFlash = native::simulation().flashDirectory == nullptr;
+    if (temporaryFlash) {
+        native::simulation().flashDirectory = mkdtemp(flashTemplate);
+    }
+
+    std::vector<uint64_t> awakeUs;
+    int exitCode = 0;
+
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        applyTrace(native::clock().totalMicros() / 1e6);
+
+        WakeReport report{};
+        if (!runCycle(report, quiet)) {
+            fprintf(stderr, "Wake #%d: firmware crashed\n", cycle + 1);
+            exitCode = 1;
+            break;
+        }
+
+        awakeUs.push_back(report.awakeUs);
+        printf("[native] Wake #%d: awake %.1f ms, sleep %llu s", cycle + 1,
+               report.awakeUs / 1000.0, static_cast<unsigned long long>(report.sleepUs / 1000000ULL));
+        if (report.guardedSections > 0) {
+            printf(", %u heap allocations in guarded sections", report.guardedAllocations);
+        }
+        printf("\n");
+
+        if (report.guardedAllocations > 0) {
+            exitCode = 1;
+        }
+
+        if (report.outcome == WakeOutcome::STALLED) {
+            fprintf(stderr, "Wake #%d: no deep sleep within %lu ms\n", cycle + 1, STALL_LIMIT_MS);
+            exitCode = 1;
+            break;
+        }
+
+        native::clock().setTotalMicros(report.totalUs + report.sleepUs);
+        timerWakeupUs = 0;
+        native::simulateReset(report.outcome == WakeOutcome::DEEP_SLEEP ? ESP_RST_DEEPSLEEP : ESP_RST_SW);
+    }
+
+    if (!awakeUs.empty()) {
+        uint64_t minUs = awakeUs[0];
+        uint64_t maxUs = awakeUs[0];
+        uint64_t sumUs = 0;
+        for (uint64_t us : awakeUs) {
+            minUs = std::min(minUs, us);
+            maxUs = std::max(maxUs, us);
+            sumUs += us;
+        }
+        printf("[native] === Wake-cycle benchmark (%zu cycles) ===\n", awakeUs.size());
+        printf("[native] Awake time: min %.1f ms, mean %.1f ms, max %.1f ms\n",
+               minUs / 1000.0, sumUs / 1000.0 / awakeUs.size(), maxUs / 1000.0);
+    }
+
+    if (temporaryFlash && native::simulation().flashDirectory != nullptr) {
+        LittleFS.format();
+        rmdir(native::simulation().flashDirectory);
+    }
+
+    return exitCode;
+}
+#endif
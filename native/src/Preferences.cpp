@@ -0,0 +1,115 @@
+#include "Preferences.h"
+#include "NativeSimulation.h"
+
+namespace {
+
+constexpr size_t MAX_ENTRIES = 16;
+constexpr size_t MAX_NAME_LENGTH = 16;
+constexpr size_t MAX_VALUE_LENGTH = 256;
+
+// Typical NVS costs on the ESP32-C3: page lookup on read, erase + write on commit
+constexpr uint32_t NVS_READ_US = 300;
+constexpr uint32_t NVS_COMMIT_US = 4000;
+
+struct NvsEntry {
+    bool used;
+    char nameSpace[MAX_NAME_LENGTH];
+    char key[MAX_NAME_LENGTH];
+    uint16_t length;
+    uint8_t value[MAX_VALUE_LENGTH];
+};
+
+NvsEntry nvsFlash[MAX_ENTRIES] NATIVE_HW_ATTR;
+
+NvsEntry* findEntry(const char* nameSpace, const char* key) {
+    for (auto& entry : nvsFlash) {
+        if (entry.used && strncmp(entry.nameSpace, nameSpace, MAX_NAME_LENGTH) == 0 &&
+            strncmp(entry.key, key, MAX_NAME_LENGTH) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    (void)partitionLabel;
+    if (name == nullptr || strlen(name) >= sizeof(nameSpace)) {
+        return false;
+    }
+    strncpy(nameSpace, name, sizeof(nameSpace) - 1);
+    this->readOnly = readOnly;
+    opened = true;
+    return true;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (!opened || readOnly || key == nullptr || strlen(key) >= MAX_NAME_LENGTH ||
+        length == 0 || length > MAX_VALUE_LENGTH) {
+        return 0;
+    }
+
+    NvsEntry* entry = findEntry(nameSpace, key);
+    for (size_t i = 0; entry == nullptr && i < MAX_ENTRIES; i++) {
+        if (!nvsFlash[i].used) {
+            entry = &nvsFlash[i];
+            entry->used = true;
+            strncpy(entry->nameSpace, nameSpace, MAX_NAME_LENGTH - 1);
+            strncpy(entry->key, key, MAX_NAME_LENGTH - 1);
+        }
+    }
+    if (entry == nullptr) {
+        return 0; // Simulated partition full
+    }
+
+    native::spendMicros(NVS_COMMIT_US);
+    memcpy(entry->value, value, length);
+    entry->length = static_cast<uint16_t>(length);
+    return length;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    if (!opened) {
+        return 0;
+    }
+    native::spendMicros(NVS_READ_US);
+    const NvsEntry* entry = findEntry(nameSpace, key);
+    if (entry == nullptr || entry->length > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, entry->value, entry->length);
+    return entry->length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!opened) {
+        return 0;
+    }
+    native::spendMicros(NVS_READ_US);
+    const NvsEntry* entry = findEntry(nameSpace, key);
+    return entry != nullptr ? entry->length : 0;
+}
+
+bool Preferences::remove(const char* key) {
+    NvsEntry* entry = opened && !readOnly ? findEntry(nameSpace, key) : nullptr;
+    if (entry == nullptr) {
+        return false;
+    }
+    native::spendMicros(NVS_COMMIT_US);
+    *entry = NvsEntry{};
+    return true;
+}
+
+bool Preferences::clear() {
+    if (!opened || readOnly) {
+        return false;
+    }
+    for (auto& entry : nvsFlash) {
+        if (entry.used && strncmp(entry.nameSpace, nameSpace, MAX_NAME_LENGTH) == 0) {
+            entry = NvsEntry{};
+        }
+    }
+    native::spendMicros(NVS_COMMIT_US);
+    return true;
+}
@@ -0,0 +1,194 @@
+#include "PubSubClient.h"
+#include "NativeSimulation.h"
+
+namespace {
+
+constexpr size_t MAX_RETAINED = 32;
+constexpr size_t MAX_TOPIC_LENGTH = 128;
+constexpr size_t MAX_RETAINED_PAYLOAD = 256;
+constexpr size_t MAX_PAYLOAD = 2048;
+
+struct RetainedMessage {
+    bool used;
+    char topic[MAX_TOPIC_LENGTH];
+    uint16_t length;
+    char payload[MAX_RETAINED_PAYLOAD];
+};
+
+// The broker keeps running while the node sleeps
+struct Broker {
+    RetainedMessage retained[MAX_RETAINED];
+    int messageCount;
+    char lastTopic[MAX_TOPIC_LENGTH];
+    char lastPayload[MAX_PAYLOAD + 1];
+    bool lastRetained;
+};
+
+Broker broker NATIVE_HW_ATTR;
+
+bool brokerReachable() {
+    return WiFi.status() == WL_CONNECTED && native::simulation().mqttAvailable;
+}
+
+void retain(const char* topic, const char* payload, unsigned int length) {
+    RetainedMessage* slot = nullptr;
+    for (auto& message : broker.retained) {
+        if (message.used && strncmp(message.topic, topic, MAX_TOPIC_LENGTH) == 0) {
+            slot = &message;
+            break;
+        }
+        if (!message.used && slot == nullptr) {
+            slot = &message;
+        }
+    }
+    if (slot == nullptr) {
+        return;
+    }
+
+    // An empty retained message clears the topic, as on a real broker
+    if (length == 0) {
+        slot->used = false;
+        return;
+    }
+    slot->used = true;
+    snprintf(slot->topic, sizeof(slot->topic), "%s", topic);
+    slot->length = static_cast<uint16_t>(std::min<size_t>(length, MAX_RETAINED_PAYLOAD));
+    memcpy(slot->payload, payload, slot->length);
+}
+
+} // namespace
+
+PubSubClient& PubSubClient::setServer(const char* domain, uint16_t port) {
+    this->domain = domain;
+    this->port = port;
+    return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+    if (size == 0) {
+        return false;
+    }
+    bufferSize = size;
+    return true;
+}
+
+bool PubSubClient::connect(const char* id) {
+    return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    return connect(id, user, pass, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                           uint8_t willQos, bool willRetain, const char* willMessage, bool cleanSession) {
+    (void)id;
+    (void)user;
+    (void)pass;
+    (void)willTopic;
+    (void)willQos;
+    (void)willRetain;
+    (void)willMessage;
+    (void)cleanSession;
+
+    if (connected()) {
+        return true;
+    }
+    if (domain == nullptr || !brokerReachable()) {
+        // Nobody answers: the attempt costs the whole socket timeout
+        native::spendMillis(socketTimeoutSeconds * 1000u);
+        currentState = MQTT_CONNECTION_TIMEOUT;
+        return false;
+    }
+
+    native::spendMillis(native::simulation().mqttConnectMs);
+    currentState = MQTT_CONNECTED;
+    return true;
+}
+
+void PubSubClient::disconnect() {
+    if (currentState == MQTT_CONNECTED) {
+        native::spendMillis(native::simulation().mqttPublishMs);
+    }
+    currentState = MQTT_DISCONNECTED;
+    client.stop();
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+    return publish(topic, payload, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, reinterpret_cast<const uint8_t*>(payload), strlen(payload), retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+    if (!connected()) {
+        return false;
+    }
+
+    // Same limit as the library: header, topic length prefix, topic and payload
+    if (MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + length > bufferSize) {
+        return false;
+    }
+
+    native::spendMillis(native::simulation().mqttPublishMs);
+    broker.messageCount++;
+    const char* text = reinterpret_cast<const char*>(payload);
+    snprintf(broker.lastTopic, sizeof(broker.lastTopic), "%s", topic);
+    snprintf(broker.lastPayload, sizeof(broker.lastPayload), "%.*s", (int)length, text);
+    broker.lastRetained = retained;
+    if (retained) {
+        retain(topic, text, length);
+    }
+    Serial.printf("MQTT broker <- %s%s: %.*s\n", topic, retained ? " (retained)" : "", (int)length, text);
+    return true;
+}
+
+bool PubSubClient::loop() {
+    return connected();
+}
+
+bool PubSubClient::connected() {
+    if (currentState == MQTT_CONNECTED && !brokerReachable()) {
+        currentState = MQTT_CONNECTION_LOST;
+    }
+    return currentState == MQTT_CONNECTED;
+}
+
+int PubSubClient::getMessageCount() {
+    return broker.messageCount;
+}
+
+int PubSubClient::getRetainedCount() {
+    int count = 0;
+    for (const auto& message : broker.retained) {
+        if (message.used) {
+            count++;
+        }
+    }
+    return count;
+}
+
+const char* PubSubClient::getLastTopic() {
+    return broker.lastTopic;
+}
+
+const char* PubSubClient::getLastPayload() {
+    return broker.lastPayload;
+}
+
+bool PubSubClient::wasLastRetained() {
+    return broker.lastRetained;
+}
+
+const char* PubSubClient::getRetained(const char* topic) {
+    static char text[MAX_RETAINED_PAYLOAD + 1];
+    for (const auto& message : broker.retained) {
+        if (message.used && strncmp(message.topic, topic, MAX_TOPIC_LENGTH) == 0) {
+            snprintf(text, sizeof(text), "%.*s", (int)message.length, message.payload);
+            return text;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,630 @@
+#include "DHT.h"
+#include "DallasTemperature.h"
+#include "NativeSimulation.h"
+#include "OneWire.h"
+#include "SensirionI2cScd4x.h"
+#include "Wire.h"
+
+namespace {
+
+// ========== SIMULATED HARDWARE STATE ==========
+
+constexpr uint8_t MAX_PROBES = 16;
+
+struct Ds18b20Hardware {
+    uint8_t resolution[MAX_PROBES];
+    bool resolutionSet[MAX_PROBES];
+    uint64_t conversionStartUs;
+    uint8_t conversionResolution;
+    bool conversionValid;
+};
+
+enum class Scd4xMode : uint8_t {
+    IDLE = 0,
+    PERIODIC,
+    SINGLE_SHOT,
+    SLEEPING
+};
+
+struct Scd4xHardware {
+    Scd4xMode mode;
+    uint64_t modeStartUs;
+    uint32_t periodMs;
+    uint32_t lastSampleRead;
+    bool singleShotRhtOnly;
+    bool singleShotRead;
+    uint16_t pendingCommand;
+};
+
+Ds18b20Hardware ds18b20Hardware NATIVE_HW_ATTR;
+Scd4xHardware scd4xHardware NATIVE_HW_ATTR;
+
+uint64_t nowUs() {
+    return native::clock().totalMicros();
+}
+
+// ========== SENSIRION FRAMING ==========
+
+uint8_t sensirionCrc(const uint8_t* data, size_t length) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+constexpr int16_t SCD4X_ERROR_NACK = 0x0100;
+constexpr int16_t SCD4X_ERROR_CRC = 0x0200;
+constexpr int16_t SCD4X_ERROR_NOT_ENOUGH_DATA = 0x0300;
+
+/**
+ * @brief Simulated SCD-41 behind the Wire stand-in
+ */
+class Scd4xDevice : public TwoWire::Device {
+public:
+    void onWrite(const uint8_t* data, size_t length) override {
+        if (length < 2) {
+            return;
+        }
+        uint16_t command = static_cast<uint16_t>((data[0] << 8) | data[1]);
+        Scd4xHardware& hw = scd4xHardware;
+
+        if (hw.mode == Scd4xMode::SLEEPING && command != CMD_WAKE_UP) {
+            return;
+        }
+
+        switch (command) {
+            case CMD_START_PERIODIC:
+                startMode(Scd4xMode::PERIODIC, 5000);
+                break;
+            case CMD_START_LOW_POWER_PERIODIC:
+                startMode(Scd4xMode::PERIODIC, 30000);
+                break;
+            case CMD_STOP_PERIODIC:
+            case CMD_REINIT:
+                hw.mode = Scd4xMode::IDLE;
+                break;
+            case CMD_SINGLE_SHOT:
+            case CMD_SINGLE_SHOT_RHT_ONLY:
+                startMode(Scd4xMode::SINGLE_SHOT, command == CMD_SINGLE_SHOT ? 5000 : 50);
+                hw.singleShotRhtOnly = command == CMD_SINGLE_SHOT_RHT_ONLY;
+                hw.singleShotRead = false;
+                break;
+            case CMD_POWER_DOWN:
+                hw.mode = Scd4xMode::SLEEPING;
+                break;
+            case CMD_WAKE_UP:
+                if (hw.mode == Scd4xMode::SLEEPING) {
+                    hw.mode = Scd4xMode::IDLE;
+                }
+                break;
+            default:
+                break;
+        }
+        hw.pendingCommand = command;
+    }
+
+    size_t onRead(uint8_t* data, size_t length) override {
+        Scd4xHardware& hw = scd4xHardware;
+        uint16_t words[3] = {0, 0, 0};
+        size_t wordCount = 0;
+
+        switch (hw.pendingCommand) {
+            case CMD_GET_DATA_READY:
+                words[0] = dataReady() ? 0x8006 : 0x8000;
+                wordCount = 1;
+                break;
+            case CMD_READ_MEASUREMENT: {
+                if (!dataReady()) {
+                    return 0;
+                }
+                markRead();
+                const native::Simulation& sim = native::simulation();
+                bool rhtOnly = hw.mode == Scd4xMode::SINGLE_SHOT && hw.singleShotRhtOnly;
+                words[0] = rhtOnly ? 0 : sim.scd41Co2;
+                words[1] = static_cast<uint16_t>((sim.scd41Temperature + 45.0f) * 65535.0f / 175.0f);
+                words[2] = static_cast<uint16_t>(sim.scd41Humidity * 65535.0f / 100.0f);
+                wordCount = 3;
+                break;
+            }
+            case CMD_GET_SERIAL_NUMBER:
+                words[0] = 0x2F41;
+                words[1] = 0x07A3;
+                words[2] = 0x3B1E;
+                wordCount = 3;
+                break;
+            default:
+                return 0;
+        }
+
+        size_t produced = 0;
+        for (size_t i = 0; i < wordCount && produced + 3 <= length; i++) {
+            data[produced] = static_cast<uint8_t>(words[i] >> 8);
+            data[produced + 1] = static_cast<uint8_t>(words[i] & 0xFF);
+            data[produced + 2] = sensirionCrc(&data[produced], 2);
+            produced += 3;
+        }
+        return produced;
+    }
+
+    static constexpr uint16_t CMD_START_PERIODIC = 0x21B1;
+    static constexpr uint16_t CMD_START_LOW_POWER_PERIODIC = 0x21AC;
+    static constexpr uint16_t CMD_READ_MEASUREMENT = 0xEC05;
+    static constexpr uint16_t CMD_STOP_PERIODIC = 0x3F86;
+    static constexpr uint16_t CMD_GET_DATA_READY = 0xE4B8;
+    static constexpr uint16_t CMD_SINGLE_SHOT = 0x219D;
+    static constexpr uint16_t CMD_SINGLE_SHOT_RHT_ONLY = 0x2196;
+    static constexpr uint16_t CMD_POWER_DOWN = 0x36E0;
+    static constexpr uint16_t CMD_WAKE_UP = 0x36F6;
+    static constexpr uint16_t CMD_REINIT = 0x3646;
+    static constexpr uint16_t CMD_GET_SERIAL_NUMBER = 0x3682;
+
+private:
+    void startMode(Scd4xMode mode, uint32_t periodMs) {
+        Scd4xHardware& hw = scd4xHardware;
+        hw.mode = mode;
+        hw.modeStartUs = nowUs();
+        hw.periodMs = periodMs;
+        hw.lastSampleRead = 0;
+    }
+
+    uint32_t latestSample() const {
+        const Scd4xHardware& hw = scd4xHardware;
+        uint64_t elapsedMs = (nowUs() - hw.modeStartUs) / 1000ULL;
+        return static_cast<uint32_t>(elapsedMs / hw.periodMs);
+    }
+
+    bool dataReady() const {
+        const Scd4xHardware& hw = scd4xHardware;
+        switch (hw.mode) {
+            case Scd4xMode::PERIODIC:
+                return latestSample() > hw.lastSampleRead;
+            case Scd4xMode::SINGLE_SHOT:
+                return !hw.singleShotRead && latestSample() >= 1;
+            default:
+                return false;
+        }
+    }
+
+    void markRead() {
+        Scd4xHardware& hw = scd4xHardware;
+        if (hw.mode == Scd4xMode::PERIODIC) {
+            hw.lastSampleRead = latestSample();
+        } else {
+            hw.singleShotRead = true;
+        }
+    }
+};
+
+Scd4xDevice scd4xDevice;
+
+} // namespace
+
+namespace native {
+
+/**
+ * @brief Register simulated I2C devices for the current wake cycle
+ */
+void attachSimulatedDevices() {
+    Wire.attachDevice(0x62, simulation().scd41Present ? &scd4xDevice : nullptr);
+}
+
+} // namespace native
+
+// ========== DHT ==========
+
+void DHT::begin(uint8_t usec) {
+    (void)usec;
+    // Mirrors the Adafruit driver: the first read after begin() is never throttled
+    lastReadTime = millis() - 2000;
+    hasRead = false;
+}
+
+bool DHT::read(bool force) {
+    unsigned long now = millis();
+    if (!force && hasRead && (now - lastReadTime) < 2000) {
+        return true;
+    }
+    lastReadTime = now;
+    hasRead = true;
+
+    // 18 ms start signal plus 40 data bits
+    native::spendMillis(native::simulation().dhtReadMs);
+    temperature = native::simulation().dhtTemperature;
+    humidity = native::simulation().dhtHumidity;
+    return true;
+}
+
+float DHT::readTemperature(bool fahrenheit, bool force) {
+    if (!read(force)) {
+        return NAN;
+    }
+    return fahrenheit ? temperature * 1.8f + 32.0f : temperature;
+}
+
+float DHT::readHumidity(bool force) {
+    if (!read(force)) {
+        return NAN;
+    }
+    return humidity;
+}
+
+// ========== ONEWIRE ==========
+
+uint8_t OneWire::reset() {
+    // 480 us reset pulse + 480 us presence window
+    native::spendMicros(960);
+    return native::simulation().ds18b20Probes > 0 ? 1 : 0;
+}
+
+uint8_t OneWire::crc8(const uint8_t* address, uint8_t length) {
+    uint8_t crc = 0;
+    while (length--) {
+        uint8_t inbyte = *address++;
+        for (uint8_t i = 8; i; i--) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// ========== DALLAS TEMPERATURE ==========
+
+namespace {
+
+constexpr uint32_t ONEWIRE_SLOT_US = 70;
+
+uint8_t probeCount() {
+    return std::min<uint8_t>(native::simulation().ds18b20Probes, MAX_PROBES);
+}
+
+void probeAddress(uint8_t index, uint8_t* address) {
+    address[0] = 0x28;
+    address[1] = 0xA1;
+    address[2] = 0x5C;
+    address[3] = static_cast<uint8_t>(0x10 + index);
+    address[4] = 0x0B;
+    address[5] = 0x00;
+    address[6] = 0x00;
+    address[7] = OneWire::crc8(address, 7);
+}
+
+uint8_t probeResolution(uint8_t index) {
+    const Ds18b20Hardware& hw = ds18b20Hardware;
+    return hw.resolutionSet[index] ? hw.resolution[index] : 12; // Factory default
+}
+
+void chargeRomSearch() {
+    // Reset + 64 ROM bits, each read twice and written once
+    native::spendMicros(960 + 64 * 3 * ONEWIRE_SLOT_US);
+}
+
+void chargeScratchpadRead() {
+    // Reset + Match ROM (8 bytes) + command + 9 scratchpad bytes
+    native::spendMicros(960 + (1 + 8 + 1 + 9) * 8 * ONEWIRE_SLOT_US);
+}
+
+void chargeScratchpadWrite(bool copyToEeprom) {
+    // Reset + Match ROM + Write Scratchpad + TH, TL, config
+    native::spendMicros(960 + (1 + 8 + 1 + 3) * 8 * ONEWIRE_SLOT_US);
+    if (copyToEeprom) {
+        // Reset + Match ROM + Copy Scratchpad, then the library's 20 ms EEPROM wait
+        native::spendMicros(960 + (1 + 8 + 1) * 8 * ONEWIRE_SLOT_US);
+        native::spendMillis(20);
+    }
+}
+
+} // namespace
+
+void DallasTemperature::begin() {
+    deviceCount = 0;
+    bitResolution = 9;
+    for (uint8_t i = 0; i < probeCount(); i++) {
+        chargeRomSearch();
+        chargeScratchpadRead();
+        bitResolution = std::max(bitResolution, probeResolution(i));
+        deviceCount++;
+    }
+    chargeRomSearch(); // Final search pass that finds no further device
+}
+
+bool DallasTemperature::validAddress(const uint8_t* address) const {
+    return OneWire::crc8(address, 7) == address[7];
+}
+
+bool DallasTemperature::getAddress(uint8_t* address, uint8_t index) {
+    for (uint8_t i = 0; i <= index && i < probeCount(); i++) {
+        chargeRomSearch();
+    }
+    if (index >= probeCount()) {
+        return false;
+    }
+    probeAddress(index, address);
+    return true;
+}
+
+bool DallasTemperature::isConnected(const uint8_t* address) {
+    chargeScratchpadRead();
+    return probeIndexOf(address) >= 0;
+}
+
+void DallasTemperature::setResolution(uint8_t newResolution) {
+    bitResolution = std::min<uint8_t>(std::max<uint8_t>(newResolution, 9), 12);
+    for (uint8_t i = 0; i < probeCount(); i++) {
+        chargeScratchpadRead();
+        ds18b20Hardware.resolution[i] = bitResolution;
+        ds18b20Hardware.resolutionSet[i] = true;
+    }
+}
+
+uint8_t DallasTemperature::getResolution(const uint8_t* address) {
+    chargeScratchpadRead();
+    int index = probeIndexOf(address);
+    return index >= 0 ? probeResolution(static_cast<uint8_t>(index)) : 0;
+}
+
+bool DallasTemperature::setResolution(const uint8_t* address, uint8_t newResolution,
+                                      bool skipGlobalBitResolutionCalculation) {
+    int index = probeIndexOf(address);
+    if (index < 0) {
+        return false;
+    }
+    chargeScratchpadRead();
+    chargeScratchpadWrite(autoSaveScratchPad);
+    uint8_t resolution = std::min<uint8_t>(std::max<uint8_t>(newResolution, 9), 12);
+    ds18b20Hardware.resolution[index] = resolution;
+    ds18b20Hardware.resolutionSet[index] = true;
+    if (!skipGlobalBitResolutionCalculation) {
+        bitResolution = resolution;
+        for (uint8_t i = 0; i < probeCount(); i++) {
+            bitResolution = std::max(bitResolution, probeResolution(i));
+        }
+    }
+    return true;
+}
+
+DallasTemperature::request_t DallasTemperature::requestTemperatures() {
+    request_t request{true, millis()};
+    // Reset + Skip ROM + Convert T: every probe converts simultaneously
+    native::spendMicros(960 + 2 * 8 * ONEWIRE_SLOT_US);
+
+    uint8_t resolution = 9;
+    for (uint8_t i = 0; i < probeCount(); i++) {
+        resolution = std::max(resolution, probeResolution(i));
+    }
+    ds18b20Hardware.conversionStartUs = native::clock().totalMicros();
+    ds18b20Hardware.conversionResolution = resolution;
+    ds18b20Hardware.conversionValid = true;
+
+    if (waitForConversion) {
+        blockTillConversionComplete(resolution);
+    }
+    return request;
+}
+
+DallasTemperature::request_t DallasTemperature::requestTemperaturesByAddress(const uint8_t* address) {
+    request_t request{false, millis()};
+    int index = probeIndexOf(address);
+    if (index < 0) {
+        return request;
+    }
+    // Reset + Match ROM + Convert T
+    native::spendMicros(960 + 10 * 8 * ONEWIRE_SLOT_US);
+    uint8_t resolution = probeResolution(static_cast<uint8_t>(index));
+    ds18b20Hardware.conversionStartUs = native::clock().totalMicros();
+    ds18b20Hardware.conversionResolution = resolution;
+    ds18b20Hardware.conversionValid = true;
+
+    if (waitForConversion) {
+        blockTillConversionComplete(resolution);
+    }
+    request.result = true;
+    return request;
+}
+
+DallasTemperature::request_t DallasTemperature::requestTemperaturesByIndex(uint8_t index) {
+    DeviceAddress address;
+    if (!getAddress(address, index)) {
+        return request_t{false, millis()};
+    }
+    return requestTemperaturesByAddress(address);
+}
+
+bool DallasTemperature::isConversionComplete() {
+    native::spendMicros(ONEWIRE_SLOT_US);
+    const Ds18b20Hardware& hw = ds18b20Hardware;
+    if (!hw.conversionValid) {
+        return true;
+    }
+    uint64_t elapsedMs = (native::clock().totalMicros() - hw.conversionStartUs) / 1000ULL;
+    return elapsedMs >= static_cast<uint64_t>(millisToWaitForConversion(hw.conversionResolution));
+}
+
+int16_t DallasTemperature::millisToWaitForConversion(uint8_t resolution) const {
+    switch (resolution) {
+        case 9:
+            return 94;
+        case 10:
+            return 188;
+        case 11:
+            return 375;
+        default:
+            return 750;
+    }
+}
+
+float DallasTemperature::getTempC(const uint8_t* address, uint8_t retryCount) {
+    (void)retryCount;
+    chargeScratchpadRead();
+    int index = probeIndexOf(address);
+    if (index < 0) {
+        return DEVICE_DISCONNECTED_C;
+    }
+
+    const Ds18b20Hardware& hw = ds18b20Hardware;
+    if (!hw.conversionValid) {
+        return 85.0f; // Power-on reset value of the temperature register
+    }
+
+    // Quantize to the probe's resolution like the real scratchpad does
+    float raw = native::simulation().ds18b20Temperature + 1.5f * index;
+    float step = 0.0625f * static_cast<float>(1 << (12 - probeResolution(static_cast<uint8_t>(index))));
+    return std::floor(raw / step) * step;
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index) {
+    DeviceAddress address;
+    if (!getAddress(address, index)) {
+        return DEVICE_DISCONNECTED_C;
+    }
+    return getTempC(address);
+}
+
+int DallasTemperature::probeIndexOf(const uint8_t* address) const {
+    for (uint8_t i = 0; i < probeCount(); i++) {
+        DeviceAddress candidate;
+        probeAddress(i, candidate);
+        if (std::memcmp(candidate, address, sizeof(DeviceAddress)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void DallasTemperature::blockTillConversionComplete(uint8_t resolution) {
+    if (checkForConversion && !isParasitePowerMode()) {
+        unsigned long start = millis();
+        while (!isConversionComplete() && (millis() - start) < 750UL) {
+            yield();
+        }
+    } else {
+        delay(millisToWaitForConversion(resolution));
+    }
+}
+
+// ========== SENSIRION SCD4X DRIVER ==========
+
+int16_t SensirionI2cScd4x::sendCommand(uint16_t command, uint32_t executionTimeMs) {
+    bus->beginTransmission(address);
+    bus->write(static_cast<uint8_t>(command >> 8));
+    bus->write(static_cast<uint8_t>(command & 0xFF));
+    uint8_t result = bus->endTransmission();
+    delay(executionTimeMs);
+    return result == 0 ? 0 : SCD4X_ERROR_NACK;
+}
+
+int16_t SensirionI2cScd4x::readWords(uint16_t command, uint32_t executionTimeMs, uint16_t* words, size_t count) {
+    int16_t error = sendCommand(command, executionTimeMs);
+    if (error != 0) {
+        return error;
+    }
+    size_t expected = count * 3;
+    if (bus->requestFrom(address, static_cast<uint8_t>(expected)) != expected) {
+        return SCD4X_ERROR_NOT_ENOUGH_DATA;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint8_t frame[3];
+        for (auto& byte : frame) {
+            byte = static_cast<uint8_t>(bus->read());
+        }
+        if (sensirionCrc(frame, 2) != frame[2]) {
+            return SCD4X_ERROR_CRC;
+        }
+        words[i] = static_cast<uint16_t>((frame[0] << 8) | frame[1]);
+    }
+    return 0;
+}
+
+int16_t SensirionI2cScd4x::startPeriodicMeasurement() {
+    return sendCommand(Scd4xDevice::CMD_START_PERIODIC, 1);
+}
+
+int16_t SensirionI2cScd4x::stopPeriodicMeasurement() {
+    return sendCommand(Scd4xDevice::CMD_STOP_PERIODIC, 500);
+}
+
+int16_t SensirionI2cScd4x::startLowPowerPeriodicMeasurement() {
+    return sendCommand(Scd4xDevice::CMD_START_LOW_POWER_PERIODIC, 1);
+}
+
+int16_t SensirionI2cScd4x::getDataReadyStatus(bool& dataReadyFlag) {
+    uint16_t status = 0;
+    int16_t error = readWords(Scd4xDevice::CMD_GET_DATA_READY, 1, &status, 1);
+    dataReadyFlag = error == 0 && (status & 0x07FF) != 0;
+    return error;
+}
+
+int16_t SensirionI2cScd4x::readMeasurement(uint16_t& co2Concentration, float& temperature,
+                                           float& relativeHumidity) {
+    uint16_t words[3];
+    int16_t error = readWords(Scd4xDevice::CMD_READ_MEASUREMENT, 1, words, 3);
+    if (error != 0) {
+        return error;
+    }
+    co2Concentration = words[0];
+    temperature = -45.0f + 175.0f * static_cast<float>(words[1]) / 65535.0f;
+    relativeHumidity = 100.0f * static_cast<float>(words[2]) / 65535.0f;
+    return 0;
+}
+
+int16_t SensirionI2cScd4x::measureSingleShot() {
+    return sendCommand(Scd4xDevice::CMD_SINGLE_SHOT, 5000);
+}
+
+int16_t SensirionI2cScd4x::measureSingleShotRhtOnly() {
+    return sendCommand(Scd4xDevice::CMD_SINGLE_SHOT_RHT_ONLY, 50);
+}
+
+int16_t SensirionI2cScd4x::powerDown() {
+    return sendCommand(Scd4xDevice::CMD_POWER_DOWN, 1);
+}
+
+int16_t SensirionI2cScd4x::wakeUp() {
+    // The sensor does not acknowledge wake_up; the driver ignores the result
+    sendCommand(Scd4xDevice::CMD_WAKE_UP, 30);
+    return 0;
+}
+
+int16_t SensirionI2cScd4x::reinit() {
+    return sendCommand(Scd4xDevice::CMD_REINIT, 30);
+}
+
+int16_t SensirionI2cScd4x::getSerialNumber(uint64_t& serialNumber) {
+    uint16_t words[3];
+    int16_t error = readWords(Scd4xDevice::CMD_GET_SERIAL_NUMBER, 1, words, 3);
+    if (error == 0) {
+        serialNumber = (static_cast<uint64_t>(words[0]) << 32) |
+                       (static_cast<uint64_t>(words[1]) << 16) | words[2];
+    }
+    return error;
+}
+
+void errorToString(int16_t error, char errorMessage[], size_t errorMessageSize) {
+    const char* text;
+    switch (error) {
+        case 0:
+            text = "No error";
+            break;
+        case SCD4X_ERROR_NACK:
+            text = "I2C address NACK";
+            break;
+        case SCD4X_ERROR_CRC:
+            text = "Wrong CRC found";
+            break;
+        case SCD4X_ERROR_NOT_ENOUGH_DATA:
+            text = "Not enough data received";
+            break;
+        default:
+            text = "Unknown error";
+            break;
+    }
+    snprintf(errorMessage, errorMessageSize, "%s", text);
+}
@@ -0,0 +1,185 @@
+#include "BusDiscoveryCache.h"
+#include <stddef.h>
+#include <string.h>
+#include <Preferences.h>
+#include <esp_system.h>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x42555343; // "BUSC"
+constexpr const char* NVS_KEY = "record";
+
+struct DiscoveryRecord {
+    uint32_t magic;
+    bool i2cScanned;
+    bool oneWireScanned;
+    bool oneWireParasite;
+    uint8_t oneWireCount;
+    uint8_t i2cPresent[16];     // One bit per 7-bit address
+    uint8_t oneWireRoms[Config::ONEWIRE_MAX_DEVICES][BusDiscoveryCache::ROM_SIZE];
+    uint32_t crc;               // Must stay last
+};
+
+// Survives deep sleep; zeroed by the bootloader on every other reset
+RTC_DATA_ATTR DiscoveryRecord record;
+
+// Plain static: false again after every wake
+bool loadedThisWake = false;
+
+uint32_t computeCrc(const DiscoveryRecord& candidate) {
+    return crc32(&candidate, offsetof(DiscoveryRecord, crc));
+}
+
+bool isValid(const DiscoveryRecord& candidate) {
+    return candidate.magic == CACHE_MAGIC && candidate.crc == computeCrc(candidate);
+}
+
+void resetRecord() {
+    record = DiscoveryRecord{};
+    record.magic = CACHE_MAGIC;
+}
+
+bool loadFromNvs() {
+    Preferences preferences;
+    if (!preferences.begin(Config::BUS_CACHE_NVS_NAMESPACE, true)) {
+        return false;
+    }
+    DiscoveryRecord stored{};
+    size_t length = preferences.getBytes(NVS_KEY, &stored, sizeof(stored));
+    preferences.end();
+
+    if (length != sizeof(stored) || !isValid(stored)) {
+        return false;
+    }
+    record = stored;
+    return true;
+}
+
+void saveToNvs() {
+    Preferences preferences;
+    if (!preferences.begin(Config::BUS_CACHE_NVS_NAMESPACE, false)) {
+        return;
+    }
+
+    // Only rewrite flash when the bus layout actually changed
+    DiscoveryRecord stored{};
+    size_t length = preferences.getBytes(NVS_KEY, &stored, sizeof(stored));
+    if (length != sizeof(stored) || memcmp(&stored, &record, sizeof(record)) != 0) {
+        if (preferences.putBytes(NVS_KEY, &record, sizeof(record)) != sizeof(record)) {
+            Serial.println("⚠ Failed to save bus discovery cache to NVS");
+        }
+    }
+    preferences.end();
+}
+
+void seal(bool persist) {
+    record.crc = computeCrc(record);
+    if (persist) {
+        saveToNvs();
+    }
+}
+
+void ensureLoaded() {
+    if (loadedThisWake) {
+        return;
+    }
+    loadedThisWake = true;
+
+    // Devices can only have been swapped with the power off: rescan
+    if (esp_reset_reason() == ESP_RST_POWERON) {
+        resetRecord();
+        seal(false);
+        return;
+    }
+
+    if (isValid(record)) {
+        return;
+    }
+
+    // A software, watchdog or brown-out reset cleared RTC memory but left the
+    // buses alone: fall back to the last layout in flash
+    if (loadFromNvs()) {
+        Serial.println("Bus discovery cache restored from NVS");
+        return;
+    }
+    resetRecord();
+    seal(false);
+}
+
+} // namespace
+
+bool BusDiscoveryCache::hasI2CScan() {
+    ensureLoaded();
+    return record.i2cScanned;
+}
+
+bool BusDiscoveryCache::isI2CDevicePresent(uint8_t address) {
+    ensureLoaded();
+    return record.i2cScanned && address < 128 &&
+           (record.i2cPresent[address / 8] & (1u << (address % 8))) != 0;
+}
+
+void BusDiscoveryCache::storeI2CScan(const uint8_t* addresses, size_t count) {
+    ensureLoaded();
+    memset(record.i2cPresent, 0, sizeof(record.i2cPresent));
+    for (size_t i = 0; i < count; i++) {
+        if (addresses[i] < 128) {
+            record.i2cPresent[addresses[i] / 8] |= static_cast<uint8_t>(1u << (addresses[i] % 8));
+        }
+    }
+    record.i2cScanned = true;
+    seal(true);
+}
+
+void BusDiscoveryCache::invalidateI2C() {
+    ensureLoaded();
+    record.i2cScanned = false;
+    seal(true); // A reset must not bring the rejected layout back
+}
+
+bool BusDiscoveryCache::hasOneWireScan() {
+    ensureLoaded();
+    return record.oneWireScanned;
+}
+
+uint8_t BusDiscoveryCache::getOneWireCount() {
+    ensureLoaded();
+    return record.oneWireScanned ? record.oneWireCount : 0;
+}
+
+bool BusDiscoveryCache::isOneWireParasite() {
+    ensureLoaded();
+    return record.oneWireParasite;
+}
+
+bool BusDiscoveryCache::getOneWireDevice(uint8_t index, uint8_t* rom) {
+    ensureLoaded();
+    if (!record.oneWireScanned || index >= record.oneWireCount) {
+        return false;
+    }
+    memcpy(rom, record.oneWireRoms[index], ROM_SIZE);
+    return true;
+}
+
+void BusDiscoveryCache::storeOneWireScan(const uint8_t (*roms)[ROM_SIZE], uint8_t count, bool parasite) {
+    ensureLoaded();
+    memset(record.oneWireRoms, 0, sizeof(record.oneWireRoms));
+    record.oneWireCount = std::min<uint8_t>(count, Config::ONEWIRE_MAX_DEVICES);
+    memcpy(record.oneWireRoms, roms, record.oneWireCount * ROM_SIZE);
+    record.oneWireParasite = parasite;
+    record.oneWireScanned = true;
+    seal(true);
+}
+
+void BusDiscoveryCache::invalidateOneWire() {
+    ensureLoaded();
+    record.oneWireScanned = false;
+    seal(true);
+}
+
+#ifdef NATIVE_BUILD
+void BusDiscoveryCache::reload() {
+    loadedThisWake = false;
+}
+#endif
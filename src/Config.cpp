@@ -5,10 +5,14 @@ String Config::DHT_LOCATION;
 String Config::DS18B20_LOCATION;
 String Config::SCD41_LOCATION;
 String Config::SUPABASE_TABLE_NAME;
+String Config::PROFILER_TABLE_NAME;
+String Config::AGGREGATE_TABLE_NAME;
 
 void Config::initialize() {
-    DHT_LOCATION = "alex-room";
-    DS18B20_LOCATION = "alex-outside";
-    SCD41_LOCATION = "alex-room";
-    SUPABASE_TABLE_NAME = "environment_measurements";
+    DHT_LOCATION = DEFAULT_DHT_LOCATION;
+    DS18B20_LOCATION = DEFAULT_DS18B20_LOCATION;
+    SCD41_LOCATION = DEFAULT_SCD41_LOCATION;
+    SUPABASE_TABLE_NAME = DEFAULT_SUPABASE_TABLE_NAME;
+    PROFILER_TABLE_NAME = DEFAULT_PROFILER_TABLE_NAME;
+    AGGREGATE_TABLE_NAME = DEFAULT_AGGREGATE_TABLE_NAME;
 }
\ No newline at end of file
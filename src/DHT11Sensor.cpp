@@ -1,7 +1,8 @@
 #include "DHT11Sensor.h"
 
-DHT11Sensor::DHT11Sensor(const String& location) 
-    : location(location), dht(Config::DHT_PIN, DHT11), lastReadTime(0) {
+DHT11Sensor::DHT11Sensor(const char* location) 
+    : location(location), dht(Config::DHT_PIN, DHT11), lastReadTime(0),
+      acquisitionStartTime(0), acquisitionPending(false) {
 }
 
 bool DHT11Sensor::initialize() {
@@ -10,12 +11,12 @@ bool DHT11Sensor::initialize() {
     try {
         dht.begin();
         initialized = true;
-        lastError = "";
+        clearError();
         
-        Serial.printf("✓ DHT11 sensor initialized at location: %s\n", location.c_str());
+        Serial.printf("✓ DHT11 sensor initialized at location: %s\n", location);
         return true;
     } catch (const std::exception& e) {
-        setError("DHT11 initialization failed: " + String(e.what()));
+        setError(ErrorCode::DEVICE_NOT_FOUND, "DHT11 initialization failed: %s", e.what());
         initialized = false;
         return false;
     }
@@ -31,24 +32,38 @@ bool DHT11Sensor::isReady() const {
     return (currentTime - lastReadTime) >= MIN_READ_INTERVAL_MS;
 }
 
-bool DHT11Sensor::readSensor(std::vector<Reading>& readings) {
-    readings.clear();
-    
+bool DHT11Sensor::startReading() {
     if (!initialized) {
-        setError("DHT11 not initialized");
+        setError(ErrorCode::NOT_INITIALIZED, "DHT11 not initialized");
         return false;
     }
     
-    if (!isReady()) {
-        setError("DHT11 not ready for reading (minimum interval not met)");
+    // Stabilization time runs from here; the read itself happens in collectReading()
+    acquisitionStartTime = millis();
+    acquisitionPending = true;
+    return true;
+}
+
+bool DHT11Sensor::isReadingComplete() {
+    if (!acquisitionPending) {
+        return true;
+    }
+    
+    // Wait for stabilization and the minimum interval between readings
+    return isReady() && (millis() - acquisitionStartTime) >= Config::DHT_STABILIZATION_DELAY_MS;
+}
+
+bool DHT11Sensor::collectReading(Readings& readings) {
+    readings.clear();
+    
+    if (!acquisitionPending) {
+        setError(ErrorCode::NOT_STARTED, "DHT11 reading not started");
         return false;
     }
+    acquisitionPending = false;
     
     Serial.println("Reading DHT11 sensor...");
     
-    // Allow stabilization time
-    delay(Config::DHT_STABILIZATION_DELAY_MS);
-    
     float humidity = dht.readHumidity();
     float temperature = dht.readTemperature();
     
@@ -59,33 +74,27 @@ bool DHT11Sensor::readSensor(std::vector<Reading>& readings) {
     bool humidValid = isValidReading(humidity);
     
     if (!tempValid && !humidValid) {
-        setError("DHT11 failed to read both temperature and humidity");
+        setError(ErrorCode::COMMUNICATION, "DHT11 failed to read both temperature and humidity");
         return false;
     }
     
     // Add temperature reading
     if (tempValid) {
-        Reading tempReading(temperature, Status::SUCCESS);
+        Reading tempReading(MeasurementKind::TEMPERATURE, temperature);
         readings.push_back(tempReading);
         Serial.printf("✓ DHT11 Temperature: %.1f°C\n", temperature);
     } else {
-        Reading tempReading;
-        tempReading.status = Status::INVALID_DATA;
-        tempReading.errorMessage = "Invalid temperature reading";
-        readings.push_back(tempReading);
+        readings.push_back(Reading::failed(MeasurementKind::TEMPERATURE, Status::INVALID_DATA, ErrorCode::INVALID_DATA));
         Serial.println("✗ DHT11 Temperature: Invalid reading");
     }
     
     // Add humidity reading
     if (humidValid) {
-        Reading humidReading(humidity, Status::SUCCESS);
+        Reading humidReading(MeasurementKind::HUMIDITY, humidity);
         readings.push_back(humidReading);
         Serial.printf("✓ DHT11 Humidity: %.1f%%\n", humidity);
     } else {
-        Reading humidReading;
-        humidReading.status = Status::INVALID_DATA;
-        humidReading.errorMessage = "Invalid humidity reading";
-        readings.push_back(humidReading);
+        readings.push_back(Reading::failed(MeasurementKind::HUMIDITY, Status::INVALID_DATA, ErrorCode::INVALID_DATA));
         Serial.println("✗ DHT11 Humidity: Invalid reading");
     }
     
@@ -0,0 +1,280 @@
+#include "DS18B20Bus.h"
+#include "BusDiscoveryCache.h"
+
+namespace {
+
+constexpr uint32_t ADAPTIVE_MAGIC = 0x44534152; // "DSAR"
+
+static_assert(Config::ONEWIRE_MAX_DEVICES <= 8, "probe masks are 8 bits wide");
+
+struct AdaptiveState {
+    uint32_t magic;
+    uint8_t probeResolution;    // Resolution in the probes' scratchpads, 0 if unknown
+    uint8_t referenceMask;      // Probes with a full-resolution reference reading
+    int16_t reference[Config::ONEWIRE_MAX_DEVICES];    // Last full-resolution reading, 1/16 °C
+};
+
+// Survives deep sleep; zeroed on power-on (probes then load the EEPROM default)
+RTC_DATA_ATTR AdaptiveState adaptiveState;
+
+void resetAdaptiveState(uint8_t probeResolution) {
+    adaptiveState = AdaptiveState{};
+    adaptiveState.magic = ADAPTIVE_MAGIC;
+    adaptiveState.probeResolution = probeResolution;
+}
+
+// 1/16 °C is the 12-bit step, so a full-resolution reading is kept exactly
+float fromSixteenths(int16_t value) {
+    return value / 16.0f;
+}
+
+int16_t toSixteenths(float temperature) {
+    return static_cast<int16_t>(lroundf(temperature * 16.0f));
+}
+
+} // namespace
+
+DS18B20Bus::DS18B20Bus(uint8_t pin, uint8_t resolution, Config::DS18B20ResolutionMode mode)
+    : oneWire(pin), dallas(&oneWire), resolution(resolution), mode(mode), roms{}, temperatures{},
+      deviceCount(0), parasitePower(false), started(false), phase(Phase::IDLE), requestedMask(0),
+      readMask(0), conversionResolution(resolution), conversionStartTime(0), lastError("") {
+}
+
+bool DS18B20Bus::begin() {
+    if (started) {
+        return deviceCount > 0;
+    }
+    started = true;
+
+    // Parasite-powered buses need begin() to set up the strong pullup
+    if (BusDiscoveryCache::hasOneWireScan() && !BusDiscoveryCache::isOneWireParasite()) {
+        deviceCount = BusDiscoveryCache::getOneWireCount();
+        for (uint8_t i = 0; i < deviceCount; i++) {
+            BusDiscoveryCache::getOneWireDevice(i, roms[i]);
+        }
+        Serial.printf("DS18B20 devices cached: %d\n", deviceCount);
+
+        if (adaptiveState.magic != ADAPTIVE_MAGIC) {
+            resetAdaptiveState(0); // Scratchpad resolution unknown
+        }
+    } else if (!enumerateDevices()) {
+        deviceCount = 0;
+        return false;
+    }
+
+    if (deviceCount == 0) {
+        lastError = "No DS18B20 devices found. Check wiring and pullup resistor.";
+        BusDiscoveryCache::invalidateOneWire();
+        return false;
+    }
+
+    // Conversions are started and collected separately (see requestConversion);
+    // adaptive resolution changes must not be copied to EEPROM
+    dallas.setWaitForConversion(false);
+    dallas.setAutoSaveScratchPad(false);
+    lastError = "";
+    return true;
+}
+
+bool DS18B20Bus::enumerateDevices() {
+    dallas.begin();
+
+    uint8_t found = dallas.getDeviceCount();
+    parasitePower = dallas.isParasitePowerMode();
+    Serial.printf("DS18B20 devices found: %d\n", found);
+    Serial.printf("DS18B20 parasite power: %s\n", parasitePower ? "ON" : "OFF");
+
+    if (found > Config::ONEWIRE_MAX_DEVICES) {
+        Serial.printf("⚠ Only the first %d DS18B20 devices are used\n", Config::ONEWIRE_MAX_DEVICES);
+    }
+    deviceCount = std::min<uint8_t>(found, Config::ONEWIRE_MAX_DEVICES);
+
+    // The full resolution is the probes' EEPROM default, so this is only
+    // written when a new probe shows up
+    dallas.setAutoSaveScratchPad(true);
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (!dallas.getAddress(roms[i], i)) {
+            lastError = "Failed to read DS18B20 ROM code";
+            return false;
+        }
+
+        if (dallas.getResolution(roms[i]) != resolution) {
+            dallas.setResolution(roms[i], resolution, true);
+        }
+    }
+
+    // Probe order may have changed: drop the reference readings
+    resetAdaptiveState(resolution);
+
+    BusDiscoveryCache::storeOneWireScan(roms, deviceCount, parasitePower);
+    return true;
+}
+
+bool DS18B20Bus::requestConversion(uint8_t index) {
+    if (index >= deviceCount) {
+        return false;
+    }
+
+    requestedMask |= static_cast<uint8_t>(1u << index);
+    if (phase == Phase::IDLE) {
+        startConversion(chooseResolution());
+    }
+    return true;
+}
+
+uint8_t DS18B20Bus::chooseResolution() const {
+    if (mode == Config::DS18B20ResolutionMode::FIXED) {
+        return resolution;
+    }
+
+    // Without a reference reading there is nothing to compare against
+    if ((adaptiveState.referenceMask & requestedMask) != requestedMask) {
+        return resolution;
+    }
+    return std::min(Config::DS18B20_FAST_RESOLUTION, resolution);
+}
+
+void DS18B20Bus::startConversion(uint8_t bits) {
+    applyResolution(bits);
+
+    // Skip ROM + Convert T: every probe on the bus converts at once
+    dallas.requestTemperatures();
+    conversionStartTime = millis();
+    conversionResolution = bits;
+    readMask = 0;
+    phase = Phase::CONVERTING;
+}
+
+void DS18B20Bus::applyResolution(uint8_t bits) {
+    // A broadcast conversion takes as long as the slowest probe, so all
+    // probes on the bus are switched together
+    if (adaptiveState.probeResolution == bits) {
+        return;
+    }
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        dallas.setResolution(roms[i], bits, true);
+    }
+    adaptiveState.probeResolution = bits;
+}
+
+bool DS18B20Bus::poll() {
+    if (phase != Phase::CONVERTING) {
+        return true;
+    }
+    if ((millis() - conversionStartTime) < getConversionTimeMs(conversionResolution)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (requestedMask & (1u << i)) {
+            readTemperature(i);
+        }
+    }
+
+    if (conversionResolution < resolution) {
+        for (uint8_t i = 0; i < deviceCount; i++) {
+            if ((requestedMask & (1u << i)) && needsFullResolution(i)) {
+                Serial.printf("DS18B20 device %d moving or near an alert, converting at %d-bit\n",
+                             i, resolution);
+                startConversion(resolution);
+                return false;
+            }
+        }
+        useReferences();
+    } else {
+        updateReferences();
+    }
+
+    phase = Phase::DONE;
+    return true;
+}
+
+bool DS18B20Bus::needsFullResolution(uint8_t index) const {
+    float temperature = temperatures[index];
+    if (!isValidTemperature(temperature)) {
+        return false; // Reported as a failure; a slower conversion will not help
+    }
+    if (!(adaptiveState.referenceMask & (1u << index))) {
+        return true;
+    }
+
+    // Allow for the fast reading's coarser quantization on top of the drift
+    float step = 0.0625f * static_cast<float>(1u << (12 - conversionResolution));
+    float drift = fabsf(temperature - fromSixteenths(adaptiveState.reference[index]));
+    if (drift > Config::DS18B20_STABLE_DELTA_C + step) {
+        return true;
+    }
+
+    return fabsf(temperature - Config::DS18B20_ALERT_LOW_C) <= Config::DS18B20_ALERT_MARGIN_C ||
+           fabsf(temperature - Config::DS18B20_ALERT_HIGH_C) <= Config::DS18B20_ALERT_MARGIN_C;
+}
+
+void DS18B20Bus::updateReferences() {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if ((readMask & bit) && isValidTemperature(temperatures[i])) {
+            adaptiveState.reference[i] = toSixteenths(temperatures[i]);
+            adaptiveState.referenceMask |= bit;
+        }
+    }
+}
+
+void DS18B20Bus::useReferences() {
+    // A fast reading is only good for spotting drift: handing it out would
+    // publish its rounding (8.25 °C read as 8.00 °C) as a change
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if ((requestedMask & bit) && isValidTemperature(temperatures[i])) {
+            temperatures[i] = fromSixteenths(adaptiveState.reference[i]);
+        }
+    }
+}
+
+bool DS18B20Bus::isConversionComplete() const {
+    return phase != Phase::CONVERTING;
+}
+
+float DS18B20Bus::readTemperature(uint8_t index) {
+    if (index >= deviceCount) {
+        return DEVICE_DISCONNECTED_C;
+    }
+
+    uint8_t bit = static_cast<uint8_t>(1u << index);
+    if (!(readMask & bit)) {
+        temperatures[index] = dallas.getTempC(roms[index]);
+        readMask |= bit;
+    }
+    return temperatures[index];
+}
+
+void DS18B20Bus::releaseConversion(uint8_t index) {
+    requestedMask &= static_cast<uint8_t>(~(1u << index));
+    if (requestedMask == 0 && phase == Phase::DONE) {
+        phase = Phase::IDLE;
+    }
+}
+
+void DS18B20Bus::invalidate() {
+    BusDiscoveryCache::invalidateOneWire();
+}
+
+uint32_t DS18B20Bus::getConversionTimeMs(uint8_t resolution) {
+    // Datasheet maximum tCONV: 93.75 ms at 9 bits, doubling with every extra bit
+    switch (resolution) {
+        case 9:
+            return 94;
+        case 10:
+            return 188;
+        case 11:
+            return 375;
+        default:
+            return 750;
+    }
+}
+
+bool DS18B20Bus::isValidTemperature(float temperature) {
+    return temperature != DEVICE_DISCONNECTED_C &&
+           !isnan(temperature) &&
+           isfinite(temperature) &&
+           temperature > -55.0f && temperature < 125.0f; // DS18B20 valid range
+}
@@ -1,42 +1,35 @@
 #include "DS18B20Sensor.h"
 
-DS18B20Sensor::DS18B20Sensor(const String& location, uint8_t deviceIndex) 
-    : location(location), deviceIndex(deviceIndex), oneWire(Config::DS18B20_PIN), 
-      dallas(&oneWire), lastConversionTime(0) {
+DS18B20Sensor::DS18B20Sensor(DS18B20Bus& bus, const char* location, uint8_t deviceIndex) 
+    : bus(bus), location(location), deviceIndex(deviceIndex), conversionPending(false) {
 }
 
 bool DS18B20Sensor::initialize() {
     Serial.println("Initializing DS18B20 sensor...");
     
     try {
-        dallas.begin();
-        
-        uint8_t deviceCount = dallas.getDeviceCount();
-        Serial.printf("DS18B20 devices found: %d\n", deviceCount);
-        
-        if (deviceCount == 0) {
-            setError("No DS18B20 devices found. Check wiring and pullup resistor.");
+        if (!bus.begin()) {
+            setError(ErrorCode::DEVICE_NOT_FOUND, "%s", bus.getLastError());
             initialized = false;
             return false;
         }
         
+        uint8_t deviceCount = bus.getDeviceCount();
         if (deviceIndex >= deviceCount) {
-            setError("Device index " + String(deviceIndex) + " exceeds available devices (" + String(deviceCount) + ")");
+            setError(ErrorCode::DEVICE_NOT_FOUND, "Device index %d exceeds available devices (%d)",
+                     deviceIndex, deviceCount);
             initialized = false;
             return false;
         }
         
-        Serial.printf("DS18B20 parasite power: %s\n", 
-                     dallas.isParasitePowerMode() ? "ON" : "OFF");
-        
         initialized = true;
-        lastError = "";
+        clearError();
         
         Serial.printf("✓ DS18B20 sensor initialized at location: %s (device %d)\n", 
-                     location.c_str(), deviceIndex);
+                     location, deviceIndex);
         return true;
     } catch (const std::exception& e) {
-        setError("DS18B20 initialization failed: " + String(e.what()));
+        setError(ErrorCode::DEVICE_NOT_FOUND, "DS18B20 initialization failed: %s", e.what());
         initialized = false;
         return false;
     }
@@ -47,44 +40,59 @@ bool DS18B20Sensor::isReady() const {
         return false;
     }
     
-    // Check if enough time has passed since last conversion
-    unsigned long currentTime = millis();
-    return (currentTime - lastConversionTime) >= Config::DS18B20_CONVERSION_DELAY_MS;
+    return !conversionPending || bus.isConversionComplete();
 }
 
-bool DS18B20Sensor::readSensor(std::vector<Reading>& readings) {
-    readings.clear();
-    
+bool DS18B20Sensor::startReading() {
     if (!initialized) {
-        setError("DS18B20 not initialized");
+        setError(ErrorCode::NOT_INITIALIZED, "DS18B20 not initialized");
         return false;
     }
     
-    Serial.println("Reading DS18B20 sensor...");
+    // Joins a conversion already started by another probe on the bus
+    if (!conversionPending) {
+        if (!bus.requestConversion(deviceIndex)) {
+            setError(ErrorCode::COMMUNICATION, "DS18B20 conversion could not be started");
+            return false;
+        }
+        conversionPending = true;
+    }
+    return true;
+}
+
+bool DS18B20Sensor::isReadingComplete() {
+    if (!conversionPending) {
+        return true;
+    }
+    return bus.poll();
+}
+
+bool DS18B20Sensor::collectReading(Readings& readings) {
+    readings.clear();
     
-    // Request temperature conversion
-    dallas.requestTemperatures();
-    lastConversionTime = millis();
+    if (!conversionPending) {
+        setError(ErrorCode::NOT_STARTED, "DS18B20 conversion not started");
+        return false;
+    }
+    conversionPending = false;
     
-    // Wait for conversion to complete
-    delay(Config::DS18B20_CONVERSION_DELAY_MS);
+    Serial.println("Reading DS18B20 sensor...");
     
-    float temperature = dallas.getTempCByIndex(deviceIndex);
+    float temperature = bus.readTemperature(deviceIndex);
+    bus.releaseConversion(deviceIndex);
     
-    if (!isValidTemperature(temperature)) {
-        setError("DS18B20 returned invalid temperature: " + String(temperature));
+    if (!DS18B20Bus::isValidTemperature(temperature)) {
+        setError(ErrorCode::INVALID_DATA, "DS18B20 returned invalid temperature: %.2f", temperature);
+        bus.invalidate(); // Re-enumerate on the next wake
         
-        Reading failedReading;
-        failedReading.status = Status::INVALID_DATA;
-        failedReading.errorMessage = lastError;
-        readings.push_back(failedReading);
+        readings.push_back(Reading::failed(MeasurementKind::TEMPERATURE, Status::INVALID_DATA, ErrorCode::INVALID_DATA));
         return false;
     }
     
-    Reading tempReading(temperature, Status::SUCCESS);
+    Reading tempReading(MeasurementKind::TEMPERATURE, temperature);
     readings.push_back(tempReading);
     
-    Serial.printf("✓ DS18B20 Temperature: %.1f°C\n", temperature);
+    Serial.printf("✓ DS18B20 Temperature: %.1f°C (%d-bit)\n", temperature, bus.getResolution());
     return true;
 }
 
@@ -92,20 +100,12 @@ uint8_t DS18B20Sensor::getDeviceCount() {
     if (!initialized) {
         return 0;
     }
-    return dallas.getDeviceCount();
+    return bus.getDeviceCount();
 }
 
 bool DS18B20Sensor::isParasitePowerMode() {
     if (!initialized) {
         return false;
     }
-    return dallas.isParasitePowerMode();
+    return bus.isParasitePowerMode();
 }
-
-bool DS18B20Sensor::isValidTemperature(float temperature) const {
-    return temperature != DEVICE_DISCONNECTED_C && 
-           temperature != INVALID_TEMPERATURE &&
-           !isnan(temperature) && 
-           isfinite(temperature) &&
-           temperature > -55.0f && temperature < 125.0f; // DS18B20 valid range
-}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "DeadbandFilter.h"
+#include <stddef.h>
+#include <algorithm>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint32_t FILTER_MAGIC = 0x44424E44; // "DBND"
+constexpr size_t MAX_STREAMS = 12;
+
+struct Stream {
+    uint32_t locationHash;  // CRC32 of the location name
+    uint32_t lastTime;      // ReadingBuffer clock of the last value passed on
+    float lastValue;
+    uint8_t kind;           // MeasurementKind
+    bool used;
+};
+
+struct FilterState {
+    uint32_t magic;
+    uint8_t streamCount;
+    Stream streams[MAX_STREAMS];
+    uint32_t crc;           // Must stay last
+};
+
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR FilterState state;
+
+uint32_t computeCrc() {
+    return crc32(&state, offsetof(FilterState, crc));
+}
+
+bool isValid() {
+    return state.magic == FILTER_MAGIC && state.crc == computeCrc();
+}
+
+Stream* findStream(uint32_t locationHash, MeasurementKind kind) {
+    for (size_t i = 0; i < state.streamCount; i++) {
+        Stream& stream = state.streams[i];
+        if (stream.locationHash == locationHash && stream.kind == static_cast<uint8_t>(kind)) {
+            return &stream;
+        }
+    }
+    if (state.streamCount == MAX_STREAMS) {
+        return nullptr;
+    }
+    Stream& stream = state.streams[state.streamCount++];
+    stream.locationHash = locationHash;
+    stream.kind = static_cast<uint8_t>(kind);
+    return &stream;
+}
+
+bool passes(const IDataPublisher::DataPoint& point, uint32_t clockNow) {
+    uint32_t locationHash = crc32(point.location, strlen(point.location));
+    Stream* stream = findStream(locationHash, point.kind);
+    if (stream == nullptr) {
+        return true; // Untracked streams are never suppressed
+    }
+
+    bool pass = !stream->used ||
+                fabsf(point.value - stream->lastValue) >= DeadbandFilter::getDeadband(point.kind) ||
+                clockNow - stream->lastTime >= Config::DEADBAND_MAX_SILENCE_SECONDS;
+    if (pass) {
+        stream->used = true;
+        stream->lastValue = point.value;
+        stream->lastTime = clockNow;
+    }
+    return pass;
+}
+
+} // namespace
+
+size_t DeadbandFilter::apply(std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow) {
+    if (!isValid()) {
+        state = FilterState{};
+        state.magic = FILTER_MAGIC;
+    }
+
+    size_t before = points.size();
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [clockNow](const IDataPublisher::DataPoint& point) {
+                                    return !passes(point, clockNow);
+                                }),
+                 points.end());
+    state.crc = computeCrc();
+
+    size_t removed = before - points.size();
+    if (removed > 0) {
+        Serial.printf("Deadband: %d/%d data points unchanged, not buffered\n", (int)removed, (int)before);
+    }
+    return removed;
+}
+
+bool DeadbandFilter::isHeartbeatDue(uint32_t clockNow) {
+    if (!isValid() || state.streamCount == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < state.streamCount; i++) {
+        const Stream& stream = state.streams[i];
+        if (!stream.used || clockNow - stream.lastTime >= Config::DEADBAND_MAX_SILENCE_SECONDS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float DeadbandFilter::getDeadband(MeasurementKind kind) {
+    switch (kind) {
+        case MeasurementKind::TEMPERATURE: return Config::DEADBAND_TEMPERATURE_C;
+        case MeasurementKind::HUMIDITY:    return Config::DEADBAND_HUMIDITY_PERCENT;
+        case MeasurementKind::CO2:         return Config::DEADBAND_CO2_PPM;
+        default:                           return 0.0f;
+    }
+}
@@ -0,0 +1,110 @@
+#include "FanOutPublisher.h"
+
+FanOutPublisher::FanOutPublisher() : backendCount(0), initialized(false) {
+}
+
+bool FanOutPublisher::addBackend(IDataPublisher& backend) {
+    if (initialized || backendCount == Config::FANOUT_MAX_BACKENDS) {
+        return false;
+    }
+    backends[backendCount].publisher = &backend;
+    backendCount++;
+    return true;
+}
+
+bool FanOutPublisher::initialize() {
+    if (backendCount == 0) {
+        setError("No publishing backends configured");
+        return false;
+    }
+    initialized = true;
+
+    // A backend that fails here is skipped for the rest of the wake
+    bool anyReady = false;
+    for (size_t i = 0; i < backendCount; i++) {
+        IDataPublisher& backend = *backends[i].publisher;
+        backends[i].enabled = backend.initialize();
+        if (backends[i].enabled) {
+            anyReady = true;
+        } else {
+            Serial.printf("⚠ %s initialization failed: %s\n",
+                         backend.getName().c_str(), backend.getLastError().c_str());
+        }
+    }
+
+    if (!anyReady) {
+        setError("No publishing backend is ready");
+        return false;
+    }
+    lastError = "";
+    return true;
+}
+
+bool FanOutPublisher::isReady() const {
+    for (size_t i = 0; i < backendCount; i++) {
+        if (backends[i].enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+IDataPublisher::PublishResult FanOutPublisher::publish(const String& location, const String& type, float value) {
+    PublishResult result;
+    MeasurementKind kind;
+    if (!measurementKindFromName(type.c_str(), kind)) {
+        result.errorMessage = "Unknown measurement type: " + type;
+        setError(result.errorMessage);
+        return result;
+    }
+
+    std::vector<DataPoint> points;
+    points.emplace_back(location.c_str(), kind, value);
+    result.success = publishCycle(points) == 1;
+    if (!result.success) {
+        result.errorMessage = "Primary backend did not store the reading";
+    }
+    return result;
+}
+
+int FanOutPublisher::publishBatch(const String& sensorName, const String& location,
+                                  const ISensor::Readings& readings) {
+    std::vector<DataPoint> points;
+    appendDataPoints(points, location.c_str(), readings);
+
+    int successCount = publishCycle(points);
+    Serial.printf("Published %d/%d readings from %s sensor\n",
+                 successCount, (int)readings.size(), sensorName.c_str());
+    return successCount;
+}
+
+int FanOutPublisher::publishCycle(std::vector<DataPoint>& points) {
+    if (points.empty() || backendCount == 0) {
+        return 0;
+    }
+
+    // Primary last, so the published flags it leaves are the ones returned
+    int primaryDelivered = 0;
+    for (size_t n = backendCount; n-- > 0;) {
+        Backend& backend = backends[n];
+        if (!backend.enabled) {
+            continue;
+        }
+        int delivered = backend.publisher->publishCycle(points);
+        backend.delivered += static_cast<uint32_t>(delivered);
+        if (n == 0) {
+            primaryDelivered = delivered;
+        } else if (delivered < (int)points.size()) {
+            Serial.printf("⚠ %s published %d/%d data points: %s\n",
+                         backend.publisher->getName().c_str(), delivered, (int)points.size(),
+                         backend.publisher->getLastError().c_str());
+        }
+    }
+
+    if (!backends[0].enabled) {
+        for (auto& point : points) {
+            point.published = false;
+        }
+    }
+    return primaryDelivered;
+}
@@ -0,0 +1,78 @@
+#include "LatestReadingClient.h"
+#include <ArduinoJson.h>
+
+namespace {
+
+/**
+ * @brief Encode a timestamp for use in a query string
+ *
+ * created_at comes back with a "+00:00" offset, and a bare '+' in a query
+ * string is read as a space.
+ */
+String encodeTimestamp(const char* timestamp) {
+    String encoded;
+    encoded.reserve(strlen(timestamp) + 4);
+    for (const char* c = timestamp; *c != '\0'; c++) {
+        if (*c == '+') {
+            encoded += "%2B";
+        } else {
+            encoded += *c;
+        }
+    }
+    return encoded;
+}
+
+} // namespace
+
+LatestReadingClient::LatestReadingClient(Supabase& supabase, const char* table, const char* location,
+                                         const char* type)
+    : supabase(supabase), table(table), location(location), type(type), value(0.0f) {
+    newestCreatedAt[0] = '\0';
+}
+
+LatestReadingClient::Result LatestReadingClient::poll() {
+    supabase.from(table)
+        .select("value,created_at")
+        .eq("location", location)
+        .eq("type", type);
+    if (hasValue()) {
+        supabase.gt("created_at", encodeTimestamp(newestCreatedAt));
+    }
+    String response = supabase.order("created_at", "desc", false)
+                          .limit(1)
+                          .doSelect();
+
+    if (response.length() == 0 || response.startsWith("error")) {
+        Serial.println("Empty or error response from Supabase");
+        return Result::FAILED;
+    }
+
+    // The common case: nothing stored since the last poll
+    response.trim();
+    if (response == "[]") {
+        return Result::UNCHANGED;
+    }
+
+    JsonDocument filter;
+    filter[0]["value"] = true;
+    filter[0]["created_at"] = true;
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, response, DeserializationOption::Filter(filter));
+    if (error) {
+        Serial.printf("JSON parsing error: %s\n", error.c_str());
+        return Result::FAILED;
+    }
+
+    JsonObjectConst row = doc[0];
+    const char* createdAt = row["created_at"];
+    if (row.isNull() || !row["value"].is<float>() || createdAt == nullptr) {
+        Serial.println("No 'value' or 'created_at' field in response");
+        return Result::FAILED;
+    }
+
+    value = row["value"].as<float>();
+    strncpy(newestCreatedAt, createdAt, CREATED_AT_SIZE - 1);
+    newestCreatedAt[CREATED_AT_SIZE - 1] = '\0';
+    return Result::UPDATED;
+}
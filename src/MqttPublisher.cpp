@@ -0,0 +1,244 @@
+#include "MqttPublisher.h"
+
+namespace {
+constexpr const char* STATUS_ONLINE = "online";
+constexpr const char* STATUS_OFFLINE = "offline";
+constexpr size_t BATCH_SUFFIX_LENGTH = 2; // "]}"
+}
+
+MqttPublisher::MqttPublisher(const char* server, uint16_t port, const char* user, const char* password,
+                             const char* deviceId)
+    : server(server), port(port), user(user), password(password), deviceId(deviceId),
+      client(wifiClient), initialized(false), reconnectFailed(false), lastReconnectAttempt(0),
+      payload{}, payloadLength(0), entryCount(0) {
+    snprintf(readingsTopic, sizeof(readingsTopic), "%s/%s/readings", Config::MQTT_TOPIC_PREFIX, deviceId);
+    snprintf(statusTopic, sizeof(statusTopic), "%s/%s/status", Config::MQTT_TOPIC_PREFIX, deviceId);
+}
+
+bool MqttPublisher::initialize() {
+    Serial.println("Initializing MQTT publisher...");
+
+    if (server == nullptr || server[0] == '\0') {
+        setError("MQTT server is empty");
+        return false;
+    }
+
+    if (!initialized) {
+        client.setServer(server, port);
+        client.setKeepAlive(Config::MQTT_KEEPALIVE_SECONDS);
+        client.setSocketTimeout(Config::MQTT_SOCKET_TIMEOUT_SECONDS);
+        if (!client.setBufferSize(Config::MQTT_BUFFER_SIZE)) {
+            setError("Failed to allocate MQTT buffer");
+            return false;
+        }
+        initialized = true;
+    }
+
+    if (!connect()) {
+        return false;
+    }
+
+    Serial.printf("✓ MQTT publisher initialized\n");
+    Serial.printf("  Broker: %s:%u\n", server, port);
+    Serial.printf("  Topic: %s\n", readingsTopic);
+    return true;
+}
+
+bool MqttPublisher::isReady() const {
+    return initialized && client.connected();
+}
+
+bool MqttPublisher::connect() {
+    if (client.connected()) {
+        return true;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        setError("WiFi not connected - cannot reach MQTT broker");
+        return false;
+    }
+
+    // Don't stall every publish while the broker is down
+    if (reconnectFailed && millis() - lastReconnectAttempt < Config::MQTT_RECONNECT_INTERVAL_MS) {
+        return false;
+    }
+
+    unsigned long startTime = millis();
+    uint32_t attemptCostMs = Config::MQTT_SOCKET_TIMEOUT_SECONDS * 1000u;
+    do {
+        if (client.connect(deviceId, user, password, statusTopic, 1, true, STATUS_OFFLINE)) {
+            client.publish(statusTopic, STATUS_ONLINE, true);
+            reconnectFailed = false;
+            lastError = "";
+            Serial.printf("✓ MQTT connected in %lu ms\n", millis() - startTime);
+            return true;
+        }
+        delay(Config::MQTT_RETRY_DELAY_MS);
+    } while (millis() - startTime + attemptCostMs <= Config::MQTT_CONNECT_BUDGET_MS);
+
+    reconnectFailed = true;
+    lastReconnectAttempt = millis();
+    setError("MQTT connection failed, state " + String(client.state()));
+    return false;
+}
+
+bool MqttPublisher::loop() {
+    if (!initialized) {
+        return false;
+    }
+    return client.loop() || connect();
+}
+
+void MqttPublisher::disconnect() {
+    if (client.connected()) {
+        client.publish(statusTopic, STATUS_OFFLINE, true);
+        client.disconnect();
+    }
+}
+
+IDataPublisher::PublishResult MqttPublisher::publish(const String& location, const String& type, float value) {
+    PublishResult result;
+
+    if (!initialized || !connect()) {
+        result.errorMessage = "Publisher not ready (broker unreachable or not initialized)";
+        setError(result.errorMessage);
+        return result;
+    }
+
+    // Latest value per location and type, retained for new subscribers
+    char topic[TOPIC_SIZE];
+    snprintf(topic, sizeof(topic), "%s/%s/%s/%s", Config::MQTT_TOPIC_PREFIX, deviceId,
+             location.c_str(), type.c_str());
+    char text[16];
+    snprintf(text, sizeof(text), "%.2f", value);
+
+    result.success = client.publish(topic, text, true);
+    if (!result.success) {
+        result.errorMessage = "MQTT publish failed";
+        setError(result.errorMessage);
+    }
+    return result;
+}
+
+int MqttPublisher::publishBatch(const String& sensorName, const String& location,
+                                const ISensor::Readings& readings) {
+    if (!initialized || !connect()) {
+        setError("Publisher not ready (broker unreachable or not initialized)");
+        return 0;
+    }
+
+    beginBatch(sensorName.c_str());
+    for (const auto& reading : readings) {
+        if (reading.status != ISensor::Status::SUCCESS) {
+            Serial.printf("⚠ Skipping invalid %s reading: %s\n",
+                         measurementName(reading.kind), ISensor::errorCodeName(reading.error));
+            continue;
+        }
+        if (!appendEntry(location.c_str(), measurementName(reading.kind), reading.value, 0)) {
+            setError("Readings do not fit in one MQTT message");
+            return 0;
+        }
+    }
+
+    if (entryCount == 0) {
+        return 0;
+    }
+    size_t published = entryCount;
+    return sendBatch() ? static_cast<int>(published) : 0;
+}
+
+int MqttPublisher::publishCycle(std::vector<DataPoint>& points) {
+    for (auto& point : points) {
+        point.published = false;
+    }
+    if (!initialized || !connect()) {
+        setError("Publisher not ready (broker unreachable or not initialized)");
+        return 0;
+    }
+
+    // Normally one message; split only when the cycle outgrows the buffer
+    int successCount = 0;
+    size_t first = 0;
+    while (first < points.size()) {
+        beginBatch(nullptr);
+        size_t next = first;
+        while (next < points.size() &&
+               appendEntry(points[next].location, measurementName(points[next].kind),
+                           points[next].value, points[next].timestamp)) {
+            next++;
+        }
+
+        if (next == first) {
+            setError("Data point does not fit in an MQTT message");
+            first++;
+            continue;
+        }
+
+        bool sent = sendBatch();
+        for (size_t i = first; i < next; i++) {
+            points[i].published = sent;
+        }
+        if (sent) {
+            successCount += static_cast<int>(next - first);
+        }
+        first = next;
+    }
+
+    return successCount;
+}
+
+void MqttPublisher::beginBatch(const char* sensorName) {
+    if (sensorName != nullptr) {
+        payloadLength = snprintf(payload, sizeof(payload), "{\"device\":\"%s\",\"sensor\":\"%s\",\"readings\":[",
+                                 deviceId, sensorName);
+    } else {
+        payloadLength = snprintf(payload, sizeof(payload), "{\"device\":\"%s\",\"readings\":[", deviceId);
+    }
+    entryCount = 0;
+}
+
+bool MqttPublisher::appendEntry(const char* location, const char* type, float value, uint32_t timestamp) {
+    size_t limit = maxPayloadLength(readingsTopic);
+    if (payloadLength + BATCH_SUFFIX_LENGTH >= limit) {
+        return false;
+    }
+
+    char* cursor = payload + payloadLength;
+    size_t available = limit - payloadLength - BATCH_SUFFIX_LENGTH;
+    int written;
+    if (timestamp != 0) {
+        written = snprintf(cursor, available + 1, "%s{\"location\":\"%s\",\"type\":\"%s\",\"value\":%.2f,\"ts\":%lu}",
+                           entryCount > 0 ? "," : "", location, type, value, (unsigned long)timestamp);
+    } else {
+        written = snprintf(cursor, available + 1, "%s{\"location\":\"%s\",\"type\":\"%s\",\"value\":%.2f}",
+                           entryCount > 0 ? "," : "", location, type, value);
+    }
+
+    if (written < 0 || static_cast<size_t>(written) > available) {
+        payload[payloadLength] = '\0';
+        return false;
+    }
+    payloadLength += written;
+    entryCount++;
+    return true;
+}
+
+bool MqttPublisher::sendBatch() {
+    memcpy(payload + payloadLength, "]}", BATCH_SUFFIX_LENGTH + 1);
+    payloadLength += BATCH_SUFFIX_LENGTH;
+
+    if (!client.publish(readingsTopic, reinterpret_cast<const uint8_t*>(payload), payloadLength, false)) {
+        setError("MQTT publish failed, state " + String(client.state()));
+        return false;
+    }
+    Serial.printf("✓ Published %d readings to %s (%d bytes)\n",
+                 (int)entryCount, readingsTopic, (int)payloadLength);
+    return true;
+}
+
+size_t MqttPublisher::maxPayloadLength(const char* topic) const {
+    // PubSubClient frames header, topic length and topic into the same buffer
+    size_t overhead = MQTT_MAX_HEADER_SIZE + 2 + strlen(topic);
+    size_t bufferSize = std::min<size_t>(client.getBufferSize(), sizeof(payload));
+    return bufferSize > overhead ? bufferSize - overhead : 0;
+}
@@ -0,0 +1,188 @@
+#include "OledScreen.h"
+#include <algorithm>
+
+namespace {
+
+const OledScreen::Field MESSAGE_LAYOUT[] = {
+    {0, 10, 72, u8g2_font_6x10_tf},
+    {0, 20, 72, u8g2_font_6x10_tf},
+    {0, 30, 72, u8g2_font_6x10_tf},
+    {0, 40, 72, u8g2_font_6x10_tf},
+};
+
+} // namespace
+
+OledScreen::OledScreen(U8G2& display)
+    : display(display), layout(nullptr), sparkline(nullptr), fieldCount(0), fullRedraw(true), bytesSent(0) {
+    memset(text, 0, sizeof(text));
+    memset(sent, 0, sizeof(sent));
+}
+
+void OledScreen::setLayout(const Field* fields, size_t count) {
+    if (fields == layout) {
+        return;
+    }
+    layout = fields;
+    sparkline = nullptr;
+    fieldCount = count < MAX_FIELDS ? count : MAX_FIELDS;
+    memset(text, 0, sizeof(text));
+    fullRedraw = true;
+}
+
+void OledScreen::setText(size_t field, const char* value) {
+    if (field >= fieldCount) {
+        return;
+    }
+    strncpy(text[field], value, MAX_TEXT_LENGTH - 1);
+    text[field][MAX_TEXT_LENGTH - 1] = '\0';
+}
+
+void OledScreen::setSparkline(Sparkline* graph) {
+    if (graph != sparkline) {
+        sparkline = graph;
+        fullRedraw = true;
+    }
+}
+
+void OledScreen::showMessage(const char* line1, const char* line2, const char* line3, const char* line4) {
+    setLayout(MESSAGE_LAYOUT);
+    setText(0, line1);
+    setText(1, line2);
+    setText(2, line3);
+    setText(3, line4);
+    render();
+}
+
+void OledScreen::invalidate() {
+    fullRedraw = true;
+}
+
+void OledScreen::clear() {
+    display.clearDisplay();
+    memset(sent, 0, sizeof(sent));
+    fullRedraw = true;
+}
+
+bool OledScreen::isPageBuffer() {
+    return display.getBufferTileHeight() < display.getU8g2()->u8x8.display_info->tile_height;
+}
+
+void OledScreen::markField(size_t field, uint16_t* dirtyColumns) {
+    const Field& f = layout[field];
+    display.setFont(f.font);
+    int top = f.y - display.getAscent();
+    int bottom = f.y - display.getDescent();  // Descent is negative
+
+    int tileColumns = display.getU8g2()->u8x8.display_info->tile_width;
+    int tileRows = display.getU8g2()->u8x8.display_info->tile_height;
+    int firstColumn = f.x / 8;
+    int lastColumn = std::min((f.x + f.width - 1) / 8, tileColumns - 1);
+    int firstRow = std::max(top, 0) / 8;
+    int lastRow = std::min(bottom / 8, std::min(tileRows, (int)MAX_TILE_ROWS) - 1);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            dirtyColumns[row] |= 1u << column;
+        }
+    }
+}
+
+void OledScreen::markSparkline(uint16_t* dirtyColumns) {
+    int tileColumns = display.getU8g2()->u8x8.display_info->tile_width;
+    int firstColumn = sparkline->getX() / 8;
+    int lastColumn = std::min((sparkline->getX() + sparkline->getWidth() - 1) / 8, tileColumns - 1);
+    int lastRow = std::min(sparkline->getTileRow() + sparkline->getTileRows(), (int)MAX_TILE_ROWS) - 1;
+
+    for (int row = sparkline->getTileRow(); row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            dirtyColumns[row] |= 1u << column;
+        }
+    }
+}
+
+void OledScreen::drawFields() {
+    for (size_t i = 0; i < fieldCount; i++) {
+        if (text[i][0] != '\0') {
+            display.setFont(layout[i].font);
+            display.drawStr(layout[i].x, layout[i].y, text[i]);
+        }
+    }
+    if (sparkline != nullptr) {
+        sparkline->draw(display);
+    }
+}
+
+size_t OledScreen::render() {
+    if (layout == nullptr) {
+        return 0;
+    }
+
+    uint8_t tileColumns = display.getU8g2()->u8x8.display_info->tile_width;
+    uint8_t tileRows = std::min(display.getU8g2()->u8x8.display_info->tile_height, (uint8_t)MAX_TILE_ROWS);
+    uint16_t dirtyColumns[MAX_TILE_ROWS] = {};
+
+    if (fullRedraw) {
+        for (uint8_t row = 0; row < tileRows; row++) {
+            dirtyColumns[row] = (1u << tileColumns) - 1;
+        }
+    } else {
+        // A field whose text changed must be erased and redrawn over its
+        // whole box, since the old text may have been wider
+        for (size_t i = 0; i < fieldCount; i++) {
+            if (strcmp(text[i], sent[i]) != 0) {
+                markField(i, dirtyColumns);
+            }
+        }
+        if (sparkline != nullptr && sparkline->isChanged()) {
+            markSparkline(dirtyColumns);
+        }
+    }
+
+    size_t bytes = 0;
+    if (isPageBuffer()) {
+        // Only the tile rows the page buffer covers are drawn into; fields
+        // outside them are clipped by U8g2
+        uint8_t rowsPerPage = display.getBufferTileHeight();
+        for (uint8_t row = 0; row < tileRows; row += rowsPerPage) {
+            uint16_t pageDirty = 0;
+            for (uint8_t r = row; r < row + rowsPerPage && r < tileRows; r++) {
+                pageDirty |= dirtyColumns[r];
+            }
+            if (pageDirty == 0) {
+                continue;
+            }
+            display.setBufferCurrTileRow(row);
+            display.clearBuffer();
+            drawFields();
+            display.sendBuffer();
+            bytes += (size_t)tileColumns * rowsPerPage * 8;
+        }
+    } else {
+        display.clearBuffer();
+        drawFields();
+        for (uint8_t row = 0; row < tileRows; row++) {
+            // Send each run of adjacent dirty tiles in one transfer
+            uint8_t column = 0;
+            while (column < tileColumns) {
+                if ((dirtyColumns[row] & (1u << column)) == 0) {
+                    column++;
+                    continue;
+                }
+                uint8_t start = column;
+                while (column < tileColumns && (dirtyColumns[row] & (1u << column)) != 0) {
+                    column++;
+                }
+                display.updateDisplayArea(start, row, column - start, 1);
+                bytes += (size_t)(column - start) * 8;
+            }
+        }
+    }
+
+    memcpy(sent, text, sizeof(sent));
+    if (sparkline != nullptr) {
+        sparkline->markSent();
+    }
+    fullRedraw = false;
+    bytesSent += bytes;
+    return bytes;
+}
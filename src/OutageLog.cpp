@@ -0,0 +1,434 @@
+#include "OutageLog.h"
+#include <LittleFS.h>
+#include <stddef.h>
+#include <algorithm>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint16_t FRAME_MAGIC = 0x4C4F;       // "OL"
+constexpr uint32_t CURSOR_MAGIC = 0x4F4C4355;  // "OLCU"
+constexpr uint8_t FLAG_BUFFER_CLOCK = 0x01;
+
+constexpr const char* LOG_DIRECTORY = "/outage";
+constexpr const char* CURSOR_PATH = "/outage/cursor";
+
+constexpr size_t MAX_FRAME_ENTRIES = 64;
+constexpr size_t MAX_FRAME_LOCATIONS = 8;
+constexpr size_t MAX_LOCATION_LENGTH = 23;
+constexpr size_t MAX_REPLAY_LOCATIONS = 16;
+
+#pragma pack(push, 1)
+struct FrameHeader {
+    uint16_t magic;
+    uint8_t flags;
+    uint8_t locationCount;
+    uint16_t entryCount;
+    uint16_t payloadLength;     // Location names and entries, CRC excluded
+    uint32_t baseTimestamp;     // Entry times are offsets from this (0 = unset)
+};
+
+struct FrameEntry {
+    uint16_t timeOffset;        // Seconds after baseTimestamp
+    int16_t value;              // Scaled by the kind's factor
+    uint8_t kind;               // MeasurementKind
+    uint8_t location;           // Index into the frame's location names
+};
+#pragma pack(pop)
+
+constexpr size_t MAX_PAYLOAD_LENGTH =
+    MAX_FRAME_LOCATIONS * (1 + MAX_LOCATION_LENGTH) + MAX_FRAME_ENTRIES * sizeof(FrameEntry);
+constexpr size_t MAX_FRAME_LENGTH = sizeof(FrameHeader) + MAX_PAYLOAD_LENGTH + sizeof(uint32_t);
+
+struct Cursor {
+    uint32_t magic;
+    uint32_t firstSegment;      // Oldest segment; replay reads from here
+    uint32_t activeSegment;     // Segment appended to
+    uint32_t readOffset;        // Replayed bytes of firstSegment
+    uint32_t activeBytes;       // Committed bytes of activeSegment
+    uint32_t droppedSegments;
+    uint32_t crc;               // Must stay last
+};
+
+Cursor cursor;
+bool mounted = false;
+uint8_t frame[MAX_FRAME_LENGTH];
+
+// Location names of the replay batch being decoded; its points point in here
+char replayLocations[MAX_REPLAY_LOCATIONS][MAX_LOCATION_LENGTH + 1];
+size_t replayLocationCount = 0;
+
+/**
+ * @brief Find or copy a decoded location name into the replay batch pool
+ * @return Pooled name, or nullptr if the pool is full
+ */
+const char* internReplayLocation(const uint8_t* name, size_t nameLength) {
+    for (size_t i = 0; i < replayLocationCount; i++) {
+        if (strlen(replayLocations[i]) == nameLength && memcmp(replayLocations[i], name, nameLength) == 0) {
+            return replayLocations[i];
+        }
+    }
+    if (replayLocationCount == MAX_REPLAY_LOCATIONS) {
+        return nullptr;
+    }
+    memcpy(replayLocations[replayLocationCount], name, nameLength);
+    replayLocations[replayLocationCount][nameLength] = '\0';
+    return replayLocations[replayLocationCount++];
+}
+
+String segmentPath(uint32_t segment) {
+    char path[32];
+    snprintf(path, sizeof(path), "%s/%08lx.log", LOG_DIRECTORY, (unsigned long)segment);
+    return String(path);
+}
+
+uint32_t cursorCrc() {
+    return crc32(&cursor, offsetof(Cursor, crc));
+}
+
+bool saveCursor() {
+    cursor.crc = cursorCrc();
+    File file = LittleFS.open(CURSOR_PATH, FILE_WRITE);
+    if (!file) {
+        return false;
+    }
+    bool written = file.write(reinterpret_cast<const uint8_t*>(&cursor), sizeof(cursor)) == sizeof(cursor);
+    file.close();
+    return written;
+}
+
+void resetCursor(uint32_t segment) {
+    uint32_t dropped = cursor.magic == CURSOR_MAGIC ? cursor.droppedSegments : 0;
+    cursor = Cursor{};
+    cursor.magic = CURSOR_MAGIC;
+    cursor.firstSegment = segment;
+    cursor.activeSegment = segment;
+    cursor.droppedSegments = dropped;
+}
+
+bool mount() {
+    if (mounted) {
+        return true;
+    }
+    if (!LittleFS.begin(true)) {
+        Serial.println("⚠ LittleFS mount failed - outage log unavailable");
+        return false;
+    }
+    LittleFS.mkdir(LOG_DIRECTORY);
+    mounted = true;
+
+    File file = LittleFS.open(CURSOR_PATH, FILE_READ);
+    bool valid = file && file.read(reinterpret_cast<uint8_t*>(&cursor), sizeof(cursor)) == sizeof(cursor) &&
+                 cursor.magic == CURSOR_MAGIC && cursor.crc == cursorCrc();
+    if (file) {
+        file.close();
+    }
+    if (!valid) {
+        resetCursor(1);
+        return true;
+    }
+
+    // A frame written after the last cursor update was interrupted; keep new
+    // frames out of the damaged segment
+    File active = LittleFS.open(segmentPath(cursor.activeSegment).c_str(), FILE_READ);
+    size_t activeSize = active ? active.size() : 0;
+    if (active) {
+        active.close();
+    }
+    if (activeSize != cursor.activeBytes) {
+        Serial.printf("⚠ Outage log segment %lu has a torn frame, starting a new one\n",
+                     (unsigned long)cursor.activeSegment);
+        cursor.activeSegment++;
+        cursor.activeBytes = 0;
+        saveCursor();
+    }
+    return true;
+}
+
+void dropOldestSegment() {
+    LittleFS.remove(segmentPath(cursor.firstSegment).c_str());
+    cursor.firstSegment++;
+    cursor.readOffset = 0;
+    cursor.droppedSegments++;
+    Serial.printf("⚠ Outage log full - dropped oldest segment (%lu dropped so far)\n",
+                 (unsigned long)cursor.droppedSegments);
+}
+
+/**
+ * @brief Encode up to MAX_FRAME_ENTRIES points starting at first into frame
+ * @return Frame length, and the number of points consumed in consumed
+ */
+size_t encodeFrame(const std::vector<IDataPublisher::DataPoint>& points, size_t first, uint8_t flags,
+                   size_t& consumed) {
+    const char* locations[MAX_FRAME_LOCATIONS];
+    uint8_t locationCount = 0;
+
+    uint32_t base = 0;
+    for (size_t i = first; i < points.size() && i - first < MAX_FRAME_ENTRIES; i++) {
+        if (points[i].timestamp != 0 && (base == 0 || points[i].timestamp < base)) {
+            base = points[i].timestamp;
+        }
+    }
+
+    FrameEntry entries[MAX_FRAME_ENTRIES];
+    size_t entryCount = 0;
+    size_t index = first;
+    for (; index < points.size() && entryCount < MAX_FRAME_ENTRIES; index++) {
+        const auto& point = points[index];
+        if (strlen(point.location) > MAX_LOCATION_LENGTH) {
+            continue;
+        }
+
+        uint8_t location = 0;
+        while (location < locationCount && strcmp(point.location, locations[location]) != 0) {
+            location++;
+        }
+        if (location == locationCount) {
+            if (locationCount == MAX_FRAME_LOCATIONS) {
+                break; // Continue in the next frame
+            }
+            locations[locationCount++] = point.location;
+        }
+
+        float scaled = roundf(point.value * measurementScale(point.kind));
+        uint32_t offset = (base != 0 && point.timestamp >= base) ? point.timestamp - base : 0;
+
+        FrameEntry& entry = entries[entryCount++];
+        entry.timeOffset = static_cast<uint16_t>(std::min<uint32_t>(offset, UINT16_MAX));
+        entry.value = static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, scaled)));
+        entry.kind = static_cast<uint8_t>(point.kind);
+        entry.location = location;
+    }
+    consumed = index - first;
+
+    size_t length = sizeof(FrameHeader);
+    for (uint8_t i = 0; i < locationCount; i++) {
+        size_t nameLength = strlen(locations[i]);
+        frame[length++] = static_cast<uint8_t>(nameLength);
+        memcpy(frame + length, locations[i], nameLength);
+        length += nameLength;
+    }
+    memcpy(frame + length, entries, entryCount * sizeof(FrameEntry));
+    length += entryCount * sizeof(FrameEntry);
+
+    FrameHeader header{};
+    header.magic = FRAME_MAGIC;
+    header.flags = flags;
+    header.locationCount = locationCount;
+    header.entryCount = static_cast<uint16_t>(entryCount);
+    header.payloadLength = static_cast<uint16_t>(length - sizeof(FrameHeader));
+    header.baseTimestamp = base;
+    memcpy(frame, &header, sizeof(header));
+
+    uint32_t crc = crc32(frame, length);
+    memcpy(frame + length, &crc, sizeof(crc));
+    return entryCount > 0 ? length + sizeof(crc) : 0;
+}
+
+/**
+ * @brief Decode the frame at the file's position into points
+ *
+ * The points' location names live in the replay batch pool, so the caller
+ * must leave MAX_FRAME_LOCATIONS free names in it.
+ * @return false at the end of the segment or on a damaged frame
+ */
+bool decodeFrame(File& file, std::vector<IDataPublisher::DataPoint>& points,
+                 uint32_t utcNow, uint32_t clockNow) {
+    FrameHeader header;
+    if (file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) != sizeof(header) ||
+        header.magic != FRAME_MAGIC || header.payloadLength > MAX_PAYLOAD_LENGTH ||
+        header.locationCount > MAX_FRAME_LOCATIONS || header.entryCount > MAX_FRAME_ENTRIES) {
+        return false;
+    }
+
+    memcpy(frame, &header, sizeof(header));
+    uint8_t* payload = frame + sizeof(header);
+    uint32_t storedCrc;
+    if (file.read(payload, header.payloadLength) != header.payloadLength ||
+        file.read(reinterpret_cast<uint8_t*>(&storedCrc), sizeof(storedCrc)) != sizeof(storedCrc) ||
+        storedCrc != crc32(frame, sizeof(header) + header.payloadLength)) {
+        return false;
+    }
+
+    const char* locations[MAX_FRAME_LOCATIONS];
+    size_t offset = 0;
+    for (uint8_t i = 0; i < header.locationCount; i++) {
+        size_t nameLength = payload[offset++];
+        if (nameLength > MAX_LOCATION_LENGTH) {
+            return false;
+        }
+        locations[i] = internReplayLocation(payload + offset, nameLength);
+        if (locations[i] == nullptr) {
+            return false;
+        }
+        offset += nameLength;
+    }
+    if (offset + header.entryCount * sizeof(FrameEntry) != header.payloadLength) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < header.entryCount; i++) {
+        FrameEntry entry;
+        memcpy(&entry, payload + offset + i * sizeof(FrameEntry), sizeof(entry));
+        if (entry.kind >= MEASUREMENT_KIND_COUNT || entry.location >= header.locationCount) {
+            continue;
+        }
+
+        uint32_t timestamp = header.baseTimestamp != 0 ? header.baseTimestamp + entry.timeOffset : 0;
+        if (timestamp != 0 && (header.flags & FLAG_BUFFER_CLOCK)) {
+            // The buffer clock restarts after a power loss; such times are unusable
+            timestamp = (utcNow != 0 && clockNow >= timestamp) ? utcNow - (clockNow - timestamp) : 0;
+        }
+
+        MeasurementKind kind = static_cast<MeasurementKind>(entry.kind);
+        points.emplace_back(locations[entry.location], kind, entry.value / measurementScale(kind), timestamp);
+    }
+    return true;
+}
+
+} // namespace
+
+bool OutageLog::append(const std::vector<IDataPublisher::DataPoint>& points, TimeBase timeBase) {
+    if (points.empty()) {
+        return true;
+    }
+    if (!mount()) {
+        return false;
+    }
+
+    uint8_t flags = timeBase == TimeBase::BUFFER_CLOCK ? FLAG_BUFFER_CLOCK : 0;
+    size_t first = 0;
+    size_t logged = 0;
+    while (first < points.size()) {
+        size_t consumed = 0;
+        size_t length = encodeFrame(points, first, flags, consumed);
+        first += std::max<size_t>(consumed, 1);
+        if (length == 0) {
+            continue;
+        }
+
+        if (cursor.activeBytes > 0 && cursor.activeBytes + length > Config::OUTAGE_LOG_SEGMENT_BYTES) {
+            cursor.activeSegment++;
+            cursor.activeBytes = 0;
+            if (cursor.activeSegment - cursor.firstSegment >= Config::OUTAGE_LOG_MAX_SEGMENTS) {
+                dropOldestSegment();
+            }
+        }
+
+        File file = LittleFS.open(segmentPath(cursor.activeSegment).c_str(), FILE_APPEND);
+        bool written = file && file.write(frame, length) == length;
+        if (file) {
+            file.close();
+        }
+        if (!written) {
+            Serial.println("⚠ Outage log write failed");
+            return false;
+        }
+
+        cursor.activeBytes += length;
+        logged += consumed;
+        saveCursor();
+    }
+
+    Serial.printf("Logged %d data points for replay (%lu bytes pending)\n",
+                 (int)logged, (unsigned long)getPendingBytes());
+    return true;
+}
+
+size_t OutageLog::replay(IDataPublisher& publisher, uint32_t utcNow, uint32_t clockNow) {
+    if (!mount() || !hasPending()) {
+        return 0;
+    }
+
+    size_t replayed = 0;
+    for (uint8_t batch = 0; batch < Config::OUTAGE_LOG_REPLAY_BATCHES_PER_WAKE && hasPending(); batch++) {
+        // Whole frames, from the cursor up to the batch size or the end of the segment
+        std::vector<IDataPublisher::DataPoint> points;
+        points.reserve(Config::OUTAGE_LOG_REPLAY_BATCH_SIZE + MAX_FRAME_ENTRIES);
+        replayLocationCount = 0;
+
+        String path = segmentPath(cursor.firstSegment);
+        File file = LittleFS.open(path.c_str(), FILE_READ);
+        size_t segmentEnd = file ? file.size() : 0;
+        if (cursor.firstSegment == cursor.activeSegment) {
+            segmentEnd = std::min<size_t>(segmentEnd, cursor.activeBytes);
+        }
+
+        uint32_t nextOffset = cursor.readOffset;
+        if (file && file.seek(cursor.readOffset)) {
+            // A frame brings up to MAX_FRAME_LOCATIONS new names; leave it for the next batch if they may not fit
+            while (nextOffset < segmentEnd && points.size() < Config::OUTAGE_LOG_REPLAY_BATCH_SIZE &&
+                   replayLocationCount + MAX_FRAME_LOCATIONS <= MAX_REPLAY_LOCATIONS) {
+                if (!decodeFrame(file, points, utcNow, clockNow)) {
+                    Serial.printf("⚠ Outage log segment %lu damaged at byte %lu, skipping the rest\n",
+                                 (unsigned long)cursor.firstSegment, (unsigned long)nextOffset);
+                    nextOffset = segmentEnd;
+                    break;
+                }
+                nextOffset = file.position();
+            }
+        } else {
+            nextOffset = segmentEnd; // Missing segment: nothing to replay from it
+        }
+        if (file) {
+            file.close();
+        }
+
+        // Bound the replay rate so the backlog does not monopolize the uplink
+        if (batch > 0 && !points.empty()) {
+            delay(Config::OUTAGE_LOG_REPLAY_INTERVAL_MS);
+        }
+
+        if (!points.empty()) {
+            int published = publisher.publishCycle(points);
+            if (published < (int)points.size()) {
+                Serial.printf("⚠ Outage log replay stopped: %d/%d published\n",
+                             published, (int)points.size());
+                break;
+            }
+            replayed += points.size();
+        }
+
+        // Advance the cursor; segments are deleted once fully replayed
+        if (nextOffset < segmentEnd) {
+            cursor.readOffset = nextOffset;
+        } else if (cursor.firstSegment != cursor.activeSegment) {
+            LittleFS.remove(path.c_str());
+            cursor.firstSegment++;
+            cursor.readOffset = 0;
+        } else {
+            LittleFS.remove(path.c_str());
+            resetCursor(cursor.activeSegment + 1);
+        }
+        saveCursor();
+    }
+
+    Serial.printf("Replayed %d logged data points (%lu bytes pending)\n",
+                 (int)replayed, (unsigned long)getPendingBytes());
+    return replayed;
+}
+
+bool OutageLog::hasPending() {
+    return getPendingBytes() > 0;
+}
+
+uint32_t OutageLog::getPendingBytes() {
+    if (!mount()) {
+        return 0;
+    }
+    if (cursor.firstSegment == cursor.activeSegment) {
+        return cursor.activeBytes > cursor.readOffset ? cursor.activeBytes - cursor.readOffset : 0;
+    }
+
+    // Closed segments are close to full; the exact size would need a file open each
+    uint32_t closed = cursor.activeSegment - cursor.firstSegment;
+    return closed * Config::OUTAGE_LOG_SEGMENT_BYTES - cursor.readOffset + cursor.activeBytes;
+}
+
+#ifdef NATIVE_BUILD
+void OutageLog::unmount() {
+    LittleFS.end();
+    cursor = Cursor{};
+    mounted = false;
+}
+#endif
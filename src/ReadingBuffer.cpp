@@ -0,0 +1,190 @@
+#include "ReadingBuffer.h"
+#include <stddef.h>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint32_t BUFFER_MAGIC = 0x52424646; // "RBFF"
+constexpr size_t MAX_LOCATIONS = 8;
+constexpr size_t MAX_LOCATION_LENGTH = 24;
+
+struct Entry {
+    uint32_t timestamp;     // Seconds on the buffer clock
+    int16_t value;          // Scaled by the kind's factor
+    uint8_t kind;           // MeasurementKind
+    uint8_t locationIndex;
+};
+
+struct BufferStorage {
+    uint32_t magic;
+    uint64_t clockMs;           // Buffer clock at the start of this wake
+    uint32_t nextUploadSeconds; // Buffer clock from which an upload is due
+    uint32_t droppedCount;
+    uint16_t head;              // Index of the oldest entry
+    uint16_t count;
+    uint16_t lastWakeEntries;   // Entries appended by the previous wake
+    uint16_t currentWakeEntries;
+    uint8_t locationCount;
+    char locations[MAX_LOCATIONS][MAX_LOCATION_LENGTH];
+    Entry entries[Config::READING_BUFFER_CAPACITY];
+    uint32_t crc;               // Must stay last
+};
+
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR BufferStorage storage;
+
+uint32_t computeCrc() {
+    return crc32(&storage, offsetof(BufferStorage, crc));
+}
+
+void seal() {
+    storage.crc = computeCrc();
+}
+
+void resetStorage() {
+    storage = BufferStorage{};
+    storage.magic = BUFFER_MAGIC;
+}
+
+uint32_t clockSeconds() {
+    return static_cast<uint32_t>((storage.clockMs + millis()) / 1000ULL);
+}
+
+void scheduleUpload() {
+    storage.nextUploadSeconds = clockSeconds() + Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS;
+}
+
+int findOrAddLocation(const char* location) {
+    if (strlen(location) >= MAX_LOCATION_LENGTH) {
+        return -1;
+    }
+    for (size_t i = 0; i < storage.locationCount; i++) {
+        if (strcmp(location, storage.locations[i]) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    if (storage.locationCount == MAX_LOCATIONS) {
+        return -1;
+    }
+    strncpy(storage.locations[storage.locationCount], location, MAX_LOCATION_LENGTH - 1);
+    return storage.locationCount++;
+}
+
+} // namespace
+
+void ReadingBuffer::beginWake() {
+    if (storage.magic != BUFFER_MAGIC) {
+        resetStorage();
+        if (!Config::READING_BUFFER_UPLOAD_ON_POWER_ON) {
+            scheduleUpload();
+        }
+    } else if (storage.crc != computeCrc()) {
+        Serial.println("⚠ Reading buffer CRC mismatch - discarding buffered readings");
+        uint64_t clockMs = storage.clockMs;
+        resetStorage();
+        storage.clockMs = clockMs;
+        scheduleUpload();
+    }
+
+    storage.lastWakeEntries = storage.currentWakeEntries;
+    storage.currentWakeEntries = 0;
+    seal();
+}
+
+bool ReadingBuffer::append(const IDataPublisher::DataPoint& point) {
+    int locationIndex = findOrAddLocation(point.location);
+    if (locationIndex < 0) {
+        Serial.printf("⚠ Cannot buffer %s reading from '%s'\n",
+                     measurementName(point.kind), point.location);
+        return false;
+    }
+
+    float scaled = roundf(point.value * measurementScale(point.kind));
+    scaled = std::max(-32768.0f, std::min(32767.0f, scaled));
+
+    // Overwrite the oldest entry once the ring is full
+    size_t index = (storage.head + storage.count) % Config::READING_BUFFER_CAPACITY;
+    if (storage.count == Config::READING_BUFFER_CAPACITY) {
+        storage.head = (storage.head + 1) % Config::READING_BUFFER_CAPACITY;
+        storage.droppedCount++;
+    } else {
+        storage.count++;
+    }
+
+    Entry& entry = storage.entries[index];
+    entry.timestamp = clockSeconds();
+    entry.value = static_cast<int16_t>(scaled);
+    entry.kind = static_cast<uint8_t>(point.kind);
+    entry.locationIndex = static_cast<uint8_t>(locationIndex);
+    storage.currentWakeEntries++;
+
+    seal();
+    return true;
+}
+
+size_t ReadingBuffer::appendAll(const std::vector<IDataPublisher::DataPoint>& points) {
+    size_t appended = 0;
+    for (const auto& point : points) {
+        if (append(point)) {
+            appended++;
+        }
+    }
+    return appended;
+}
+
+bool ReadingBuffer::isUploadDue() {
+    if (clockSeconds() >= storage.nextUploadSeconds) {
+        return true;
+    }
+
+    // Upload now rather than overwrite readings during the next wake
+    size_t freeEntries = Config::READING_BUFFER_CAPACITY - storage.count;
+    return freeEntries < 2u * storage.lastWakeEntries;
+}
+
+size_t ReadingBuffer::getCount() {
+    return storage.count;
+}
+
+uint32_t ReadingBuffer::getDroppedCount() {
+    return storage.droppedCount;
+}
+
+uint32_t ReadingBuffer::getSecondsUntilUpload() {
+    uint32_t now = clockSeconds();
+    return now >= storage.nextUploadSeconds ? 0 : storage.nextUploadSeconds - now;
+}
+
+std::vector<IDataPublisher::DataPoint> ReadingBuffer::getDataPoints(uint32_t utcNow) {
+    std::vector<IDataPublisher::DataPoint> points;
+    points.reserve(storage.count);
+
+    uint32_t now = clockSeconds();
+    for (size_t i = 0; i < storage.count; i++) {
+        const Entry& entry = storage.entries[(storage.head + i) % Config::READING_BUFFER_CAPACITY];
+        MeasurementKind kind = static_cast<MeasurementKind>(entry.kind);
+        uint32_t timestamp = utcNow != 0 ? utcNow - (now - entry.timestamp) : 0;
+
+        points.emplace_back(storage.locations[entry.locationIndex], kind,
+                            entry.value / measurementScale(kind), timestamp);
+    }
+
+    return points;
+}
+
+void ReadingBuffer::clear() {
+    storage.head = 0;
+    storage.count = 0;
+    storage.droppedCount = 0;
+    scheduleUpload();
+    seal();
+}
+
+uint32_t ReadingBuffer::getClockSeconds() {
+    return clockSeconds();
+}
+
+void ReadingBuffer::prepareSleep(uint32_t sleepSeconds) {
+    storage.clockMs += millis() + static_cast<uint64_t>(sleepSeconds) * 1000ULL;
+    seal();
+}
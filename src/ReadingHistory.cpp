@@ -0,0 +1,137 @@
+#include "ReadingHistory.h"
+#include <stddef.h>
+#include <math.h>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint32_t HISTORY_MAGIC = 0x48495354; // "HIST"
+
+struct HistoryStorage {
+    uint32_t magic;
+    uint32_t slotStart;     // Caller clock at the start of the open slot
+    int32_t slotSum;        // Hundredths
+    uint16_t slotReadings;
+    uint16_t head;          // Index of the oldest closed slot
+    uint16_t count;
+    uint16_t reserved;
+    uint32_t closedCount;
+    int16_t slots[Config::HISTORY_SLOTS];
+    uint32_t crc;           // Must stay last
+};
+
+// Not initialized by the bootloader, so it survives deep sleep and resets;
+// after a power-on it holds garbage that fails the CRC check
+RTC_NOINIT_ATTR HistoryStorage storage;
+
+uint32_t computeCrc() {
+    return crc32(&storage, offsetof(HistoryStorage, crc));
+}
+
+void ensureValid(uint32_t clockSeconds) {
+    if (storage.magic != HISTORY_MAGIC || storage.crc != computeCrc()) {
+        storage = HistoryStorage{};
+        storage.magic = HISTORY_MAGIC;
+        storage.slotStart = clockSeconds;
+    }
+}
+
+void closeSlot() {
+    int16_t value = ReadingHistory::NO_SAMPLE;
+    if (storage.slotReadings > 0) {
+        value = static_cast<int16_t>(lroundf(static_cast<float>(storage.slotSum) / storage.slotReadings));
+    }
+
+    // Overwrite the oldest slot once the ring is full
+    size_t index = (storage.head + storage.count) % Config::HISTORY_SLOTS;
+    if (storage.count == Config::HISTORY_SLOTS) {
+        storage.head = (storage.head + 1) % Config::HISTORY_SLOTS;
+    } else {
+        storage.count++;
+    }
+    storage.slots[index] = value;
+    storage.closedCount++;
+
+    storage.slotStart += Config::HISTORY_SLOT_SECONDS;
+    storage.slotSum = 0;
+    storage.slotReadings = 0;
+}
+
+int16_t toHundredths(float value) {
+    // Keep NO_SAMPLE out of the valid range
+    float scaled = roundf(value * 100.0f);
+    if (scaled <= INT16_MIN) {
+        return INT16_MIN + 1;
+    }
+    if (scaled > INT16_MAX) {
+        return INT16_MAX;
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+} // namespace
+
+void ReadingHistory::add(float value, uint32_t clockSeconds) {
+    advance(clockSeconds);
+    storage.slotSum += toHundredths(value);
+    storage.slotReadings++;
+    storage.crc = computeCrc();
+}
+
+void ReadingHistory::advance(uint32_t clockSeconds) {
+    ensureValid(clockSeconds);
+
+    if (clockSeconds < storage.slotStart) {
+        storage.slotStart = clockSeconds;
+    }
+
+    // Slots that passed without readings become gaps; after a full day of
+    // them there is nothing left to keep
+    uint32_t elapsed = (clockSeconds - storage.slotStart) / Config::HISTORY_SLOT_SECONDS;
+    if (elapsed > Config::HISTORY_SLOTS) {
+        storage.slotStart += (elapsed - Config::HISTORY_SLOTS) * Config::HISTORY_SLOT_SECONDS;
+        storage.closedCount += elapsed - Config::HISTORY_SLOTS;
+        elapsed = Config::HISTORY_SLOTS;
+    }
+    for (uint32_t i = 0; i < elapsed; i++) {
+        closeSlot();
+    }
+    storage.crc = computeCrc();
+}
+
+size_t ReadingHistory::getSamples(int16_t* samples, size_t maxCount) {
+    ensureValid(0);
+    size_t count = storage.count < maxCount ? storage.count : maxCount;
+    size_t first = storage.head + storage.count - count;
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = storage.slots[(first + i) % Config::HISTORY_SLOTS];
+    }
+    return count;
+}
+
+uint32_t ReadingHistory::getClosedCount() {
+    ensureValid(0);
+    return storage.closedCount;
+}
+
+bool ReadingHistory::getRange(uint32_t hours, float& min, float& max) {
+    int16_t samples[Config::HISTORY_SLOTS];
+    size_t slots = hours * 3600 / Config::HISTORY_SLOT_SECONDS;
+    size_t count = getSamples(samples, slots < Config::HISTORY_SLOTS ? slots : Config::HISTORY_SLOTS);
+
+    int16_t low = INT16_MAX;
+    int16_t high = INT16_MIN;
+    for (size_t i = 0; i < count; i++) {
+        if (samples[i] == NO_SAMPLE) {
+            continue;
+        }
+        low = samples[i] < low ? samples[i] : low;
+        high = samples[i] > high ? samples[i] : high;
+    }
+    if (high == INT16_MIN) {
+        return false;
+    }
+    min = low / 100.0f;
+    max = high / 100.0f;
+    return true;
+}
@@ -1,9 +1,24 @@
 #include "SCD41Sensor.h"
+#include "BusDiscoveryCache.h"
 
 char SCD41Sensor::errorMessage[64];
 
-SCD41Sensor::SCD41Sensor(const String& location, uint8_t i2cAddress)
-    : location(location), i2cAddress(i2cAddress), initializationTime(0), measurementStarted(false) {
+namespace {
+enum class SensorState : uint8_t {
+    UNKNOWN = 0,        // Power-on or after an error: state must be re-established
+    POWERED_DOWN,       // Put to sleep after a single-shot measurement
+    MEASURING           // Periodic measurement running
+};
+
+// What this firmware left the sensor doing (survives deep sleep)
+RTC_DATA_ATTR SensorState sensorState = SensorState::UNKNOWN;
+}
+
+SCD41Sensor::SCD41Sensor(const char* location, uint8_t i2cAddress)
+    : location(location), i2cAddress(i2cAddress), mode(Config::SCD41_MODE), initializationTime(0),
+      measurementStarted(false), acquisitionStartTime(0), resumedMeasurement(false), discardNextSample(false),
+      acquisitionPending(false), acquisitionFailed(false), dataReady(false),
+      pollAttempts(0), communicationRetries(0), lastPollTime(0) {
 }
 
 bool SCD41Sensor::initialize() {
@@ -13,11 +28,30 @@ bool SCD41Sensor::initialize() {
         return false;
     }
     
-    // Scan for I2C devices
-    scanI2CDevices();
-    
     // Initialize sensor communication
     scd4x.begin(Wire, i2cAddress);
+    
+    if (isSingleShot()) {
+        return initializeSingleShot();
+    }
+    
+    if (mode == Config::SCD41Mode::PERIODIC_PERSISTENT && sensorState == SensorState::MEASURING) {
+        // Still measuring since an earlier wake: no restart, no startup delay
+        resumedMeasurement = true;
+        measurementStarted = true;
+        initialized = true;
+        clearError();
+        Serial.printf("✓ SCD-41 periodic measurement still running at location: %s\n", location);
+        return true;
+    }
+    
+    delay(500); // Allow I2C to stabilize
+    
+    // Full scan only when no earlier wake has seen the sensor on the bus
+    if (!BusDiscoveryCache::isI2CDevicePresent(i2cAddress)) {
+        scanI2CDevices();
+    }
+    
     delay(200); // Allow sensor to respond
     
     // Try wake-up
@@ -25,7 +59,8 @@ bool SCD41Sensor::initialize() {
     if (error == NO_ERROR) {
         Serial.printf("✓ SCD-41 responds at address 0x%02X\n", i2cAddress);
     } else {
-        setError("SCD-41 wake-up failed: " + getErrorString(error));
+        setError(ErrorCode::DEVICE_NOT_FOUND, "SCD-41 wake-up failed: %s", getErrorString(error));
+        BusDiscoveryCache::invalidateI2C();
         return false;
     }
     
@@ -37,9 +72,9 @@ bool SCD41Sensor::initialize() {
     
     initializationTime = millis();
     initialized = true;
-    lastError = "";
+    clearError();
     
-    Serial.printf("✓ SCD-41 sensor initialized at location: %s\n", location.c_str());
+    Serial.printf("✓ SCD-41 sensor initialized at location: %s\n", location);
     Serial.println("  Note: First valid measurement available after ~5 seconds");
     
     return true;
@@ -49,11 +84,75 @@ bool SCD41Sensor::initializeI2C() {
     Serial.println("Initializing I2C bus...");
     Wire.begin(Config::I2C_SDA_PIN, Config::I2C_SCL_PIN);
     Wire.setClock(Config::I2C_FREQUENCY);
-    delay(500); // Allow I2C to stabilize
     
     return true;
 }
 
+bool SCD41Sensor::initializeSingleShot() {
+    // wake_up is not acknowledged by the sensor; the driver waits the 30 ms it needs
+    scd4x.wakeUp();
+    
+    if (sensorState != SensorState::POWERED_DOWN) {
+        // Unknown state after power-on or reflashing: periodic measurement
+        // may still be running, which rejects single-shot commands
+        scd4x.stopPeriodicMeasurement();
+    }
+    sensorState = SensorState::UNKNOWN;
+    discardNextSample = true;
+    
+    uint64_t serialNumber = 0;
+    int16_t error = scd4x.getSerialNumber(serialNumber);
+    if (error != NO_ERROR) {
+        setError(ErrorCode::DEVICE_NOT_FOUND, "SCD-41 not responding at address 0x%02X: %s",
+                 i2cAddress, getErrorString(error));
+        return false;
+    }
+    
+    initialized = true;
+    clearError();
+    
+    Serial.printf("✓ SCD-41 sensor initialized at location: %s (%s)\n", location,
+                 mode == Config::SCD41Mode::SINGLE_SHOT ? "single shot" : "single shot, RHT only");
+    
+    return true;
+}
+
+bool SCD41Sensor::startSingleShot() {
+    uint16_t command = mode == Config::SCD41Mode::SINGLE_SHOT_RHT_ONLY
+        ? CMD_MEASURE_SINGLE_SHOT_RHT_ONLY
+        : CMD_MEASURE_SINGLE_SHOT;
+    
+    if (!sendCommand(command)) {
+        setError(ErrorCode::COMMUNICATION, "SCD-41 single-shot command failed");
+        return false;
+    }
+    
+    acquisitionStartTime = millis();
+    return true;
+}
+
+bool SCD41Sensor::sendCommand(uint16_t command) {
+    Wire.beginTransmission(i2cAddress);
+    Wire.write(static_cast<uint8_t>(command >> 8));
+    Wire.write(static_cast<uint8_t>(command & 0xFF));
+    return Wire.endTransmission() == 0;
+}
+
+uint32_t SCD41Sensor::getMeasurementDuration() const {
+    return mode == Config::SCD41Mode::SINGLE_SHOT_RHT_ONLY
+        ? Config::SCD41_SINGLE_SHOT_RHT_DURATION_MS
+        : Config::SCD41_SINGLE_SHOT_DURATION_MS;
+}
+
+void SCD41Sensor::powerDown() {
+    int16_t error = scd4x.powerDown();
+    if (error == NO_ERROR) {
+        sensorState = SensorState::POWERED_DOWN;
+    } else {
+        Serial.printf("⚠ SCD-41 power down failed: %s\n", getErrorString(error));
+    }
+}
+
 bool SCD41Sensor::startMeasurement() {
     // Stop any ongoing measurements first
     int16_t error = scd4x.stopPeriodicMeasurement();
@@ -68,44 +167,126 @@ bool SCD41Sensor::startMeasurement() {
     // Start periodic measurements
     error = scd4x.startPeriodicMeasurement();
     if (error != NO_ERROR) {
-        setError("SCD-41 start measurement failed: " + getErrorString(error));
+        setError(ErrorCode::COMMUNICATION, "SCD-41 start measurement failed: %s", getErrorString(error));
         measurementStarted = false;
+        sensorState = SensorState::UNKNOWN;
         return false;
     }
     
     Serial.println("✓ SCD-41 periodic measurement started");
     measurementStarted = true;
+    sensorState = SensorState::MEASURING;
     return true;
 }
 
 bool SCD41Sensor::isReady() const {
+    if (isSingleShot()) {
+        // Ready once the triggered measurement has had time to finish
+        return initialized && 
+               (!acquisitionPending || (millis() - acquisitionStartTime) >= getMeasurementDuration());
+    }
+    
     if (!initialized || !measurementStarted) {
         return false;
     }
     
+    if (resumedMeasurement) {
+        return true;
+    }
+    
     // SCD-41 needs time after initialization for valid readings
     unsigned long currentTime = millis();
     return (currentTime - initializationTime) >= Config::SCD41_STARTUP_DELAY_MS;
 }
 
-bool SCD41Sensor::readSensor(std::vector<Reading>& readings) {
-    readings.clear();
-    
+bool SCD41Sensor::startReading() {
     if (!initialized) {
-        setError("SCD-41 not initialized");
+        setError(ErrorCode::NOT_INITIALIZED, "SCD-41 not initialized");
+        return false;
+    }
+    
+    // Periodic measurement is already running; single shot triggers one now
+    if (isSingleShot() && !startSingleShot()) {
         return false;
     }
     
+    acquisitionPending = true;
+    acquisitionFailed = false;
+    dataReady = false;
+    pollAttempts = 0;
+    communicationRetries = 0;
+    lastPollTime = 0;
+    return true;
+}
+
+bool SCD41Sensor::isReadingComplete() {
+    if (!acquisitionPending || dataReady || acquisitionFailed) {
+        return true;
+    }
+    
+    // Wait for the startup delay before talking to the sensor
     if (!isReady()) {
-        setError("SCD-41 not ready (waiting for startup delay)");
         return false;
     }
     
-    Serial.println("Reading SCD-41 sensor...");
+    if (!pollDataReady()) {
+        return false;
+    }
+    if (dataReady && discardNextSample) {
+        return discardSample();
+    }
+    return true;
+}
+
+bool SCD41Sensor::discardSample() {
+    // Sensirion: the first single shot after wake_up must be discarded.
+    // Read it out to clear data ready, then trigger the shot that counts
+    discardNextSample = false;
+    uint16_t co2;
+    float temperature;
+    float humidity;
+    scd4x.readMeasurement(co2, temperature, humidity);
+    Serial.println("SCD-41 discarded first single shot after wake-up");
+    
+    if (!startSingleShot()) {
+        acquisitionFailed = true;
+        return true;
+    }
+    dataReady = false;
+    pollAttempts = 0;
+    communicationRetries = 0;
+    lastPollTime = 0;
+    return false;
+}
+
+bool SCD41Sensor::collectReading(Readings& readings) {
+    readings.clear();
     
-    if (!waitForDataReady()) {
+    if (!acquisitionPending) {
+        setError(ErrorCode::NOT_STARTED, "SCD-41 reading not started");
         return false;
     }
+    acquisitionPending = false;
+    
+    bool success = !acquisitionFailed && readMeasurement(readings);
+    
+    // One measurement per wake: keep the sensor powered down until the next one
+    if (isSingleShot()) {
+        powerDown();
+    } else if (!success && resumedMeasurement) {
+        // The sensor may have lost power while we slept; restart it next wake
+        sensorState = SensorState::UNKNOWN;
+    }
+    
+    if (!success) {
+        BusDiscoveryCache::invalidateI2C(); // Rescan the bus on the next wake
+    }
+    
+    return success;
+}
+
+bool SCD41Sensor::readMeasurement(Readings& readings) {
+    Serial.println("Reading SCD-41 sensor...");
     
     // Read measurement
     uint16_t co2;
@@ -114,7 +295,7 @@ bool SCD41Sensor::readSensor(std::vector<Reading>& readings) {
     
     int16_t error = scd4x.readMeasurement(co2, temperature, humidity);
     if (error != NO_ERROR) {
-        setError("SCD-41 read measurement failed: " + getErrorString(error));
+        setError(ErrorCode::COMMUNICATION, "SCD-41 read measurement failed: %s", getErrorString(error));
         return false;
     }
     
@@ -122,29 +303,30 @@ bool SCD41Sensor::readSensor(std::vector<Reading>& readings) {
     bool hasValidReading = false;
     
     // CO2 reading
-    if (isValidCO2(co2)) {
-        Reading co2Reading(co2, Status::SUCCESS);
+    bool rhtOnly = mode == Config::SCD41Mode::SINGLE_SHOT_RHT_ONLY;
+    if (rhtOnly) {
+        readings.push_back(Reading::failed(MeasurementKind::CO2, Status::NOT_INITIALIZED, ErrorCode::NOT_MEASURED));
+    } else if (isValidCO2(co2)) {
+        Reading co2Reading(MeasurementKind::CO2, co2);
         readings.push_back(co2Reading);
         Serial.printf("✓ SCD-41 CO2: %d ppm\n", co2);
         hasValidReading = true;
     } else {
-        Reading co2Reading;
-        co2Reading.status = Status::INVALID_DATA;
-        co2Reading.errorMessage = "Invalid CO2 reading: " + String(co2);
-        readings.push_back(co2Reading);
+        readings.push_back(Reading::failed(MeasurementKind::CO2, Status::INVALID_DATA, ErrorCode::INVALID_DATA));
         Serial.printf("✗ SCD-41 CO2: Invalid (%d ppm)\n", co2);
     }
     
     // Temperature reading (optional - for reference only)
     if (isValidTemperature(temperature)) {
-        Reading tempReading(temperature, Status::SUCCESS);
+        Reading tempReading(MeasurementKind::TEMPERATURE, temperature);
         readings.push_back(tempReading);
         Serial.printf("  SCD-41 Temperature: %.1f°C\n", temperature);
+        hasValidReading = hasValidReading || rhtOnly;
     }
     
     // Humidity reading (optional - for reference only)
     if (isValidHumidity(humidity)) {
-        Reading humidReading(humidity, Status::SUCCESS);
+        Reading humidReading(MeasurementKind::HUMIDITY, humidity);
         readings.push_back(humidReading);
         Serial.printf("  SCD-41 Humidity: %.1f%%\n", humidity);
     }
@@ -152,43 +334,51 @@ bool SCD41Sensor::readSensor(std::vector<Reading>& readings) {
     return hasValidReading;
 }
 
-bool SCD41Sensor::waitForDataReady() {
-    bool dataReady = false;
-    int attempts = 0;
+bool SCD41Sensor::pollDataReady() {
+    // Space out I2C polls; back off longer after communication errors
+    unsigned long now = millis();
+    unsigned long pollInterval = communicationRetries > 0 ? 500 : Config::SCD41_RETRY_DELAY_MS;
+    if (pollAttempts > 0 && (now - lastPollTime) < pollInterval) {
+        return false;
+    }
+    lastPollTime = now;
+    pollAttempts++;
     
-    do {
-        int16_t error = scd4x.getDataReadyStatus(dataReady);
-        attempts++;
+    int16_t error = scd4x.getDataReadyStatus(dataReady);
+    if (error != NO_ERROR) {
+        dataReady = false;
+        communicationRetries++;
         
-        if (error != NO_ERROR) {
-            if (attempts < 5) {
-                Serial.printf("SCD-41 communication retry %d/5...\n", attempts);
-                delay(500);
-                continue;
-            } else {
-                setError("SCD-41 data ready check failed after retries: " + getErrorString(error));
-                return false;
-            }
+        if (communicationRetries < 5) {
+            Serial.printf("SCD-41 communication retry %d/5...\n", communicationRetries);
+            return false;
         }
         
-        if (!dataReady) {
-            delay(Config::SCD41_RETRY_DELAY_MS);
-        }
-    } while (!dataReady && attempts < Config::SCD41_RETRY_ATTEMPTS);
+        setError(ErrorCode::COMMUNICATION, "SCD-41 data ready check failed after retries: %s",
+                 getErrorString(error));
+        acquisitionFailed = true;
+        return true;
+    }
     
-    if (!dataReady) {
-        setError("SCD-41 data not ready after " + String(attempts) + " attempts");
-        return false;
+    if (dataReady) {
+        Serial.printf("✓ SCD-41 data ready after %d attempts\n", pollAttempts);
+        return true;
     }
     
-    Serial.printf("✓ SCD-41 data ready after %d attempts\n", attempts);
-    return true;
+    if (pollAttempts >= Config::SCD41_RETRY_ATTEMPTS) {
+        setError(ErrorCode::TIMEOUT, "SCD-41 data not ready after %d attempts", pollAttempts);
+        acquisitionFailed = true;
+        return true;
+    }
+    
+    return false;
 }
 
 void SCD41Sensor::scanI2CDevices() {
     Serial.println("=== I2C Device Scanner ===");
     byte error, address;
     int nDevices = 0;
+    uint8_t found[127];
     
     Serial.println("Scanning I2C addresses...");
     
@@ -198,7 +388,7 @@ void SCD41Sensor::scanI2CDevices() {
         
         if (error == 0) {
             Serial.printf("I2C device found at address 0x%02X\n", address);
-            nDevices++;
+            found[nDevices++] = address;
         }
     }
     
@@ -208,6 +398,8 @@ void SCD41Sensor::scanI2CDevices() {
         Serial.printf("Found %d I2C device(s)\n", nDevices);
     }
     Serial.println("========================");
+    
+    BusDiscoveryCache::storeI2CScan(found, nDevices);
 }
 
 bool SCD41Sensor::isValidCO2(uint16_t co2) const {
@@ -224,7 +416,7 @@ bool SCD41Sensor::isValidHumidity(float humidity) const {
            humidity >= MIN_VALID_HUMIDITY && humidity <= MAX_VALID_HUMIDITY;
 }
 
-String SCD41Sensor::getErrorString(int16_t error) const {
+const char* SCD41Sensor::getErrorString(int16_t error) const {
     errorToString(error, errorMessage, sizeof(errorMessage));
-    return String(errorMessage);
+    return errorMessage;
 }
\ No newline at end of file
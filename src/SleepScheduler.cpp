@@ -0,0 +1,202 @@
+#include "SleepScheduler.h"
+#include <stddef.h>
+#include <algorithm>
+#include "Crc32.h"
+#include "DeadbandFilter.h"
+
+namespace {
+
+constexpr uint32_t SCHEDULER_MAGIC = 0x534C5053; // "SLPS"
+constexpr size_t MAX_STREAMS = 12;
+
+struct Sample {
+    uint32_t time;          // ReadingBuffer clock
+    float value;
+};
+
+struct StreamHistory {
+    uint32_t locationHash;  // CRC32 of the location name
+    uint8_t kind;           // MeasurementKind
+    uint8_t head;           // Index of the oldest sample
+    uint8_t count;
+    Sample samples[Config::SLEEP_HISTORY_SAMPLES];
+};
+
+struct SchedulerState {
+    uint32_t magic;
+    uint32_t lastSleepSeconds;
+    uint8_t streamCount;
+    StreamHistory streams[MAX_STREAMS];
+    uint32_t crc;           // Must stay last
+};
+
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR SchedulerState state;
+
+uint32_t computeCrc() {
+    return crc32(&state, offsetof(SchedulerState, crc));
+}
+
+void ensureValid() {
+    if (state.magic != SCHEDULER_MAGIC || state.crc != computeCrc()) {
+        state = SchedulerState{};
+        state.magic = SCHEDULER_MAGIC;
+    }
+}
+
+StreamHistory* findStream(uint32_t locationHash, MeasurementKind kind) {
+    for (size_t i = 0; i < state.streamCount; i++) {
+        StreamHistory& stream = state.streams[i];
+        if (stream.locationHash == locationHash && stream.kind == static_cast<uint8_t>(kind)) {
+            return &stream;
+        }
+    }
+    if (state.streamCount == MAX_STREAMS) {
+        return nullptr;
+    }
+    StreamHistory& stream = state.streams[state.streamCount++];
+    stream.locationHash = locationHash;
+    stream.kind = static_cast<uint8_t>(kind);
+    return &stream;
+}
+
+SleepScheduler::Trend trendOf(const StreamHistory& stream) {
+    SleepScheduler::Trend trend{};
+    trend.kind = static_cast<MeasurementKind>(stream.kind);
+
+    const Sample& newest = stream.samples[(stream.head + stream.count - 1) % Config::SLEEP_HISTORY_SAMPLES];
+    trend.value = newest.value;
+    if (stream.count < 2) {
+        return trend;
+    }
+
+    // Least-squares slope, with time in hours relative to the newest sample
+    float meanT = 0.0f;
+    float meanV = 0.0f;
+    for (uint8_t i = 0; i < stream.count; i++) {
+        const Sample& sample = stream.samples[(stream.head + i) % Config::SLEEP_HISTORY_SAMPLES];
+        meanT += -static_cast<float>(newest.time - sample.time) / 3600.0f;
+        meanV += sample.value;
+    }
+    meanT /= stream.count;
+    meanV /= stream.count;
+
+    float covariance = 0.0f;
+    float variance = 0.0f;
+    for (uint8_t i = 0; i < stream.count; i++) {
+        const Sample& sample = stream.samples[(stream.head + i) % Config::SLEEP_HISTORY_SAMPLES];
+        float t = -static_cast<float>(newest.time - sample.time) / 3600.0f - meanT;
+        covariance += t * (sample.value - meanV);
+        variance += t * t;
+    }
+    trend.ratePerHour = variance > 0.0f ? covariance / variance : 0.0f;
+    return trend;
+}
+
+/**
+ * @brief Alert thresholds of a kind
+ * @return false if the kind has none
+ */
+bool alertBand(MeasurementKind kind, float& low, float& high, float& margin) {
+    switch (kind) {
+        case MeasurementKind::TEMPERATURE:
+            low = Config::DS18B20_ALERT_LOW_C;
+            high = Config::DS18B20_ALERT_HIGH_C;
+            margin = Config::DS18B20_ALERT_MARGIN_C;
+            return true;
+        case MeasurementKind::CO2:
+            low = -INFINITY;
+            high = Config::SLEEP_CO2_ALERT_PPM;
+            margin = Config::SLEEP_CO2_ALERT_MARGIN_PPM;
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+void SleepScheduler::record(const std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow) {
+    ensureValid();
+    for (const auto& point : points) {
+        StreamHistory* stream = findStream(crc32(point.location, strlen(point.location)), point.kind);
+        if (stream == nullptr) {
+            continue;
+        }
+
+        // Overwrite the oldest sample once the ring is full
+        size_t index = (stream->head + stream->count) % Config::SLEEP_HISTORY_SAMPLES;
+        if (stream->count == Config::SLEEP_HISTORY_SAMPLES) {
+            stream->head = (stream->head + 1) % Config::SLEEP_HISTORY_SAMPLES;
+        } else {
+            stream->count++;
+        }
+        stream->samples[index] = Sample{clockNow, point.value};
+    }
+    state.crc = computeCrc();
+}
+
+uint32_t SleepScheduler::nextSleepSeconds() {
+    ensureValid();
+
+    Trend trends[MAX_STREAMS];
+    size_t count = 0;
+    for (size_t i = 0; i < state.streamCount; i++) {
+        if (state.streams[i].count >= 2) {
+            trends[count++] = trendOf(state.streams[i]);
+        }
+    }
+
+    uint32_t sleepSeconds = computeSleepSeconds(trends, count, state.lastSleepSeconds);
+    if (sleepSeconds != state.lastSleepSeconds && state.lastSleepSeconds != 0) {
+        Serial.printf("Sleep interval %lu s -> %lu s\n",
+                     (unsigned long)state.lastSleepSeconds, (unsigned long)sleepSeconds);
+    }
+    state.lastSleepSeconds = sleepSeconds;
+    state.crc = computeCrc();
+    return sleepSeconds;
+}
+
+uint32_t SleepScheduler::computeSleepSeconds(const Trend* trends, size_t count, uint32_t previousSeconds) {
+    if (count == 0) {
+        return Config::SLEEP_DURATION_SECONDS;
+    }
+
+    float seconds = Config::SLEEP_MAX_SECONDS;
+    for (size_t i = 0; i < count; i++) {
+        const Trend& trend = trends[i];
+        float rate = fabsf(trend.ratePerHour);
+
+        // Sample about once per deadband of movement
+        float deadband = DeadbandFilter::getDeadband(trend.kind);
+        if (rate > 0.0f && deadband > 0.0f) {
+            seconds = std::min(seconds, deadband / rate * 3600.0f);
+        }
+
+        float low, high, margin;
+        if (!alertBand(trend.kind, low, high, margin)) {
+            continue;
+        }
+        if (trend.value <= low + margin || trend.value >= high - margin) {
+            seconds = Config::SLEEP_MIN_SECONDS;
+            continue;
+        }
+
+        // Wake at least twice before a threshold is reached
+        float distance = trend.ratePerHour > 0.0f ? high - margin - trend.value
+                                                  : trend.value - (low + margin);
+        if (rate > 0.0f) {
+            seconds = std::min(seconds, distance / rate * 3600.0f / 2.0f);
+        }
+    }
+
+    uint32_t result = static_cast<uint32_t>(std::max(seconds, 0.0f));
+    result = std::min<uint32_t>(result, previousSeconds != 0 ? previousSeconds * 2 : Config::SLEEP_DURATION_SECONDS);
+    return std::max(Config::SLEEP_MIN_SECONDS, std::min(Config::SLEEP_MAX_SECONDS, result));
+}
+
+#ifdef NATIVE_BUILD
+void SleepScheduler::reset() {
+    state = SchedulerState{};
+}
+#endif
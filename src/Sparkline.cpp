@@ -0,0 +1,124 @@
+#include "Sparkline.h"
+#include <algorithm>
+#include "ReadingHistory.h"
+
+Sparkline::Sparkline(uint8_t x, uint8_t tileRow, uint8_t width, uint8_t tileRows)
+    : x(x), tileRow(tileRow), width(width < MAX_WIDTH ? width : MAX_WIDTH),
+      tileRows(tileRows < MAX_TILE_ROWS ? tileRows : MAX_TILE_ROWS),
+      drawn(false), changed(false), drawnCount(0), scaleMin(0), scaleMax(0), lastY(-1) {
+    memset(columns, 0, sizeof(columns));
+}
+
+int8_t Sparkline::toPixelRow(int16_t sample) const {
+    if (sample == ReadingHistory::NO_SAMPLE) {
+        return -1;
+    }
+    // Highest value on the top pixel row
+    int32_t height = tileRows * 8 - 1;
+    int32_t offset = static_cast<int32_t>(scaleMax) - sample;
+    return static_cast<int8_t>(offset * height / (scaleMax - scaleMin));
+}
+
+void Sparkline::drawColumn(uint8_t column, int8_t y, int8_t previousY) {
+    for (uint8_t row = 0; row < tileRows; row++) {
+        columns[row][column] = 0;
+    }
+    if (y < 0) {
+        return;
+    }
+
+    // Join to the previous column with a vertical run so steps stay visible
+    int8_t top = y;
+    int8_t bottom = y;
+    if (previousY >= 0) {
+        top = std::min(y, previousY);
+        bottom = std::max(y, previousY);
+    }
+    for (int8_t pixel = top; pixel <= bottom; pixel++) {
+        columns[pixel / 8][column] |= 1 << (pixel % 8);
+    }
+}
+
+void Sparkline::redraw(const int16_t* samples, size_t count) {
+    if (count > width) {
+        samples += count - width;
+        count = width;
+    }
+
+    int16_t low = INT16_MAX;
+    int16_t high = INT16_MIN;
+    for (size_t i = 0; i < count; i++) {
+        if (samples[i] == ReadingHistory::NO_SAMPLE) {
+            continue;
+        }
+        low = std::min(low, samples[i]);
+        high = std::max(high, samples[i]);
+    }
+    if (high == INT16_MIN) {
+        low = 0;
+        high = 0;
+    }
+
+    // Pad to the minimum span around the data
+    int32_t missing = MIN_SPAN - (static_cast<int32_t>(high) - low);
+    if (missing > 0) {
+        low = static_cast<int16_t>(std::max<int32_t>(INT16_MIN + 1, low - (missing + 1) / 2));
+        high = static_cast<int16_t>(std::min<int32_t>(INT16_MAX, high + missing / 2));
+    }
+    scaleMin = low;
+    scaleMax = high;
+
+    // Right-aligned: the newest sample is always in the last column
+    memset(columns, 0, sizeof(columns));
+    size_t first = width - count;
+    lastY = -1;
+    for (size_t i = 0; i < count; i++) {
+        int8_t y = toPixelRow(samples[i]);
+        drawColumn(first + i, y, lastY);
+        lastY = y;
+    }
+}
+
+void Sparkline::update(const int16_t* samples, size_t count, uint32_t closedCount) {
+    if (drawn && closedCount == drawnCount) {
+        return;
+    }
+
+    int16_t newest = count > 0 ? samples[count - 1] : ReadingHistory::NO_SAMPLE;
+    bool fits = newest == ReadingHistory::NO_SAMPLE || (newest >= scaleMin && newest <= scaleMax);
+    if (drawn && closedCount == drawnCount + 1 && fits) {
+        // One new sample: scroll by one column and draw only that column
+        for (uint8_t row = 0; row < tileRows; row++) {
+            memmove(columns[row], columns[row] + 1, width - 1);
+        }
+        int8_t y = toPixelRow(newest);
+        drawColumn(width - 1, y, lastY);
+        lastY = y;
+    } else {
+        redraw(samples, count);
+    }
+
+    drawn = true;
+    drawnCount = closedCount;
+    changed = true;
+}
+
+void Sparkline::draw(U8G2& display) const {
+    // A page buffer holds only some tile rows; copy the ones it covers
+    uint8_t* buffer = display.getBufferPtr();
+    size_t bufferWidth = display.getBufferTileWidth() * 8;
+    int firstRow = display.getBufferCurrTileRow();
+    int bufferRows = display.getBufferTileHeight();
+
+    for (uint8_t row = 0; row < tileRows; row++) {
+        int bufferRow = tileRow + row - firstRow;
+        if (bufferRow < 0 || bufferRow >= bufferRows) {
+            continue;
+        }
+        uint8_t* target = buffer + bufferRow * bufferWidth + x;
+        size_t length = std::min<size_t>(width, bufferWidth > x ? bufferWidth - x : 0);
+        for (size_t column = 0; column < length; column++) {
+            target[column] |= columns[row][column];
+        }
+    }
+}
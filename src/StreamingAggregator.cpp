@@ -0,0 +1,184 @@
+#include "StreamingAggregator.h"
+#include <stddef.h>
+#include <algorithm>
+#include "Crc32.h"
+
+namespace {
+
+constexpr uint32_t AGGREGATOR_MAGIC = 0x41474752; // "AGGR"
+constexpr size_t MAX_LOCATIONS = 8;
+constexpr size_t MAX_LOCATION_LENGTH = 24;
+constexpr size_t MAX_STREAMS = 12;
+
+struct Window {
+    uint8_t locationIndex;
+    uint8_t kind;           // MeasurementKind
+    uint16_t count;
+    float mean;
+    float m2;               // Sum of squared differences from the mean
+    float min;
+    float max;
+    float last;
+    uint32_t firstTime;     // ReadingBuffer clock
+    uint32_t lastTime;
+};
+
+struct AggregatorStorage {
+    uint32_t magic;
+    uint8_t locationCount;
+    uint8_t streamCount;
+    uint16_t pendingHead;   // Index of the oldest closed window
+    uint16_t pendingCount;
+    uint32_t droppedCount;
+    char locations[MAX_LOCATIONS][MAX_LOCATION_LENGTH];
+    Window streams[MAX_STREAMS];
+    Window pending[Config::AGGREGATE_PENDING_CAPACITY];
+    uint32_t crc;           // Must stay last
+};
+
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR AggregatorStorage storage;
+
+uint32_t computeCrc() {
+    return crc32(&storage, offsetof(AggregatorStorage, crc));
+}
+
+void ensureValid() {
+    if (storage.magic != AGGREGATOR_MAGIC || storage.crc != computeCrc()) {
+        storage = AggregatorStorage{};
+        storage.magic = AGGREGATOR_MAGIC;
+    }
+}
+
+int findOrAddLocation(const char* location) {
+    if (strlen(location) >= MAX_LOCATION_LENGTH) {
+        return -1;
+    }
+    for (size_t i = 0; i < storage.locationCount; i++) {
+        if (strcmp(location, storage.locations[i]) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    if (storage.locationCount == MAX_LOCATIONS) {
+        return -1;
+    }
+    strncpy(storage.locations[storage.locationCount], location, MAX_LOCATION_LENGTH - 1);
+    return storage.locationCount++;
+}
+
+Window* findStream(uint8_t locationIndex, MeasurementKind kind) {
+    for (size_t i = 0; i < storage.streamCount; i++) {
+        Window& window = storage.streams[i];
+        if (window.locationIndex == locationIndex && window.kind == static_cast<uint8_t>(kind)) {
+            return &window;
+        }
+    }
+    if (storage.streamCount == MAX_STREAMS) {
+        return nullptr;
+    }
+    Window& window = storage.streams[storage.streamCount++];
+    window = Window{};
+    window.locationIndex = locationIndex;
+    window.kind = static_cast<uint8_t>(kind);
+    return &window;
+}
+
+void closeWindow(Window& window) {
+    // Overwrite the oldest closed window once the ring is full
+    size_t index = (storage.pendingHead + storage.pendingCount) % Config::AGGREGATE_PENDING_CAPACITY;
+    if (storage.pendingCount == Config::AGGREGATE_PENDING_CAPACITY) {
+        storage.pendingHead = (storage.pendingHead + 1) % Config::AGGREGATE_PENDING_CAPACITY;
+        storage.droppedCount++;
+    } else {
+        storage.pendingCount++;
+    }
+    storage.pending[index] = window;
+    window.count = 0;
+}
+
+void addSample(Window& window, float value, uint32_t clockNow) {
+    if (window.count == 0) {
+        window.mean = 0.0f;
+        window.m2 = 0.0f;
+        window.min = value;
+        window.max = value;
+        window.firstTime = clockNow;
+    }
+
+    // Welford: numerically stable without keeping the samples
+    window.count++;
+    float delta = value - window.mean;
+    window.mean += delta / window.count;
+    window.m2 += delta * (value - window.mean);
+
+    window.min = std::min(window.min, value);
+    window.max = std::max(window.max, value);
+    window.last = value;
+    window.lastTime = clockNow;
+}
+
+} // namespace
+
+void StreamingAggregator::add(const std::vector<IDataPublisher::DataPoint>& points, uint32_t clockNow) {
+    ensureValid();
+    for (const auto& point : points) {
+        int locationIndex = findOrAddLocation(point.location);
+        Window* window = locationIndex >= 0 ? findStream(static_cast<uint8_t>(locationIndex), point.kind)
+                                            : nullptr;
+        if (window == nullptr) {
+            continue;
+        }
+
+        if (window->count > 0 && clockNow - window->firstTime >= Config::AGGREGATE_WINDOW_SECONDS) {
+            closeWindow(*window);
+        }
+        addSample(*window, point.value, clockNow);
+    }
+    storage.crc = computeCrc();
+}
+
+size_t StreamingAggregator::getPendingCount() {
+    ensureValid();
+    return storage.pendingCount;
+}
+
+bool StreamingAggregator::isUploadDue() {
+    return getPendingCount() >= Config::AGGREGATE_UPLOAD_MIN_WINDOWS;
+}
+
+std::vector<IDataPublisher::Aggregate> StreamingAggregator::getPending(uint32_t utcNow, uint32_t clockNow) {
+    ensureValid();
+    std::vector<IDataPublisher::Aggregate> aggregates;
+    aggregates.reserve(storage.pendingCount);
+
+    for (size_t i = 0; i < storage.pendingCount; i++) {
+        const Window& window = storage.pending[(storage.pendingHead + i) % Config::AGGREGATE_PENDING_CAPACITY];
+
+        IDataPublisher::Aggregate aggregate{};
+        aggregate.location = storage.locations[window.locationIndex];
+        aggregate.kind = static_cast<MeasurementKind>(window.kind);
+        aggregate.count = window.count;
+        aggregate.mean = window.mean;
+        aggregate.stddev = window.count > 1 ? sqrtf(window.m2 / (window.count - 1)) : 0.0f;
+        aggregate.min = window.min;
+        aggregate.max = window.max;
+        aggregate.last = window.last;
+        aggregate.windowStart = utcNow != 0 ? utcNow - (clockNow - window.firstTime) : 0;
+        aggregate.windowEnd = utcNow != 0 ? utcNow - (clockNow - window.lastTime) : 0;
+        aggregates.push_back(aggregate);
+    }
+
+    if (storage.droppedCount > 0) {
+        Serial.printf("⚠ %lu aggregate windows were overwritten before upload\n",
+                     (unsigned long)storage.droppedCount);
+    }
+    return aggregates;
+}
+
+void StreamingAggregator::clearPending() {
+    ensureValid();
+    storage.pendingHead = 0;
+    storage.pendingCount = 0;
+    storage.droppedCount = 0;
+    storage.crc = computeCrc();
+}
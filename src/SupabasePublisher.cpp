@@ -1,5 +1,6 @@
 #include "SupabasePublisher.h"
 #include <WiFi.h>
+#include <time.h>
 
 SupabasePublisher::SupabasePublisher(const String& url, const String& apiKey, const String& tableName)
     : url(url), apiKey(apiKey), tableName(tableName), initialized(false) {
@@ -13,7 +14,7 @@ bool SupabasePublisher::initialize() {
         return false;
     }
     
-    if (!isReady()) {
+    if (WiFi.status() != WL_CONNECTED) {
         setError("WiFi not connected - cannot initialize Supabase");
         return false;
     }
@@ -39,6 +40,10 @@ bool SupabasePublisher::isReady() const {
 }
 
 IDataPublisher::PublishResult SupabasePublisher::publish(const String& location, const String& type, float value) {
+    return publishRow(tableName, createPayload(location, type.c_str(), value));
+}
+
+IDataPublisher::PublishResult SupabasePublisher::publishRow(const String& table, const String& json) {
     PublishResult result;
     
     if (!isReady()) {
@@ -47,10 +52,9 @@ IDataPublisher::PublishResult SupabasePublisher::publish(const String& location,
         return result;
     }
     
-    String payload = createPayload(location, type, value);
-    Serial.printf("Publishing to Supabase: %s\n", payload.c_str());
+    Serial.printf("Publishing to Supabase (%s): %s\n", table.c_str(), json.c_str());
     
-    int response = supabase.insert(tableName, payload, false);
+    int response = supabase.insert(table, json, false);
     result.responseCode = response;
     
     if (isSuccessResponse(response)) {
@@ -66,43 +70,101 @@ IDataPublisher::PublishResult SupabasePublisher::publish(const String& location,
 }
 
 int SupabasePublisher::publishBatch(const String& sensorName, const String& location, 
-                                   const std::vector<ISensor::Reading>& readings,
-                                   const std::vector<String>& dataTypes) {
-    if (readings.size() != dataTypes.size()) {
-        setError("Mismatch between readings count and data types count");
+                                   const ISensor::Readings& readings) {
+    std::vector<DataPoint> points;
+    appendDataPoints(points, location.c_str(), readings);
+    int successCount = publishCycle(points);
+    
+    Serial.printf("Published %d/%d readings from %s sensor\n", 
+                 successCount, (int)readings.size(), sensorName.c_str());
+    
+    return successCount;
+}
+
+int SupabasePublisher::publishCycle(std::vector<DataPoint>& points) {
+    if (points.empty()) {
         return 0;
     }
     
-    int successCount = 0;
+    String payload = "[";
+    for (size_t i = 0; i < points.size(); i++) {
+        if (i > 0) {
+            payload += ", ";
+        }
+        payload += createPayload(points[i].location, measurementName(points[i].kind), points[i].value,
+                                 points[i].timestamp);
+    }
+    payload += "]";
     
-    for (size_t i = 0; i < readings.size(); i++) {
-        const auto& reading = readings[i];
-        
-        // Only publish successful readings
-        if (reading.status == ISensor::Status::SUCCESS) {
-            PublishResult result = publish(location, dataTypes[i], reading.value);
-            if (result.success) {
-                successCount++;
-            }
-            
-            // Add delay between requests to avoid overwhelming the server
-            delay(1000);
-        } else {
-            Serial.printf("⚠ Skipping invalid %s reading: %s\n", 
-                         dataTypes[i].c_str(), reading.errorMessage.c_str());
+    // The bulk insert is atomic, so one response code covers every row
+    PublishResult result = publishRow(tableName, payload);
+    for (auto& point : points) {
+        point.published = result.success;
+    }
+    
+    return result.success ? (int)points.size() : 0;
+}
+
+int SupabasePublisher::publishAggregates(const String& table, std::vector<Aggregate>& aggregates) {
+    if (aggregates.empty()) {
+        return 0;
+    }
+    
+    String payload = "[";
+    for (size_t i = 0; i < aggregates.size(); i++) {
+        if (i > 0) {
+            payload += ", ";
         }
+        payload += createAggregatePayload(aggregates[i]);
     }
+    payload += "]";
     
-    Serial.printf("Published %d/%d readings from %s sensor\n", 
-                 successCount, (int)readings.size(), sensorName.c_str());
+    PublishResult result = publishRow(table, payload);
+    for (auto& aggregate : aggregates) {
+        aggregate.published = result.success;
+    }
     
-    return successCount;
+    return result.success ? (int)aggregates.size() : 0;
+}
+
+String SupabasePublisher::createPayload(const String& location, const char* type, float value,
+                                        uint32_t timestamp) const {
+    String payload = "{\"location\": \"" + location + 
+                     "\", \"type\": \"" + type + 
+                     "\", \"value\": " + String(value, 2);
+    
+    if (timestamp != 0) {
+        payload += ", \"created_at\": \"" + formatTimestamp(timestamp) + "\"";
+    }
+    
+    return payload + "}";
+}
+
+String SupabasePublisher::createAggregatePayload(const Aggregate& aggregate) const {
+    String payload = "{\"location\": \"" + String(aggregate.location) +
+                     "\", \"type\": \"" + measurementName(aggregate.kind) +
+                     "\", \"count\": " + String(aggregate.count) +
+                     ", \"mean\": " + String(aggregate.mean, 2) +
+                     ", \"stddev\": " + String(aggregate.stddev, 2) +
+                     ", \"min\": " + String(aggregate.min, 2) +
+                     ", \"max\": " + String(aggregate.max, 2) +
+                     ", \"last\": " + String(aggregate.last, 2);
+    
+    if (aggregate.windowStart != 0) {
+        payload += ", \"window_start\": \"" + formatTimestamp(aggregate.windowStart) +
+                   "\", \"window_end\": \"" + formatTimestamp(aggregate.windowEnd) + "\"";
+    }
+    
+    return payload + "}";
 }
 
-String SupabasePublisher::createPayload(const String& location, const String& type, float value) const {
-    return "{\"location\": \"" + location + 
-           "\", \"type\": \"" + type + 
-           "\", \"value\": " + String(value, 2) + "}";
+String SupabasePublisher::formatTimestamp(uint32_t timestamp) {
+    time_t seconds = static_cast<time_t>(timestamp);
+    struct tm utc;
+    char formatted[24];
+    gmtime_r(&seconds, &utc);
+    strftime(formatted, sizeof(formatted), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return String(formatted);
 }
 
 bool SupabasePublisher::isSuccessResponse(int responseCode) const {
@@ -0,0 +1,120 @@
+#include "WakeProfiler.h"
+
+namespace {
+
+constexpr uint32_t PROFILER_MAGIC = 0x57414B45; // "WAKE"
+constexpr size_t PHASE_COUNT = static_cast<size_t>(WakeProfiler::Phase::COUNT);
+
+struct ProfilerStorage {
+    uint32_t magic;
+    uint32_t windowStart;   // ReadingBuffer clock
+    uint32_t wakeCount;
+    uint32_t pendingAwakeMs;    // Previous wake's AWAKE_TOTAL, 0 once recorded
+    WakeProfiler::PhaseStats phases[PHASE_COUNT];
+};
+
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR ProfilerStorage storage;
+
+const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "sensor_init",
+    "dht11_read",
+    "ds18b20_read",
+    "scd41_read",
+    "wifi_connect",
+    "publisher_init",
+    "publish",
+    "awake_total"
+};
+
+} // namespace
+
+void WakeProfiler::beginWake(uint32_t clockNow) {
+    if (storage.magic != PROFILER_MAGIC) {
+        reset(clockNow);
+    }
+    storage.wakeCount++;
+
+    if (storage.pendingAwakeMs > 0) {
+        record(Phase::AWAKE_TOTAL, storage.pendingAwakeMs);
+        storage.pendingAwakeMs = 0;
+    }
+}
+
+void WakeProfiler::endWake(uint32_t awakeMs) {
+    storage.pendingAwakeMs = awakeMs;
+}
+
+void WakeProfiler::record(Phase phase, uint32_t durationMs) {
+    PhaseStats& stats = storage.phases[static_cast<size_t>(phase)];
+
+    if (stats.count == 0 || durationMs < stats.minMs) {
+        stats.minMs = durationMs;
+    }
+    if (durationMs > stats.maxMs) {
+        stats.maxMs = durationMs;
+    }
+    stats.totalMs += durationMs;
+    stats.count++;
+}
+
+const WakeProfiler::PhaseStats& WakeProfiler::getStats(Phase phase) {
+    return storage.phases[static_cast<size_t>(phase)];
+}
+
+const char* WakeProfiler::getPhaseName(Phase phase) {
+    size_t index = static_cast<size_t>(phase);
+    return index < PHASE_COUNT ? PHASE_NAMES[index] : "unknown";
+}
+
+uint32_t WakeProfiler::getWakeCount() {
+    return storage.wakeCount;
+}
+
+bool WakeProfiler::isSummaryDue(uint32_t clockNow) {
+    // A clock behind the window start was reset by a power loss
+    return clockNow < storage.windowStart ||
+           clockNow - storage.windowStart >= Config::PROFILER_SUMMARY_INTERVAL_SECONDS;
+}
+
+String WakeProfiler::createSummaryPayload(const String& deviceId) {
+    String payload = "{\"device_id\": \"" + deviceId +
+                     "\", \"wake_count\": " + String(storage.wakeCount) +
+                     ", \"phases\": {";
+
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        const PhaseStats& stats = storage.phases[i];
+        if (i > 0) {
+            payload += ", ";
+        }
+        payload += "\"" + String(PHASE_NAMES[i]) + "\": {" +
+                   "\"count\": " + String(stats.count) +
+                   ", \"min_ms\": " + String(stats.minMs) +
+                   ", \"mean_ms\": " + String(stats.meanMs()) +
+                   ", \"max_ms\": " + String(stats.maxMs) + "}";
+    }
+
+    payload += "}}";
+    return payload;
+}
+
+void WakeProfiler::printSummary() {
+    Serial.printf("=== Wake Profile (%lu wakes) ===\n", (unsigned long)storage.wakeCount);
+    Serial.println("Phase            count   min ms  mean ms   max ms");
+
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+        const PhaseStats& stats = storage.phases[i];
+        if (stats.count == 0) {
+            continue;
+        }
+        Serial.printf("%-15s %6lu %8lu %8lu %8lu\n", PHASE_NAMES[i],
+                     (unsigned long)stats.count, (unsigned long)stats.minMs,
+                     (unsigned long)stats.meanMs(), (unsigned long)stats.maxMs);
+    }
+}
+
+void WakeProfiler::reset(uint32_t clockNow) {
+    storage = ProfilerStorage{};
+    storage.magic = PROFILER_MAGIC;
+    storage.windowStart = clockNow;
+}
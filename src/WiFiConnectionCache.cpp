@@ -0,0 +1,57 @@
+#include "WiFiConnectionCache.h"
+#include <stddef.h>
+#include <string.h>
+#include "Crc32.h"
+
+namespace {
+constexpr uint32_t CACHE_MAGIC = 0x57494649; // "WIFI"
+}
+
+bool WiFiConnectionCache::isUsableFor(const char* ssid) const {
+    return record.magic == CACHE_MAGIC &&
+           record.crc == computeCrc() &&
+           record.ssidHash == hashSsid(ssid) &&
+           record.channel != 0 &&
+           record.localIP != 0 &&
+           record.reuseCount < Config::WIFI_CACHE_MAX_REUSES;
+}
+
+void WiFiConnectionCache::store(const char* ssid, const uint8_t* bssid, int32_t channel,
+                                uint32_t localIP, uint32_t gateway, uint32_t subnet, uint32_t dns) {
+    if (bssid == nullptr || channel <= 0 || localIP == 0) {
+        invalidate();
+        return;
+    }
+
+    record = Record{};
+    record.magic = CACHE_MAGIC;
+    record.ssidHash = hashSsid(ssid);
+    memcpy(record.bssid, bssid, sizeof(record.bssid));
+    record.channel = static_cast<uint8_t>(channel);
+    record.localIP = localIP;
+    record.gateway = gateway;
+    record.subnet = subnet;
+    record.dns = dns;
+    seal();
+}
+
+void WiFiConnectionCache::markReused() {
+    record.reuseCount++;
+    seal();
+}
+
+void WiFiConnectionCache::invalidate() {
+    record = Record{};
+}
+
+uint32_t WiFiConnectionCache::hashSsid(const char* ssid) {
+    return crc32(ssid, strlen(ssid));
+}
+
+uint32_t WiFiConnectionCache::computeCrc() const {
+    return crc32(&record, offsetof(Record, crc));
+}
+
+void WiFiConnectionCache::seal() {
+    record.crc = computeCrc();
+}
@@ -1,24 +1,66 @@
 #include "WiFiManager.h"
+#include <time.h>
+
+namespace {
+// Survives deep sleep; zeroed on power-on
+RTC_DATA_ATTR WiFiConnectionCache::Record cachedConnection;
+}
+
+WiFiManager::WiFiManager() : cache(cachedConnection) {
+}
 
 WiFiManager::~WiFiManager() {
     disconnect();
 }
 
-bool WiFiManager::connect(const char* ssid, const char* password, uint32_t timeoutMs) {
+void WiFiManager::begin(const char* ssid, const char* password) {
     Serial.println("=== WiFi Connection ===");
-    Serial.printf("Connecting to: %s\n", ssid);
+    Serial.printf("Connecting to: %s (in background)\n", ssid);
     
+    this->ssid = ssid;
+    this->password = password;
     connectionStartTime = millis();
+    connectionStarted = true;
+    usingCachedConnection = cache.isUsableFor(ssid);
     
-    WiFi.begin(ssid, password);
+    WiFi.mode(WIFI_STA);
+    
+    if (usingCachedConnection) {
+        const auto& cached = cache.get();
+        Serial.printf("Fast reconnect: channel %d, IP %s\n", 
+                     cached.channel, IPAddress(cached.localIP).toString().c_str());
+        WiFi.config(IPAddress(cached.localIP), IPAddress(cached.gateway),
+                    IPAddress(cached.subnet), IPAddress(cached.dns));
+        WiFi.begin(ssid, password, cached.channel, cached.bssid);
+    } else {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress());
+        WiFi.begin(ssid, password);
+    }
+}
+
+bool WiFiManager::waitUntilConnected(uint32_t timeoutMs) {
+    if (!connectionStarted) {
+        setError("WiFi connection was not started");
+        return false;
+    }
+    
+    unsigned long waitStartTime = millis();
     
     while (WiFi.status() != WL_CONNECTED && (millis() - connectionStartTime) < timeoutMs) {
-        delay(Config::WIFI_RETRY_DELAY_MS);
-        Serial.print(".");
+        if (usingCachedConnection) {
+            wl_status_t status = WiFi.status();
+            if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL ||
+                (millis() - connectionStartTime) >= Config::WIFI_FAST_CONNECT_TIMEOUT_MS) {
+                fallBackToFullConnect();
+            }
+        }
+        delay(Config::WIFI_POLL_INTERVAL_MS);
     }
     
     if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\n✓ WiFi connected successfully!");
+        Serial.printf("✓ WiFi connected after %lu ms (waited %lu ms)\n",
+                     millis() - connectionStartTime, millis() - waitStartTime);
+        updateCache();
         printConnectionInfo();
         lastError = "";
         return true;
@@ -28,6 +70,48 @@ bool WiFiManager::connect(const char* ssid, const char* password, uint32_t timeo
     }
 }
 
+bool WiFiManager::connect(const char* ssid, const char* password, uint32_t timeoutMs) {
+    begin(ssid, password);
+    return waitUntilConnected(timeoutMs);
+}
+
+void WiFiManager::fallBackToFullConnect() {
+    Serial.println("⚠ Fast reconnect failed - falling back to full connect");
+    cache.invalidate();
+    usingCachedConnection = false;
+    
+    // Drop the cached static IP so the full connect runs DHCP again
+    WiFi.disconnect();
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    WiFi.begin(ssid.c_str(), password.c_str());
+}
+
+void WiFiManager::updateCache() {
+    if (usingCachedConnection) {
+        cache.markReused();
+        return;
+    }
+    
+    cache.store(ssid.c_str(), WiFi.BSSID(), WiFi.channel(),
+                WiFi.localIP(), WiFi.gatewayIP(), WiFi.subnetMask(), WiFi.dnsIP(0));
+}
+
+void WiFiManager::startTimeSync() {
+    // UTC offsets keep mktime() in getUtcTime() a plain epoch conversion
+    configTime(0, 0, Config::NTP_SERVER);
+}
+
+bool WiFiManager::getUtcTime(uint32_t& epochSeconds, uint32_t timeoutMs) {
+    struct tm timeInfo;
+    if (!getLocalTime(&timeInfo, timeoutMs)) {
+        setError("SNTP time not available after " + String(timeoutMs) + "ms");
+        return false;
+    }
+    
+    epochSeconds = static_cast<uint32_t>(mktime(&timeInfo));
+    return true;
+}
+
 void WiFiManager::disconnect() {
     if (WiFi.status() == WL_CONNECTED) {
         Serial.println("Disconnecting WiFi...");
@@ -2,13 +2,19 @@
 
 
 #include <Arduino.h>
+#include <algorithm>
 #include <WiFi.h>
 #include <ESPSupabase.h>
 #include <U8g2lib.h>
 #include <Wire.h>
-#include <ArduinoJson.h>
 #include <esp_wifi.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
 #include "credentials.h"
+#include "WiFiManager.h"
+#include "LatestReadingClient.h"
+#include "OledScreen.h"
+#include "ReadingHistory.h"
 
 // ========== DISPLAY CONFIGURATION ==========
 #define SDA_PIN 5
@@ -17,26 +23,61 @@
 // ========== BOOT BUTTON CONFIGURATION ==========
 #define BOOT_BUTTON_PIN 9  // GPIO9 is the boot button on ESP32-C3
 
+// Define to use a one tile row page buffer (72 bytes) instead of the full
+// 360-byte frame; changed rows are then sent whole rather than per tile
+// #define OLED_PAGE_BUFFER
+
 // Setup U8g2 display object for ESP32-C3 OLED (72x40)
+#ifdef OLED_PAGE_BUFFER
+U8G2_SSD1306_72X40_ER_1_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
+#else
 U8G2_SSD1306_72X40_ER_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
+#endif
+
+// Only the tiles of fields that changed are sent on each update
+OledScreen screen(u8g2);
+
+enum ReadingField { HEADER_FIELD, WIFI_FIELD, VALUE_FIELD, UNIT_FIELD, AGE_FIELD };
+const OledScreen::Field READING_LAYOUT[] = {
+  {0, 8, 60, u8g2_font_6x10_tf},          // Location header
+  {60, 8, 12, u8g2_font_5x7_tr},          // WiFi status
+  {0, 28, 48, u8g2_font_logisoso18_tf},   // Temperature
+  {50, 22, 8, u8g2_font_6x10_tf},         // Unit
+  {52, 40, 20, u8g2_font_5x7_tr},         // Age of the reading
+};
+
+// Last 12 hours of the local history (one 15-minute slot per column) along
+// the bottom tile row, next to the age
+#define HISTORY_GRAPH_WIDTH 48
+Sparkline historyGraph(0, 4, HISTORY_GRAPH_WIDTH);
 
 // ========== POWER-EFFICIENT CONFIGURATION ==========
 #define WIFI_CONNECT_TIMEOUT 15000     // Reduce WiFi timeout to 15 seconds
 #define DATA_UPDATE_INTERVAL 300000    // Update data every 5 minutes (300,000ms)
-#define DISPLAY_UPDATE_INTERVAL 30000  // Update display every 30 seconds
+#define DISPLAY_UPDATE_INTERVAL 60000  // Update display every minute (the age is shown in minutes)
 #define BUTTON_DEBOUNCE_TIME 200       // Button debounce time in ms
 
-// ========== SUPABASE OBJECTS ==========
+// Light sleep between events: the SSD1306 keeps showing its own frame
+// buffer, the MCU wakes on the refresh timer or the boot button. GPIO9 is
+// not a deep sleep wake source on the ESP32-C3 (only GPIO0-5 are), so deep
+// sleep would lose the display toggle.
+#define LIGHT_SLEEP_ENABLED true
+
+// ========== NETWORK OBJECTS ==========
 Supabase supabase;
+WiFiManager wifiManager;
+LatestReadingClient foodStorageTemperature(supabase, "environment_measurements", "food_storage", "temperature");
 
 // ========== STATE VARIABLES ==========
+// Light sleep keeps RAM, so plain globals carry the state between events
 float lastTemperature = -999.0;
-unsigned long lastDataUpdate = 0;
+bool displayOn = true;
+int updateCount = 0;
+unsigned long lastDataUpdate = 0;     // Last time a new reading arrived
+unsigned long lastDataPoll = 0;
 unsigned long lastDisplayUpdate = 0;
 unsigned long lastButtonPress = 0;
-bool displayOn = true;
 bool wifiConnected = false;
-int updateCount = 0;
 String lastUpdateTime = "";
 
 // ========== FUNCTION DECLARATIONS ==========
@@ -46,9 +87,11 @@ void setupBootButton();
 bool checkBootButton();
 bool setupWiFi();
 void updateDisplay();
-float queryLatestTemperature();
 void updateTemperatureData();
 void printSystemInfo();
+void setupLightSleep();
+void refreshData();
+void sleepUntilNextEvent();
 
 // ========== POWER MANAGEMENT ==========
 void setupPowerSaving() {
@@ -61,18 +104,49 @@ void setupPowerSaving() {
   Serial.println("Power saving configured: CPU 80MHz, WiFi sleep enabled");
 }
 
+void setupLightSleep() {
+  // Level wake-up: the button pulls GPIO9 low while pressed
+  gpio_wakeup_enable((gpio_num_t)BOOT_BUTTON_PIN, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  Serial.println("Light sleep configured: wake on timer or boot button");
+}
+
+void sleepUntilNextEvent() {
+  // A held button would end the level-triggered sleep at once
+  while (digitalRead(BOOT_BUTTON_PIN) == LOW) {
+    delay(10);
+  }
+  
+  unsigned long now = millis();
+  unsigned long untilPoll = DATA_UPDATE_INTERVAL - std::min<unsigned long>(now - lastDataPoll, DATA_UPDATE_INTERVAL);
+  unsigned long sleepMs = untilPoll;
+  if (displayOn) {
+    unsigned long untilDisplay = DISPLAY_UPDATE_INTERVAL -
+                                 std::min<unsigned long>(now - lastDisplayUpdate, DISPLAY_UPDATE_INTERVAL);
+    sleepMs = std::min(sleepMs, untilDisplay);
+  }
+  if (sleepMs == 0) {
+    return;
+  }
+  
+  // The radio only runs for data refreshes
+  if (wifiConnected) {
+    wifiManager.disconnect();
+    wifiConnected = false;
+  }
+  
+  Serial.flush();
+  esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+  esp_light_sleep_start();
+}
+
 void initializeDisplay() {
   Serial.println("Initializing OLED display...");
   Wire.begin(SDA_PIN, SCL_PIN);
   u8g2.begin();
   
   // Show startup message
-  u8g2.clearBuffer();
-  u8g2.setFont(u8g2_font_6x10_tf);
-  u8g2.drawStr(0, 10, "Food Storage");
-  u8g2.drawStr(0, 20, "Monitor v2");
-  u8g2.drawStr(0, 30, "Starting...");
-  u8g2.sendBuffer();
+  screen.showMessage("Food Storage", "Monitor v2", "Starting...");
   delay(2000);
 }
 
@@ -94,8 +168,7 @@ bool checkBootButton() {
         // Immediately update display
         updateDisplay();
       } else {
-        u8g2.clearBuffer();
-        u8g2.sendBuffer();
+        screen.clear();
         u8g2.setPowerSave(1); // Turn display off
         Serial.println("Display turned OFF");
       }
@@ -111,92 +184,18 @@ bool setupWiFi() {
   Serial.printf("SSID: %s\n", WIFI_SSID);
   Serial.printf("Password length: %d\n", strlen(WIFI_PASSWORD));
   
-  // Disconnect any previous connection and clear stored credentials
-  WiFi.disconnect(true);
-  delay(1000);
-  
   // Set WiFi mode and disable power saving during connection
   WiFi.mode(WIFI_STA);
   WiFi.setSleep(false); // Disable sleep during connection attempt
   
-  Serial.println("Scanning for available networks...");
-  int n = WiFi.scanNetworks();
-  if (n == 0) {
-    Serial.println("No networks found!");
-  } else {
-    Serial.printf("Found %d networks:\n", n);
-    bool ssidFound = false;
-    for (int i = 0; i < n; ++i) {
-      String ssid = WiFi.SSID(i);
-      int32_t rssi = WiFi.RSSI(i);
-      wifi_auth_mode_t encType = WiFi.encryptionType(i);
-      
-      Serial.printf("  %d: %s (RSSI: %d, Auth: %d)\n", 
-                    i, ssid.c_str(), rssi, encType);
-      
-      if (ssid.equals(WIFI_SSID)) {
-        ssidFound = true;
-        Serial.printf("✓ Target SSID found with signal strength: %d dBm\n", rssi);
-      }
-    }
-    
-    if (!ssidFound) {
-      Serial.println("✗ Target SSID not found in scan!");
-      return false;
-    }
-  }
-  
-  Serial.println("Connecting to WiFi...");
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  
   // Show connection progress on display
   if (displayOn) {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x10_tf);
-    u8g2.drawStr(0, 10, "Connecting");
-    u8g2.drawStr(0, 20, "to WiFi...");
-    u8g2.sendBuffer();
+    screen.showMessage("Connecting", "to WiFi...");
   }
   
-  unsigned long startAttemptTime = millis();
-  int dotCount = 0;
-  
-  while (WiFi.status() != WL_CONNECTED && millis() - startAttemptTime < WIFI_CONNECT_TIMEOUT) {
-    delay(500);
-    Serial.print(".");
-    dotCount++;
-    
-    // Update display with progress dots
-    if (displayOn && dotCount % 4 == 0) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_6x10_tf);
-      u8g2.drawStr(0, 10, "Connecting");
-      
-      char progress[20];
-      sprintf(progress, "WiFi%s", String('.').c_str());
-      for (int i = 0; i < (dotCount / 4) % 4; i++) {
-        strcat(progress, ".");
-      }
-      u8g2.drawStr(0, 20, progress);
-      u8g2.sendBuffer();
-    }
-    
-    // Print detailed status every 5 seconds
-    if ((millis() - startAttemptTime) % 5000 == 0) {
-      wl_status_t status = WiFi.status();
-      Serial.printf("\nWiFi Status: %d ", status);
-      switch (status) {
-        case WL_IDLE_STATUS: Serial.println("(Idle)"); break;
-        case WL_NO_SSID_AVAIL: Serial.println("(SSID not available)"); break;
-        case WL_SCAN_COMPLETED: Serial.println("(Scan completed)"); break;
-        case WL_CONNECTED: Serial.println("(Connected)"); break;
-        case WL_CONNECT_FAILED: Serial.println("(Connect failed)"); break;
-        case WL_CONNECTION_LOST: Serial.println("(Connection lost)"); break;
-        case WL_DISCONNECTED: Serial.println("(Disconnected)"); break;
-        default: Serial.println("(Unknown)"); break;
-      }
-    }
-  }
+  // Reconnects to the cached access point and lease when possible,
+  // falling back to a full scan + DHCP connect
+  wifiManager.connect(WIFI_SSID, WIFI_PASSWORD, WIFI_CONNECT_TIMEOUT);
   
   if (WiFi.status() == WL_CONNECTED) {
     Serial.println("\n✓ WiFi connected successfully!");
@@ -208,11 +207,7 @@ bool setupWiFi() {
     
     // Show success on display
     if (displayOn) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_6x10_tf);
-      u8g2.drawStr(0, 10, "WiFi OK!");
-      u8g2.drawStr(0, 20, WiFi.localIP().toString().c_str());
-      u8g2.sendBuffer();
+      screen.showMessage("WiFi OK!", WiFi.localIP().toString().c_str());
       delay(2000);
     }
     
@@ -239,12 +234,7 @@ bool setupWiFi() {
     
     // Show failure on display
     if (displayOn) {
-      u8g2.clearBuffer();
-      u8g2.setFont(u8g2_font_6x10_tf);
-      u8g2.drawStr(0, 10, "WiFi Failed");
-      u8g2.drawStr(0, 20, "Check signal");
-      u8g2.drawStr(0, 30, "or password");
-      u8g2.sendBuffer();
+      screen.showMessage("WiFi Failed", "Check signal", "or password");
       delay(3000);
     }
     
@@ -255,41 +245,25 @@ bool setupWiFi() {
 void updateDisplay() {
   if (!displayOn) return;
   
-  u8g2.clearBuffer();
+  screen.setLayout(READING_LAYOUT);
   
   // Display location header
-  u8g2.setFont(u8g2_font_6x10_tf);
-  u8g2.drawStr(0, 8, "Food Store");
+  screen.setText(HEADER_FIELD, "Food Store");
   
   if (lastTemperature != -999.0) {
     // Display temperature with large font
-    u8g2.setFont(u8g2_font_logisoso18_tf);
     char tempStr[10];
     sprintf(tempStr, "%.1f", lastTemperature);
-    u8g2.drawStr(0, 28, tempStr);
-    
-    // Add degree symbol and C
-    u8g2.setFont(u8g2_font_6x10_tf);
-    u8g2.drawStr(50, 22, "C");
+    screen.setText(VALUE_FIELD, tempStr);
+    screen.setText(UNIT_FIELD, "C");
   } else {
     // No data available
-    u8g2.setFont(u8g2_font_6x10_tf);
-    u8g2.drawStr(0, 18, "No Data");
-    u8g2.drawStr(0, 28, "Available");
+    screen.setText(VALUE_FIELD, "--.-");
+    screen.setText(UNIT_FIELD, "");
   }
   
-  // Status indicators
-  u8g2.setFont(u8g2_font_5x7_tr);
-  
   // WiFi status
-  if (wifiConnected) {
-    u8g2.drawStr(60, 8, "W");
-  }
-  
-  // Update count
-  char countStr[10];
-  sprintf(countStr, "#%d", updateCount);
-  u8g2.drawStr(0, 40, countStr);
+  screen.setText(WIFI_FIELD, wifiConnected ? "W" : "");
   
   // Last update time (show minutes ago)
   unsigned long minutesAgo = (millis() - lastDataUpdate) / 60000;
@@ -299,85 +273,74 @@ void updateDisplay() {
   } else {
     sprintf(timeStr, "%luh", minutesAgo / 60);
   }
-  u8g2.drawStr(35, 40, timeStr);
-  
-  u8g2.sendBuffer();
+  screen.setText(AGE_FIELD, timeStr);
+  
+  // History is kept on the device, so the graph needs no query; it moves
+  // one column per 15-minute slot
+  ReadingHistory::advance(millis() / 1000);
+  int16_t samples[HISTORY_GRAPH_WIDTH];
+  size_t sampleCount = ReadingHistory::getSamples(samples, HISTORY_GRAPH_WIDTH);
+  historyGraph.update(samples, sampleCount, ReadingHistory::getClosedCount());
+  screen.setSparkline(&historyGraph);
+  
+  // Usually only the age has changed, which is a couple of tiles
+  screen.render();
 }
 
-float queryLatestTemperature() {
-  if (!wifiConnected) {
-    Serial.println("WiFi not connected, cannot query Supabase");
-    return -999.0;
-  }
-  
-  Serial.println("Querying Supabase for latest food_storage temperature...");
-  
-  // Query for the latest temperature reading from food_storage location
-  String response = supabase.from("environment_measurements")
-                      .select("value, created_at")
-                      .eq("location", "food_storage")
-                      .eq("type", "temperature")
-                      .order("created_at", "desc", false)
-                      .limit(1)
-                      .doSelect();
-  
-  Serial.print("Supabase response: ");
-  Serial.println(response);
+void updateTemperatureData() {
+  if (!wifiConnected) return;
   
-  if (response.length() > 0 && !response.startsWith("error")) {
-    // Parse JSON response
-    DynamicJsonDocument doc(1024);
-    DeserializationError error = deserializeJson(doc, response);
-    
-    if (!error && doc.is<JsonArray>() && doc.size() > 0) {
-      JsonObject measurement = doc[0];
-      if (measurement.containsKey("value")) {
-        float temperature = measurement["value"].as<float>();
-        Serial.printf("Retrieved temperature: %.2f°C\n", temperature);
-        
-        // Update timestamp
-        lastDataUpdate = millis();
-        updateCount++;
-        
-        return temperature;
-      } else {
-        Serial.println("No 'value' field in response");
-      }
-    } else {
-      Serial.println("Failed to parse JSON response or empty result");
-      if (error) {
-        Serial.print("JSON parsing error: ");
-        Serial.println(error.c_str());
-      }
-    }
-  } else {
-    Serial.println("Empty or error response from Supabase");
+  // Only rows newer than the last one seen are requested, so an unchanged
+  // poll returns an empty array
+  lastDataPoll = millis();
+  switch (foodStorageTemperature.poll()) {
+    case LatestReadingClient::Result::UPDATED:
+      lastTemperature = foodStorageTemperature.getValue();
+      lastDataUpdate = millis();
+      updateCount++;
+      Serial.printf("✓ New temperature: %.2f°C (%s)\n", lastTemperature, foodStorageTemperature.getCreatedAt());
+      
+      // Only rows that actually arrived go into the graph, so slots without
+      // new data (a quiet sensor or a backend outage) stay gaps
+      ReadingHistory::add(lastTemperature, millis() / 1000);
+      break;
+    case LatestReadingClient::Result::UNCHANGED:
+      Serial.printf("No reading newer than %s\n", foodStorageTemperature.getCreatedAt());
+      break;
+    case LatestReadingClient::Result::FAILED:
+      Serial.println("⚠ Failed to update temperature data");
+      break;
   }
-  
-  return -999.0; // Error value
 }
 
-void updateTemperatureData() {
-  if (!wifiConnected) return;
-  
-  float newTemperature = queryLatestTemperature();
-  if (newTemperature != -999.0) {
-    lastTemperature = newTemperature;
-    Serial.println("✓ Temperature data updated successfully!");
-  } else {
-    Serial.println("⚠ Failed to update temperature data");
+void refreshData() {
+  if (!wifiConnected) {
+    // Reconnects to the cached access point and lease when possible
+    wifiConnected = wifiManager.connect(WIFI_SSID, WIFI_PASSWORD, WIFI_CONNECT_TIMEOUT);
+    if (!wifiConnected) {
+      Serial.printf("⚠ WiFi reconnection failed: %s\n", wifiManager.getLastError().c_str());
+      lastDataPoll = millis(); // Retry at the next refresh, not on every wake
+      return;
+    }
+    supabase.begin(SUPABASE_URL, SUPABASE_KEY);
   }
+  updateTemperatureData();
 }
 
 void printSystemInfo() {
   Serial.println("=== Food Storage Monitor v2 ===");
   Serial.printf("Update Count: %d\n", updateCount);
   Serial.printf("Last Temperature: %.1f°C\n", lastTemperature);
+  float historyMin, historyMax;
+  if (ReadingHistory::getRange(24, historyMin, historyMax)) {
+    Serial.printf("Last 24h: %.1f to %.1f°C\n", historyMin, historyMax);
+  }
   Serial.printf("Data Update Interval: %d seconds\n", DATA_UPDATE_INTERVAL / 1000);
   Serial.printf("Display Update Interval: %d seconds\n", DISPLAY_UPDATE_INTERVAL / 1000);
   Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
   Serial.printf("CPU Frequency: %d MHz\n", getCpuFrequencyMhz());
   Serial.println("Boot button: Press to toggle display");
+  Serial.printf("Light sleep: %s\n", LIGHT_SLEEP_ENABLED ? "enabled" : "disabled");
   Serial.println("===============================");
 }
 
@@ -396,6 +359,9 @@ void setup() {
   
   // Setup boot button
   setupBootButton();
+  if (LIGHT_SLEEP_ENABLED) {
+    setupLightSleep();
+  }
   
   // Connect to WiFi
   wifiConnected = setupWiFi();
@@ -413,27 +379,45 @@ void setup() {
   
   // Initial display update
   lastDisplayUpdate = millis();
-  updateDisplay();
+  if (displayOn) {
+    updateDisplay();
+  } else {
+    u8g2.setPowerSave(1);
+  }
   
   Serial.println("=== Food Storage Monitor Started ===");
   Serial.println("Press boot button to toggle display on/off");
-  Serial.println("Updates: Data every 5min, Display every 30sec");
+  Serial.println("Updates: Data every 5min, Display every 1min");
   Serial.println("====================================");
 }
 
 void loop() {
   unsigned long currentTime = millis();
   
-  // Check boot button for display toggle
+  // Check boot button for display toggle (also what ends a light sleep early)
   checkBootButton();
   
+  if (LIGHT_SLEEP_ENABLED) {
+    // WiFi is off between refreshes, so every refresh reconnects
+    if (currentTime - lastDataPoll >= DATA_UPDATE_INTERVAL) {
+      Serial.println("=== Scheduled Data Update ===");
+      refreshData();
+    }
+    if (displayOn && (millis() - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL)) {
+      updateDisplay();
+      lastDisplayUpdate = millis();
+    }
+    sleepUntilNextEvent();
+    return;
+  }
+  
   // Update temperature data every 5 minutes
-  if (wifiConnected && (currentTime - lastDataUpdate >= DATA_UPDATE_INTERVAL)) {
+  if (wifiConnected && (currentTime - lastDataPoll >= DATA_UPDATE_INTERVAL)) {
     Serial.println("=== Scheduled Data Update ===");
     updateTemperatureData();
   }
   
-  // Update display every 30 seconds (if display is on)
+  // Update display every minute (if display is on)
   if (displayOn && (currentTime - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL)) {
     updateDisplay();
     lastDisplayUpdate = currentTime;
@@ -451,4 +435,4 @@ void loop() {
   
   // Small delay to prevent excessive CPU usage
   delay(50);
-}
\ No newline at end of file
+}
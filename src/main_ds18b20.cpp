@@ -2,13 +2,35 @@
 #include <DallasTemperature.h>
 #include <U8g2lib.h>
 #include <Wire.h>
+#include "OledScreen.h"
+#include "ReadingHistory.h"
 
 #define ONE_WIRE_BUS 8
 #define SDA_PIN 5
 #define SCL_PIN 6
 
+// Define to use a one tile row page buffer instead of the full frame buffer
+// #define OLED_PAGE_BUFFER
+
 // Setup U8g2 display object for your specific OLED
+#ifdef OLED_PAGE_BUFFER
+U8G2_SSD1306_72X40_ER_1_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
+#else
 U8G2_SSD1306_72X40_ER_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
+#endif
+
+// Sends only the tiles of fields that changed
+OledScreen screen(u8g2);
+
+enum TemperatureField { VALUE_FIELD, UNIT_FIELD };
+const OledScreen::Field TEMPERATURE_LAYOUT[] = {
+  {0, 25, 44, u8g2_font_logisoso18_tf},
+  {45, 35, 8, u8g2_font_6x10_tf},
+};
+
+// Last 10 hours of device 0 (one 15-minute slot per column) below the value
+#define HISTORY_GRAPH_WIDTH 40
+Sparkline historyGraph(0, 4, HISTORY_GRAPH_WIDTH);
 
 // Setup a OneWire instance to communicate with any OneWire devices
 OneWire oneWire(ONE_WIRE_BUS);
@@ -28,12 +50,7 @@ void setup()
   u8g2.begin();
   
   // Display initialization message
-  u8g2.clearBuffer();
-  u8g2.setFont(u8g2_font_6x10_tf);
-  u8g2.drawStr(0, 10, "Temperature");
-  u8g2.drawStr(0, 20, "Sensor");
-  u8g2.drawStr(0, 30, "Starting...");
-  u8g2.sendBuffer();
+  screen.showMessage("Temperature", "Sensor", "Starting...");
   
   // Start up the Dallas Temperature library
   sensors.begin();
@@ -46,19 +63,14 @@ void setup()
   Serial.println(" devices.");
   
   // Update display with device count
-  u8g2.clearBuffer();
-  u8g2.drawStr(0, 10, "DS18B20 Sensor");
-  
   char deviceText[20];
   sprintf(deviceText, "Found: %d", deviceCount);
-  u8g2.drawStr(0, 20, deviceText);
   
   if (deviceCount == 0) {
-    u8g2.drawStr(0, 30, "No sensor!");
-    u8g2.drawStr(0, 40, "Check wiring");
+    screen.showMessage("DS18B20 Sensor", deviceText, "No sensor!", "Check wiring");
+  } else {
+    screen.showMessage("DS18B20 Sensor", deviceText);
   }
-  
-  u8g2.sendBuffer();
   delay(3000);
 
   // Report parasite power mode
@@ -84,18 +96,11 @@ void loop()
   Serial.println("Requesting temperatures...");
   sensors.requestTemperatures();
   
-  // Clear display for new reading
-  u8g2.clearBuffer();
-  u8g2.setFont(u8g2_font_logisoso18_tf); // Largest font that fits
-  
   // Get device count
   int deviceCount = sensors.getDeviceCount();
   
   if (deviceCount == 0) {
-    u8g2.setFont(u8g2_font_6x10_tf);
-    u8g2.drawStr(0, 10, "No sensors!");
-    u8g2.drawStr(0, 20, "Check GPIO8");
-    u8g2.drawStr(0, 30, "4.7k pullup");
+    screen.showMessage("No sensors!", "Check GPIO8", "4.7k pullup");
   } else {
     // Print temperature for each device found
     for (int i = 0; i < deviceCount; i++) {
@@ -109,27 +114,32 @@ void loop()
         Serial.print(tempC);
         Serial.println(" °C");
         
-        // Display temperature on OLED with large font
+        // Display temperature on OLED with large font; usually only a
+        // digit or two changes between readings
         char tempText[10];
         sprintf(tempText, "%.1f", tempC);
-        u8g2.drawStr(0, 25, tempText);
+        screen.setLayout(TEMPERATURE_LAYOUT);
+        screen.setText(VALUE_FIELD, tempText);
+        screen.setText(UNIT_FIELD, "C");
         
-        // Add °C with smaller font
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.drawStr(45, 35, "C");
+        // Slot averages kept in RTC memory; the graph shifts one column
+        // per slot
+        if (i == 0) {
+          ReadingHistory::add(tempC, millis() / 1000);
+          int16_t samples[HISTORY_GRAPH_WIDTH];
+          size_t sampleCount = ReadingHistory::getSamples(samples, HISTORY_GRAPH_WIDTH);
+          historyGraph.update(samples, sampleCount, ReadingHistory::getClosedCount());
+          screen.setSparkline(&historyGraph);
+        }
+        screen.render();
         
       } else {
         Serial.println(" error: Could not read temperature");
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.drawStr(0, 20, "ERROR!");
-        u8g2.drawStr(0, 30, "Check wire");
+        screen.showMessage("", "ERROR!", "Check wire");
       }
     }
   }
   
-  // Update display
-  u8g2.sendBuffer();
-  
   Serial.println("-----------------------------------");
   delay(30000); // Wait x/1000 seconds between readings
 }
\ No newline at end of file
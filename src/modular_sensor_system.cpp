@@ -17,22 +17,42 @@
 #include "DHT11Sensor.h"
 #include "DS18B20Sensor.h"
 #include "SCD41Sensor.h"
+#include "SensorSet.h"
 
 // Network and data publishing
 #include "WiFiManager.h"
 #include "SupabasePublisher.h"
+#include "MqttPublisher.h"
+#include "FanOutPublisher.h"
+#include "ReadingBuffer.h"
+#include "DeadbandFilter.h"
+#include "SleepScheduler.h"
+#include "StreamingAggregator.h"
+#include "OutageLog.h"
+
+// Diagnostics
+#include "WakeProfiler.h"
 
 // ========== GLOBAL SYSTEM COMPONENTS ==========
 WiFiManager wifiManager;
-SupabasePublisher dataPublisher(SUPABASE_URL, SUPABASE_KEY);
+SupabasePublisher dataPublisher(SUPABASE_URL, SUPABASE_KEY, Config::DEFAULT_SUPABASE_TABLE_NAME);
+MqttPublisher mqttPublisher(MQTT_SERVER, MQTT_PORT, MQTT_USER, MQTT_PASSWORD);
+FanOutPublisher publisher;
 
-// Sensor instances
-DHT11Sensor dht11Sensor(Config::DHT_LOCATION);
-DS18B20Sensor ds18b20Sensor(Config::DS18B20_LOCATION);
-SCD41Sensor scd41Sensor(Config::SCD41_LOCATION);
+// Sensors of this build (further probes on the OneWire bus share ds18b20Bus)
+DS18B20Bus ds18b20Bus;
+SensorSet<DHT11Sensor, DS18B20Sensor, SCD41Sensor> sensors(
+    DHT11Sensor(Config::DEFAULT_DHT_LOCATION),
+    DS18B20Sensor(ds18b20Bus, Config::DEFAULT_DS18B20_LOCATION),
+    SCD41Sensor(Config::DEFAULT_SCD41_LOCATION)
+);
 
 // System state
 RTC_DATA_ATTR int bootCount = 0;
+bool wifiStarted = false;
+
+// Fast fixed-rate sampling that uploads window statistics instead of readings
+constexpr bool AGGREGATE_ONLY = Config::SAMPLING_MODE == Config::SamplingMode::AGGREGATE_ONLY;
 
 // ========== SYSTEM FUNCTIONS ==========
 
@@ -42,7 +62,13 @@ void printSystemInfo() {
     Serial.println("========================================");
     Serial.printf("Boot Count: %d\n", bootCount);
     Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
-    Serial.printf("Sleep Duration: %d seconds\n", Config::SLEEP_DURATION_SECONDS);
+    if (AGGREGATE_ONLY) {
+        Serial.printf("Sleep Duration: %lu seconds (aggregate-only sampling)\n",
+                     (unsigned long)Config::FAST_SAMPLING_SECONDS);
+    } else {
+        Serial.printf("Sleep Duration: %lu-%lu seconds (adaptive)\n",
+                     (unsigned long)Config::SLEEP_MIN_SECONDS, (unsigned long)Config::SLEEP_MAX_SECONDS);
+    }
     
     // Print wakeup reason
     esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
@@ -67,142 +93,238 @@ bool initializeSystem() {
     // Initialize configuration
     Config::initialize();
     
-    bool allSuccess = true;
+    bool allSuccess;
     
     // Initialize all sensors
     Serial.println("Initializing sensors...");
-    
-    if (!dht11Sensor.initialize()) {
-        Serial.printf("⚠ %s initialization failed: %s\n", 
-                     dht11Sensor.getName().c_str(), dht11Sensor.getLastError().c_str());
-        allSuccess = false;
+    {
+        WakeProfiler::ScopedTimer timer(WakeProfiler::Phase::SENSOR_INIT);
+        allSuccess = sensors.initialize();
     }
     
-    if (!ds18b20Sensor.initialize()) {
-        Serial.printf("⚠ %s initialization failed: %s\n", 
-                     ds18b20Sensor.getName().c_str(), ds18b20Sensor.getLastError().c_str());
-        allSuccess = false;
+    Serial.printf("\n%s System initialization %s\n", 
+                 allSuccess ? "✓" : "⚠", 
+                 allSuccess ? "completed successfully" : "completed with warnings");
+    
+    return allSuccess;
+}
+
+bool initializeNetwork() {
+    // WiFi has been associating in the background since the start of the wake,
+    // so this normally only waits for whatever part of it is still outstanding
+    Serial.println("\n=== Network Initialization ===");
+    bool wifiConnected;
+    {
+        WakeProfiler::ScopedTimer timer(WakeProfiler::Phase::WIFI_CONNECT);
+        wifiConnected = wifiManager.waitUntilConnected();
     }
     
-    if (!scd41Sensor.initialize()) {
-        Serial.printf("⚠ %s initialization failed: %s\n", 
-                     scd41Sensor.getName().c_str(), scd41Sensor.getLastError().c_str());
-        allSuccess = false;
+    if (!wifiConnected) {
+        Serial.printf("⚠ WiFi connection failed: %s\n", wifiManager.getLastError().c_str());
+        return false;
     }
     
-    // Initialize network
-    Serial.println("\nInitializing network...");
-    bool wifiConnected = wifiManager.connect(WIFI_SSID, WIFI_PASSWORD);
+    // Buffered readings are timestamped from SNTP at upload
+    wifiManager.startTimeSync();
     
-    if (wifiConnected) {
-        // Initialize data publisher
-        if (!dataPublisher.initialize()) {
-            Serial.printf("⚠ %s initialization failed: %s\n", 
-                         dataPublisher.getName().c_str(), dataPublisher.getLastError().c_str());
-            allSuccess = false;
-        }
-    } else {
-        Serial.printf("⚠ WiFi connection failed: %s\n", wifiManager.getLastError().c_str());
-        allSuccess = false;
+    // Supabase is the store of record (primary); MQTT feeds live consumers
+    publisher.addBackend(dataPublisher);
+    if (Config::MQTT_ENABLED) {
+        publisher.addBackend(mqttPublisher);
     }
     
-    Serial.printf("\n%s System initialization %s\n", 
-                 allSuccess ? "✓" : "⚠", 
-                 allSuccess ? "completed successfully" : "completed with warnings");
+    // Initialize data publishers
+    WakeProfiler::ScopedTimer timer(WakeProfiler::Phase::PUBLISHER_INIT);
+    if (!publisher.initialize()) {
+        Serial.printf("⚠ %s initialization failed: %s\n", 
+                     publisher.getName().c_str(), publisher.getLastError().c_str());
+        return false;
+    }
     
-    return allSuccess;
+    return true;
+}
+
+WakeProfiler::Phase readPhaseFor(const DHT11Sensor&) { return WakeProfiler::Phase::DHT11_READ; }
+WakeProfiler::Phase readPhaseFor(const DS18B20Sensor&) { return WakeProfiler::Phase::DS18B20_READ; }
+WakeProfiler::Phase readPhaseFor(const SCD41Sensor&) { return WakeProfiler::Phase::SCD41_READ; }
+
+/**
+ * @brief Check if closed windows justify an upload on their own
+ */
+bool aggregatesDue() {
+    // Without raw rows the aggregates are all there is to upload
+    return AGGREGATE_ONLY ? StreamingAggregator::getPendingCount() > 0 : StreamingAggregator::isUploadDue();
 }
 
 void readAndPublishSensorData() {
     Serial.println("\n=== Sensor Data Collection ===");
     
-    std::vector<ISensor::Reading> readings;
     int totalPublished = 0;
-    bool hasPublisher = dataPublisher.isReady();
-    
-    // DHT11 Sensor (Temperature + Humidity)
-    Serial.println("\nProcessing DHT11 sensor...");
-    if (dht11Sensor.isReady() && dht11Sensor.readSensor(readings)) {
-        if (hasPublisher) {
-            std::vector<String> dhtDataTypes = {"temperature", "humidity"};
-            int published = dataPublisher.publishBatch(
-                dht11Sensor.getName(), 
-                dht11Sensor.getLocation(), 
-                readings, 
-                dhtDataTypes
-            );
-            totalPublished += published;
+    bool uploadDue = ReadingBuffer::isUploadDue();
+    
+    // Start all conversions at once and collect each sensor as soon as it is done
+    sensors.run([](const auto& sensor, const auto& result) {
+        WakeProfiler::record(readPhaseFor(sensor), result.durationMs);
+        if (!result.success) {
+            Serial.printf("⚠ %s read failed: %s\n", 
+                         sensor.getName(), sensor.getErrorMessage());
         }
-    } else {
-        Serial.printf("⚠ %s read failed: %s\n", 
-                     dht11Sensor.getName().c_str(), dht11Sensor.getLastError().c_str());
-    }
-    
-    // DS18B20 Sensor (Temperature)
-    Serial.println("\nProcessing DS18B20 sensor...");
-    if (ds18b20Sensor.isReady() && ds18b20Sensor.readSensor(readings)) {
-        if (hasPublisher) {
-            std::vector<String> ds18b20DataTypes = {"temperature"};
-            int published = dataPublisher.publishBatch(
-                ds18b20Sensor.getName(), 
-                ds18b20Sensor.getLocation(), 
-                readings, 
-                ds18b20DataTypes
-            );
-            totalPublished += published;
+    });
+    
+    // Gather every valid reading of this wake into the RTC buffer
+    std::vector<IDataPublisher::DataPoint> points;
+    points.reserve(decltype(sensors)::MAX_DATA_POINTS);
+    sensors.appendDataPoints(points);
+    
+    // The window statistics follow every reading. In adaptive mode so does
+    // the sleep schedule, and only readings that moved are buffered.
+    uint32_t clockNow = ReadingBuffer::getClockSeconds();
+    StreamingAggregator::add(points, clockNow);
+    if (!AGGREGATE_ONLY) {
+        SleepScheduler::record(points, clockNow);
+        DeadbandFilter::apply(points, clockNow);
+        ReadingBuffer::appendAll(points);
+    }
+    
+    // Nothing changed since the last upload and no outage backlog to replay:
+    // keep the radio off and restart the schedule
+    if (uploadDue && ReadingBuffer::getCount() == 0 && !aggregatesDue() && !OutageLog::hasPending()) {
+        Serial.println("Nothing new to upload - skipping this upload");
+        ReadingBuffer::clear();
+        uploadDue = false;
+    }
+    
+    if (!uploadDue) {
+        Serial.println("\n=== Data Collection Summary ===");
+        if (AGGREGATE_ONLY) {
+            Serial.printf("Aggregated %d readings (%d windows pending), next upload in %lu s\n",
+                         (int)points.size(), (int)StreamingAggregator::getPendingCount(),
+                         (unsigned long)ReadingBuffer::getSecondsUntilUpload());
+        } else {
+            Serial.printf("Buffered %d data points (%d stored), next upload in %lu s\n",
+                         (int)points.size(), (int)ReadingBuffer::getCount(),
+                         (unsigned long)ReadingBuffer::getSecondsUntilUpload());
         }
-    } else {
-        Serial.printf("⚠ %s read failed: %s\n", 
-                     ds18b20Sensor.getName().c_str(), ds18b20Sensor.getLastError().c_str());
-    }
-    
-    // SCD-41 Sensor (CO2 + Temperature + Humidity)
-    Serial.println("\nProcessing SCD-41 sensor...");
-    if (scd41Sensor.isReady() && scd41Sensor.readSensor(readings)) {
-        if (hasPublisher && !readings.empty()) {
-            // Only publish CO2 data (first reading) to avoid duplicate temperature/humidity
-            if (readings[0].status == ISensor::Status::SUCCESS) {
-                auto result = dataPublisher.publish(
-                    scd41Sensor.getLocation(), 
-                    "co2", 
-                    readings[0].value
-                );
-                if (result.success) {
-                    totalPublished++;
-                }
-            }
+        return;
+    }
+    
+    // Only block on the network once the readings are in hand
+    if (!wifiStarted) {
+        wifiManager.begin(WIFI_SSID, WIFI_PASSWORD);
+        wifiStarted = true;
+    }
+    initializeNetwork();
+    bool hasPublisher = publisher.isReady();
+    
+    // Without a synchronized clock the rows fall back to the database's upload time
+    uint32_t utcNow = 0;
+    if (hasPublisher && !wifiManager.getUtcTime(utcNow)) {
+        Serial.println("⚠ Uploading buffered readings without timestamps");
+    }
+    
+    bool uploaded = false;
+    bool attempted = hasPublisher && ReadingBuffer::getCount() > 0;
+    if (attempted) {
+        std::vector<IDataPublisher::DataPoint> buffered = ReadingBuffer::getDataPoints(utcNow);
+        Serial.printf("\nPublishing %d buffered data points...\n", (int)buffered.size());
+        WakeProfiler::ScopedTimer timer(WakeProfiler::Phase::PUBLISH);
+        totalPublished = publisher.publishCycle(buffered);
+        uploaded = totalPublished == (int)buffered.size();
+        
+        if (totalPublished > 0 && ReadingBuffer::getDroppedCount() > 0) {
+            Serial.printf("⚠ %lu readings were overwritten before this upload\n",
+                         (unsigned long)ReadingBuffer::getDroppedCount());
+        }
+    }
+    
+    if (!uploaded && ReadingBuffer::getCount() > 0) {
+        // Move the readings to flash so a long outage or a power loss does not lose them.
+        // The primary stores a cycle all or nothing, so every buffered reading is logged.
+        OutageLog::TimeBase timeBase = utcNow != 0 ? OutageLog::TimeBase::UTC
+                                                   : OutageLog::TimeBase::BUFFER_CLOCK;
+        std::vector<IDataPublisher::DataPoint> pending =
+            ReadingBuffer::getDataPoints(utcNow != 0 ? utcNow : ReadingBuffer::getClockSeconds());
+        if (OutageLog::append(pending, timeBase)) {
+            ReadingBuffer::clear();
         }
     } else {
-        Serial.printf("⚠ %s read failed: %s\n", 
-                     scd41Sensor.getName().c_str(), scd41Sensor.getLastError().c_str());
+        // Uploaded, or only aggregates or the outage log were due: restart the schedule
+        ReadingBuffer::clear();
+    }
+    
+    // The uplink works: send what earlier outages left behind. Replays go to the
+    // database only, MQTT subscribers would take days-old readings for live ones.
+    if (hasPublisher && (uploaded || !attempted) && dataPublisher.isReady()) {
+        OutageLog::replay(dataPublisher, utcNow, ReadingBuffer::getClockSeconds());
+    }
+    
+    // Window aggregates go to their own table
+    if (hasPublisher && StreamingAggregator::getPendingCount() > 0 && dataPublisher.isReady()) {
+        std::vector<IDataPublisher::Aggregate> aggregates =
+            StreamingAggregator::getPending(utcNow, ReadingBuffer::getClockSeconds());
+        Serial.printf("\nPublishing %d window aggregates...\n", (int)aggregates.size());
+        if (dataPublisher.publishAggregates(Config::AGGREGATE_TABLE_NAME, aggregates) == (int)aggregates.size()) {
+            StreamingAggregator::clearPending();
+        }
     }
     
     // Summary
     Serial.println("\n=== Data Collection Summary ===");
-    Serial.printf("Sensors processed: 3\n");
+    Serial.printf("Sensors processed: %d\n", (int)decltype(sensors)::SIZE);
     Serial.printf("Data points published: %d\n", totalPublished);
-    Serial.printf("Publisher: %s (%s)\n", 
-                 dataPublisher.getName().c_str(),
-                 hasPublisher ? "Connected" : "Offline");
+    for (size_t i = 0; i < publisher.getBackendCount(); i++) {
+        const IDataPublisher& backend = publisher.getBackend(i);
+        Serial.printf("Publisher: %s (%s, %lu delivered)\n", 
+                     backend.getName().c_str(),
+                     backend.isReady() ? "Connected" : "Offline",
+                     (unsigned long)publisher.getDeliveredCount(i));
+    }
     
     if (!hasPublisher) {
         Serial.println("⚠ Data not published - no network connection");
     }
 }
 
+void publishWakeProfile() {
+    Serial.println();
+    WakeProfiler::printSummary();
+    
+    if (!WakeProfiler::isSummaryDue(ReadingBuffer::getClockSeconds()) || !dataPublisher.isReady()) {
+        return;
+    }
+    
+    auto result = dataPublisher.publishRow(
+        Config::PROFILER_TABLE_NAME,
+        WakeProfiler::createSummaryPayload(WiFi.macAddress())
+    );
+    
+    // Keep accumulating if the upload failed so the next wake can retry
+    if (result.success) {
+        WakeProfiler::reset(ReadingBuffer::getClockSeconds());
+    }
+}
+
 void enterDeepSleep() {
     Serial.println("\n=== Preparing Deep Sleep ===");
     
     // Cleanup network resources
+    mqttPublisher.disconnect();
     wifiManager.disconnect();
     
+    // Wake sooner while readings move, later while they are flat
+    uint32_t sleepSeconds = AGGREGATE_ONLY ? Config::FAST_SAMPLING_SECONDS : SleepScheduler::nextSleepSeconds();
+    ReadingBuffer::prepareSleep(sleepSeconds);
+    
     // Configure wake-up timer
-    esp_sleep_enable_timer_wakeup(Config::SLEEP_DURATION_SECONDS * Config::uS_TO_S_FACTOR);
+    esp_sleep_enable_timer_wakeup(sleepSeconds * Config::uS_TO_S_FACTOR);
     
-    Serial.printf("Configured for %d seconds sleep\n", Config::SLEEP_DURATION_SECONDS);
+    Serial.printf("Configured for %lu seconds sleep\n", (unsigned long)sleepSeconds);
     Serial.println("Entering deep sleep...");
     Serial.flush();
     
+    // Everything this wake did is behind us; the next wake records it
+    WakeProfiler::endWake(millis());
+    
     // Enter deep sleep
     esp_deep_sleep_start();
 }
@@ -210,10 +332,23 @@ void enterDeepSleep() {
 void setup() {
     // Initialize serial communication
     Serial.begin(Config::SERIAL_BAUD_RATE);
-    delay(1000);
     
     // Increment boot counter
     ++bootCount;
+    ReadingBuffer::beginWake();
+    WakeProfiler::beginWake(ReadingBuffer::getClockSeconds());
+    
+    // Only upload wakes use the radio; start it first so association and
+    // DHCP overlap sensor warm-up. With nothing to upload or replay and no
+    // heartbeat due, wait for the readings: if none leaves its deadband, WiFi
+    // stays off.
+    bool uploadDue = ReadingBuffer::isUploadDue();
+    if (uploadDue && (ReadingBuffer::getCount() > 0 || aggregatesDue() || OutageLog::hasPending() ||
+                      (!AGGREGATE_ONLY && DeadbandFilter::isHeartbeatDue(ReadingBuffer::getClockSeconds())))) {
+        wifiManager.begin(WIFI_SSID, WIFI_PASSWORD);
+        wifiStarted = true;
+    }
+    delay(1000);
     
     // Print system information
     printSystemInfo();
@@ -224,8 +359,13 @@ void setup() {
     // Read sensors and publish data
     readAndPublishSensorData();
     
-    // Allow time for final operations
-    delay(2000);
+    // Report where this node spends its awake time
+    publishWakeProfile();
+    
+    // Allow time for final network operations
+    if (wifiStarted) {
+        delay(2000);
+    }
     
     // Enter deep sleep for power conservation
     enterDeepSleep();
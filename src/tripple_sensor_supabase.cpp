@@ -6,6 +6,7 @@
 #include <ESPSupabase.h>
 #include <SensirionI2cScd4x.h>
 #include "credentials.h"
+#include "ReadingBuffer.h"
 
 // ========== SENSOR CONFIGURATION ==========
 // DHT11 Sensor Configuration
@@ -95,16 +96,13 @@ bool setup_wifi() {
   }
 }
 
-bool sendToSupabase(const char* location, const char* type, float value) {
+bool sendToSupabase(const String& jsonData) {
   if (WiFi.status() != WL_CONNECTED) {
     Serial.println("WiFi not connected, skipping Supabase upload");
     return false;
   }
   
   String tableName = "environment_measurements";
-  String jsonData = "{\"location\": \"" + String(location) + 
-                   "\", \"type\": \"" + String(type) + 
-                   "\", \"value\": " + String(value, 2) + "}";
   
   Serial.print("Sending to Supabase: ");
   Serial.println(jsonData);
@@ -237,41 +235,66 @@ SensorReadings readAllSensors() {
   return readings;
 }
 
-bool uploadSensorData(const SensorReadings& readings) {
-  bool allSuccess = true;
+void bufferSensorData(const SensorReadings& readings) {
+  std::vector<IDataPublisher::DataPoint> points;
   
-  Serial.println("=== Uploading Data ===");
-  
-  // Upload DHT11 data
   if (readings.dht_success) {
-    if (!sendToSupabase(DHT_LOCATION, "temperature", readings.dht_temperature)) {
-      allSuccess = false;
-    }
-    delay(1000);
-    
-    if (!sendToSupabase(DHT_LOCATION, "humidity", readings.dht_humidity)) {
-      allSuccess = false;
-    }
-    delay(1000);
+    points.emplace_back(DHT_LOCATION, MeasurementKind::TEMPERATURE, readings.dht_temperature);
+    points.emplace_back(DHT_LOCATION, MeasurementKind::HUMIDITY, readings.dht_humidity);
   }
-  
-  // Upload DS18B20 data
   if (readings.ds18b20_success) {
-    if (!sendToSupabase(DS18B20_LOCATION, "temperature", readings.ds18b20_temperature)) {
-      allSuccess = false;
-    }
-    delay(1000);
+    points.emplace_back(DS18B20_LOCATION, MeasurementKind::TEMPERATURE, readings.ds18b20_temperature);
   }
-
-  // Upload SCD-41 data
   if (readings.scd41_success) {
-    if (!sendToSupabase(SCD41_LOCATION, "co2", readings.scd41_co2)) {
-      allSuccess = false;
+    points.emplace_back(SCD41_LOCATION, MeasurementKind::CO2, readings.scd41_co2);
+  }
+  
+  ReadingBuffer::appendAll(points);
+  Serial.printf("Buffered %d readings (%d stored)\n", 
+                (int)points.size(), (int)ReadingBuffer::getCount());
+}
+
+bool uploadBufferedData() {
+  Serial.println("=== Uploading Data ===");
+  
+  // Timestamp buffered readings from SNTP; without it the database uses the upload time
+  uint32_t utcNow = 0;
+  struct tm timeInfo;
+  configTime(0, 0, "pool.ntp.org");
+  if (getLocalTime(&timeInfo, 2000)) {
+    utcNow = (uint32_t)mktime(&timeInfo);
+  } else {
+    Serial.println("⚠ SNTP time not available - uploading without timestamps");
+  }
+  
+  // All buffered readings go out as one JSON array in a single request
+  std::vector<IDataPublisher::DataPoint> points = ReadingBuffer::getDataPoints(utcNow);
+  String jsonData = "[";
+  for (size_t i = 0; i < points.size(); i++) {
+    if (i > 0) {
+      jsonData += ", ";
     }
-    delay(1000);
+    jsonData += "{\"location\": \"" + points[i].location + 
+                "\", \"type\": \"" + measurementName(points[i].kind) + 
+                "\", \"value\": " + String(points[i].value, 2);
+    if (points[i].timestamp != 0) {
+      time_t seconds = (time_t)points[i].timestamp;
+      struct tm utc;
+      char createdAt[24];
+      gmtime_r(&seconds, &utc);
+      strftime(createdAt, sizeof(createdAt), "%Y-%m-%dT%H:%M:%SZ", &utc);
+      jsonData += ", \"created_at\": \"" + String(createdAt) + "\"";
+    }
+    jsonData += "}";
+  }
+  jsonData += "]";
+  
+  if (points.empty() || !sendToSupabase(jsonData)) {
+    return false;
   }
   
-  return allSuccess;
+  ReadingBuffer::clear();
+  return true;
 }
 
 void printSystemInfo() {
@@ -407,6 +430,8 @@ void enterDeepSleep() {
   WiFi.disconnect(true);
   WiFi.mode(WIFI_OFF);
   
+  ReadingBuffer::prepareSleep(TIME_TO_SLEEP);
+  
   // Configure timer wakeup
   esp_sleep_enable_timer_wakeup(TIME_TO_SLEEP * uS_TO_S_FACTOR);
   
@@ -424,6 +449,8 @@ void setup() {
   
   // Increment and display boot count
   ++bootCount;
+  ReadingBuffer::beginWake();
+  bool uploadDue = ReadingBuffer::isUploadDue();
   
   // Print system information
   printSystemInfo();
@@ -431,31 +458,32 @@ void setup() {
   // Initialize sensors
   initializeSensors();
   
-  // Connect to WiFi
-  bool wifiConnected = setup_wifi();
-  
-  // Initialize Supabase if WiFi connected
-  if (wifiConnected) {
-    Serial.println("Initializing Supabase connection...");
-    supabase.begin(SUPABASE_URL, SUPABASE_KEY);
-  }
-  
-  // Read all sensors
+  // Read all sensors and keep the results in RTC memory
   SensorReadings readings = readAllSensors();
+  bufferSensorData(readings);
   
-  // Upload data if WiFi is available
-  if (wifiConnected) {
-    bool uploadSuccess = uploadSensorData(readings);
-    if (uploadSuccess) {
-      Serial.println("✓ All data uploaded successfully!");
+  // Only bring up WiFi when the buffer is due for upload
+  bool wifiConnected = false;
+  if (uploadDue) {
+    wifiConnected = setup_wifi();
+    
+    if (wifiConnected) {
+      Serial.println("Initializing Supabase connection...");
+      supabase.begin(SUPABASE_URL, SUPABASE_KEY);
+      
+      if (uploadBufferedData()) {
+        Serial.println("✓ All data uploaded successfully!");
+      } else {
+        Serial.println("⚠ Upload failed - keeping readings for the next wake");
+      }
+      
+      // Wait for final uploads to complete
+      delay(2000);
     } else {
-      Serial.println("⚠ Some data uploads failed");
+      Serial.println("⚠ No WiFi connection - data kept for the next wake");
     }
-    
-    // Wait for final uploads to complete
-    delay(2000);
   } else {
-    Serial.println("⚠ No WiFi connection - data not uploaded");
+    Serial.printf("Next upload in %lu s\n", (unsigned long)ReadingBuffer::getSecondsUntilUpload());
   }
   
   // Print summary
@@ -466,7 +494,7 @@ void setup() {
                readings.ds18b20_success ? "SUCCESS" : "FAILED");
   Serial.printf("SCD-41 (%s): %s\n", SCD41_LOCATION, 
                readings.scd41_success ? "SUCCESS" : "FAILED");
-  Serial.printf("WiFi: %s\n", wifiConnected ? "CONNECTED" : "FAILED");
+  Serial.printf("WiFi: %s\n", !uploadDue ? "SKIPPED" : (wifiConnected ? "CONNECTED" : "FAILED"));
   Serial.println("=====================");
   
   // Enter deep sleep
@@ -0,0 +1,20 @@
+-- Wake-cycle profiler summaries of the modular sensor nodes (WakeProfiler).
+-- One row per node and day: per-phase min/mean/max awake times in ms, e.g.
+-- {"publish": {"count": 24, "min_ms": 610, "mean_ms": 702, "max_ms": 1290}, ...}
+CREATE TABLE IF NOT EXISTS wake_profiles (
+    id uuid DEFAULT gen_random_uuid() PRIMARY KEY,
+    created_at timestamp with time zone DEFAULT now(),
+    device_id text NOT NULL,
+    wake_count integer NOT NULL CHECK (wake_count >= 0),
+    phases jsonb NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS idx_wake_profiles_device_time ON wake_profiles(device_id, created_at DESC);
+
+ALTER TABLE wake_profiles ENABLE ROW LEVEL SECURITY;
+
+CREATE POLICY "Allow anonymous read" ON wake_profiles
+    FOR SELECT USING (true);
+
+CREATE POLICY "Allow sensor insert" ON wake_profiles
+    FOR INSERT WITH CHECK (true);
@@ -0,0 +1,30 @@
+-- Per-window statistics of every reading (StreamingAggregator), one row per
+-- location, type and window. window_start/window_end are omitted by nodes
+-- without a synchronized clock; created_at then approximates the window end.
+CREATE TABLE IF NOT EXISTS environment_aggregates (
+    id uuid DEFAULT gen_random_uuid() PRIMARY KEY,
+    created_at timestamp with time zone DEFAULT now(),
+    location text NOT NULL,
+    type text NOT NULL CHECK (type IN ('temperature', 'humidity', 'co2')),
+    count integer NOT NULL CHECK (count > 0),
+    mean numeric NOT NULL,
+    stddev numeric NOT NULL CHECK (stddev >= 0),
+    min numeric NOT NULL,
+    max numeric NOT NULL,
+    last numeric NOT NULL,
+    window_start timestamp with time zone,
+    window_end timestamp with time zone,
+    CHECK (min <= max),
+    CHECK (window_end IS NULL OR window_start IS NULL OR window_end >= window_start)
+);
+
+CREATE INDEX IF NOT EXISTS idx_env_aggregates_location_type_window
+    ON environment_aggregates(location, type, window_start DESC);
+
+ALTER TABLE environment_aggregates ENABLE ROW LEVEL SECURITY;
+
+CREATE POLICY "Allow anonymous read" ON environment_aggregates
+    FOR SELECT USING (true);
+
+CREATE POLICY "Allow sensor insert" ON environment_aggregates
+    FOR INSERT WITH CHECK (true);
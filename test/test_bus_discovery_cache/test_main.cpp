@@ -0,0 +1,115 @@
+/**
+ * @file test_main.cpp
+ * @brief BusDiscoveryCache across deep sleep, resets that clear RTC memory and
+ *        power-on
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <Preferences.h>
+#include "BusDiscoveryCache.h"
+#include "NativeSimulation.h"
+
+namespace {
+
+constexpr uint8_t ROMS[2][BusDiscoveryCache::ROM_SIZE] = {
+    {0x28, 0xFF, 0x4C, 0x3A, 0x61, 0x16, 0x04, 0x9E},
+    {0x28, 0xFF, 0x19, 0x7B, 0x62, 0x16, 0x03, 0x5D},
+};
+
+void boot(esp_reset_reason_t reason) {
+    native::simulateReset(reason);
+    BusDiscoveryCache::reload();
+}
+
+void clearNvs() {
+    Preferences preferences;
+    preferences.begin(Config::BUS_CACHE_NVS_NAMESPACE, false);
+    preferences.clear();
+    preferences.end();
+}
+
+void assertCachedLayout() {
+    TEST_ASSERT_TRUE(BusDiscoveryCache::hasOneWireScan());
+    TEST_ASSERT_EQUAL(2, BusDiscoveryCache::getOneWireCount());
+    uint8_t rom[BusDiscoveryCache::ROM_SIZE];
+    TEST_ASSERT_TRUE(BusDiscoveryCache::getOneWireDevice(1, rom));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ROMS[1], rom, BusDiscoveryCache::ROM_SIZE);
+    TEST_ASSERT_TRUE(BusDiscoveryCache::hasI2CScan());
+    TEST_ASSERT_TRUE(BusDiscoveryCache::isI2CDevicePresent(0x62));
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    clearNvs();
+
+    // First boot scans both buses
+    boot(ESP_RST_POWERON);
+    const uint8_t i2c[] = {0x62};
+    BusDiscoveryCache::storeI2CScan(i2c, 1);
+    BusDiscoveryCache::storeOneWireScan(ROMS, 2, false);
+}
+
+void tearDown(void) {
+}
+
+void test_deep_sleep_wake_uses_rtc_copy(void) {
+    clearNvs(); // Not needed while RTC memory holds the record
+    boot(ESP_RST_DEEPSLEEP);
+    assertCachedLayout();
+}
+
+void test_resets_that_clear_rtc_restore_from_nvs(void) {
+    const esp_reset_reason_t reasons[] = {ESP_RST_SW, ESP_RST_PANIC, ESP_RST_TASK_WDT, ESP_RST_BROWNOUT};
+    for (esp_reset_reason_t reason : reasons) {
+        boot(reason);
+        assertCachedLayout();
+    }
+}
+
+void test_power_on_rescans(void) {
+    boot(ESP_RST_POWERON);
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasOneWireScan());
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasI2CScan());
+}
+
+void test_reset_without_nvs_copy_rescans(void) {
+    clearNvs();
+    boot(ESP_RST_SW);
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasOneWireScan());
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasI2CScan());
+}
+
+void test_damaged_nvs_copy_rescans(void) {
+    Preferences preferences;
+    preferences.begin(Config::BUS_CACHE_NVS_NAMESPACE, false);
+    size_t length = preferences.getBytesLength("record");
+    uint8_t stored[256];
+    TEST_ASSERT_EQUAL(length, preferences.getBytes("record", stored, sizeof(stored)));
+    stored[length / 2] ^= 0x01;
+    preferences.putBytes("record", stored, length);
+    preferences.end();
+
+    boot(ESP_RST_SW);
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasOneWireScan());
+}
+
+void test_invalidated_bus_is_not_restored(void) {
+    BusDiscoveryCache::invalidateOneWire();
+    boot(ESP_RST_SW);
+    TEST_ASSERT_FALSE(BusDiscoveryCache::hasOneWireScan());
+    TEST_ASSERT_TRUE(BusDiscoveryCache::hasI2CScan());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_deep_sleep_wake_uses_rtc_copy);
+    RUN_TEST(test_resets_that_clear_rtc_restore_from_nvs);
+    RUN_TEST(test_power_on_rescans);
+    RUN_TEST(test_reset_without_nvs_copy_rescans);
+    RUN_TEST(test_damaged_nvs_copy_rescans);
+    RUN_TEST(test_invalidated_bus_is_not_restored);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_main.cpp
+ * @brief DS18B20Bus adaptive resolution on the simulated probe: a stable probe
+ *        is published at full resolution and passes the deadband only once
+ */
+
+#include <unity.h>
+#include <vector>
+#include "DS18B20Bus.h"
+#include "DeadbandFilter.h"
+#include "NativeSimulation.h"
+
+namespace {
+
+uint32_t wakeClock = 0;
+
+/**
+ * @brief Read probe 0 the way DS18B20Sensor does on one wake
+ */
+float readOnce(uint8_t* resolution = nullptr) {
+    DS18B20Bus bus;
+    TEST_ASSERT_TRUE(bus.begin());
+    TEST_ASSERT_TRUE(bus.requestConversion(0));
+    while (!bus.poll()) {
+        native::spendMillis(10);
+    }
+    float temperature = bus.readTemperature(0);
+    bus.releaseConversion(0);
+    if (resolution != nullptr) {
+        *resolution = bus.getResolution();
+    }
+    return temperature;
+}
+
+/**
+ * @brief Pass one wake's reading through the deadband
+ * @return true if it would be uploaded
+ */
+bool publish(float temperature) {
+    std::vector<IDataPublisher::DataPoint> points;
+    points.emplace_back("fridge", MeasurementKind::TEMPERATURE, temperature);
+    wakeClock += 300;
+    DeadbandFilter::apply(points, wakeClock);
+    return !points.empty();
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+}
+
+void tearDown(void) {
+}
+
+void test_stable_probe_is_published_once(void) {
+    // Noise around 8.25 °C crosses the 9-bit steps at 8.0 and 7.5 °C but stays
+    // well within the stable drift
+    const float noise[] = {8.25f, 8.30f, 7.98f, 8.20f, 8.27f, 7.95f, 8.25f, 8.10f};
+
+    native::simulation().ds18b20Temperature = noise[0];
+    uint8_t resolution = 0;
+    float first = readOnce(&resolution);
+    TEST_ASSERT_EQUAL(Config::DS18B20_RESOLUTION, resolution);
+    TEST_ASSERT_EQUAL_FLOAT(8.25f, first);
+    TEST_ASSERT_TRUE(publish(first));
+
+    int uploads = 0;
+    for (float temperature : noise) {
+        native::simulation().ds18b20Temperature = temperature;
+        float reading = readOnce(&resolution);
+        TEST_ASSERT_EQUAL(Config::DS18B20_FAST_RESOLUTION, resolution);
+        TEST_ASSERT_EQUAL_FLOAT(first, reading);
+        uploads += publish(reading) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(0, uploads);
+}
+
+void test_drifting_probe_is_read_at_full_resolution(void) {
+    native::simulation().ds18b20Temperature = 8.25f;
+    float reference = readOnce();
+
+    native::simulation().ds18b20Temperature = 10.3f;
+    uint8_t resolution = 0;
+    float reading = readOnce(&resolution);
+    TEST_ASSERT_EQUAL(Config::DS18B20_RESOLUTION, resolution);
+    TEST_ASSERT_EQUAL_FLOAT(10.25f, reading);
+    TEST_ASSERT_TRUE(reading != reference);
+    TEST_ASSERT_TRUE(publish(reading));
+
+    // The new full-resolution reading is the reference from now on
+    native::simulation().ds18b20Temperature = 10.4f;
+    TEST_ASSERT_EQUAL_FLOAT(10.25f, readOnce(&resolution));
+    TEST_ASSERT_EQUAL(Config::DS18B20_FAST_RESOLUTION, resolution);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stable_probe_is_published_once);
+    RUN_TEST(test_drifting_probe_is_read_at_full_resolution);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_main.cpp
+ * @brief LatestReadingClient incremental polling against the PostgREST
+ *        stand-in
+ */
+
+#include <unity.h>
+#include "LatestReadingClient.h"
+#include "NativeSimulation.h"
+#include "WiFi.h"
+
+namespace {
+
+constexpr const char* FIRST_ROW = "2026-01-01T00:00:00+00:00";
+constexpr const char* SECOND_ROW = "2026-01-01T00:15:00+00:00";
+
+Supabase supabase;
+
+LatestReadingClient makeClient() {
+    return LatestReadingClient(supabase, "sensor_readings", "alex-outside", "temperature");
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    native::Simulation& sim = native::simulation();
+    sim.wifiAvailable = true;
+    sim.httpsResponseCode = 200;
+    sim.selectRowValue = 4.5f;
+    sim.selectRowCreatedAt = FIRST_ROW;
+    sim.selectResponseBody = nullptr;
+    native::clock().startBoot();
+    WiFi.begin("greenhouse", "secret");
+    delay(5000);
+}
+
+void tearDown(void) {
+    WiFi.disconnect(true);
+}
+
+void test_first_poll_returns_the_newest_row(void) {
+    LatestReadingClient client = makeClient();
+    TEST_ASSERT_FALSE(client.hasValue());
+
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::UPDATED);
+    TEST_ASSERT_TRUE(client.hasValue());
+    TEST_ASSERT_EQUAL_FLOAT(4.5f, client.getValue());
+    TEST_ASSERT_EQUAL_STRING(FIRST_ROW, client.getCreatedAt());
+}
+
+void test_no_newer_row_is_unchanged(void) {
+    LatestReadingClient client = makeClient();
+    client.poll();
+
+    // The stand-in answers [] because created_at=gt. is not older than its row
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::UNCHANGED);
+    TEST_ASSERT_EQUAL_FLOAT(4.5f, client.getValue());
+    TEST_ASSERT_EQUAL_STRING(FIRST_ROW, client.getCreatedAt());
+}
+
+void test_cursor_advances_to_the_newer_row(void) {
+    LatestReadingClient client = makeClient();
+    client.poll();
+
+    native::simulation().selectRowValue = 5.25f;
+    native::simulation().selectRowCreatedAt = SECOND_ROW;
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::UPDATED);
+    TEST_ASSERT_EQUAL_FLOAT(5.25f, client.getValue());
+    TEST_ASSERT_EQUAL_STRING(SECOND_ROW, client.getCreatedAt());
+
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::UNCHANGED);
+}
+
+void test_extra_columns_are_filtered_out(void) {
+    native::simulation().selectResponseBody =
+        "[{\"id\":812,\"location\":\"alex-outside\",\"value\":6.75,\"created_at\":\"2026-01-01T00:30:00+00:00\"}]";
+    LatestReadingClient client = makeClient();
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::UPDATED);
+    TEST_ASSERT_EQUAL_FLOAT(6.75f, client.getValue());
+    TEST_ASSERT_EQUAL_STRING("2026-01-01T00:30:00+00:00", client.getCreatedAt());
+}
+
+void test_malformed_json_keeps_the_last_value(void) {
+    LatestReadingClient client = makeClient();
+    client.poll();
+
+    const char* malformed[] = {
+        "[{\"value\":5.0,\"created_at\":",              // Cut off
+        "[{\"value\":5.0 \"created_at\":\"x\"}]",       // Missing comma
+        "[{\"created_at\":\"2026-01-01T00:45:00+00:00\"}]", // No value
+        "[{\"value\":\"5.0\",\"created_at\":\"2026-01-01T00:45:00+00:00\"}]", // Value not a number
+        "{\"message\":\"permission denied\"}",           // Error object instead of rows
+    };
+    for (const char* body : malformed) {
+        native::simulation().selectResponseBody = body;
+        TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::FAILED);
+        TEST_ASSERT_EQUAL_FLOAT(4.5f, client.getValue());
+        TEST_ASSERT_EQUAL_STRING(FIRST_ROW, client.getCreatedAt());
+    }
+}
+
+void test_request_failure_keeps_the_last_value(void) {
+    LatestReadingClient client = makeClient();
+    client.poll();
+
+    native::simulation().httpsResponseCode = 503;
+    TEST_ASSERT_TRUE(client.poll() == LatestReadingClient::Result::FAILED);
+    TEST_ASSERT_EQUAL_FLOAT(4.5f, client.getValue());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_poll_returns_the_newest_row);
+    RUN_TEST(test_no_newer_row_is_unchanged);
+    RUN_TEST(test_cursor_advances_to_the_newer_row);
+    RUN_TEST(test_extra_columns_are_filtered_out);
+    RUN_TEST(test_malformed_json_keeps_the_last_value);
+    RUN_TEST(test_request_failure_keeps_the_last_value);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_main.cpp
+ * @brief MqttPublisher batching, retained topics and reconnect policy against
+ *        the in-process broker of the PubSubClient stand-in
+ */
+
+#include <unity.h>
+#include "NativeSimulation.h"
+#include "MqttPublisher.h"
+
+namespace {
+
+using DataPoint = IDataPublisher::DataPoint;
+
+constexpr uint32_t UTC_BASE = 1767225600; // 2026-01-01T00:00:00Z
+
+int countOf(const char* text, const char* pattern) {
+    int count = 0;
+    for (const char* at = strstr(text, pattern); at != nullptr; at = strstr(at + 1, pattern)) {
+        count++;
+    }
+    return count;
+}
+
+std::vector<DataPoint> makePoints(size_t count) {
+    std::vector<DataPoint> points;
+    for (size_t i = 0; i < count; i++) {
+        points.emplace_back(i % 2 == 0 ? "room" : "cellar", MeasurementKind::TEMPERATURE,
+                            20.0f + i * 0.25f, UTC_BASE + (uint32_t)i * 60);
+    }
+    return points;
+}
+
+MqttPublisher makePublisher() {
+    return MqttPublisher("broker.local", 1883, nullptr, nullptr, "node-7");
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    native::simulation().wifiAvailable = true;
+    native::simulation().mqttAvailable = true;
+    native::clock().startBoot();
+    WiFi.begin("greenhouse", "secret");
+    delay(5000);
+}
+
+void tearDown(void) {
+    WiFi.disconnect(true);
+}
+
+void test_initialize_announces_the_device_online(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+    TEST_ASSERT_TRUE(publisher.isReady());
+
+    TEST_ASSERT_EQUAL_STRING("sensors/node-7/readings", publisher.getReadingsTopic());
+    TEST_ASSERT_NOT_NULL(PubSubClient::getRetained("sensors/node-7/status"));
+    TEST_ASSERT_EQUAL_STRING("online", PubSubClient::getRetained("sensors/node-7/status"));
+}
+
+void test_cycle_is_one_message(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+    std::vector<DataPoint> points = makePoints(6);
+
+    int before = PubSubClient::getMessageCount();
+    TEST_ASSERT_EQUAL(6, publisher.publishCycle(points));
+    TEST_ASSERT_EQUAL(before + 1, PubSubClient::getMessageCount());
+    for (const auto& point : points) {
+        TEST_ASSERT_TRUE(point.published);
+    }
+
+    // History is not retained
+    TEST_ASSERT_EQUAL_STRING("sensors/node-7/readings", PubSubClient::getLastTopic());
+    TEST_ASSERT_FALSE(PubSubClient::wasLastRetained());
+    const char* payload = PubSubClient::getLastPayload();
+    TEST_ASSERT_EQUAL(6, countOf(payload, "\"type\":\"temperature\""));
+    TEST_ASSERT_NOT_NULL(strstr(payload, "{\"device\":\"node-7\",\"readings\":[{\"location\":\"room\""));
+    TEST_ASSERT_NOT_NULL(strstr(payload, "\"value\":21.25,\"ts\":1767225900}]}"));
+}
+
+void test_cycle_larger_than_the_buffer_is_split(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+    std::vector<DataPoint> points = makePoints(40);
+
+    int before = PubSubClient::getMessageCount();
+    TEST_ASSERT_EQUAL(40, publisher.publishCycle(points));
+    int messages = PubSubClient::getMessageCount() - before;
+    TEST_ASSERT_GREATER_THAN(1, messages);
+    TEST_ASSERT_LESS_THAN(5, messages);
+    TEST_ASSERT_LESS_THAN(Config::MQTT_BUFFER_SIZE, strlen(PubSubClient::getLastPayload()));
+    TEST_ASSERT_NOT_NULL(strstr(PubSubClient::getLastPayload(), "\"value\":29.75"));
+}
+
+void test_single_reading_is_retained_per_location_and_type(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+
+    TEST_ASSERT_TRUE(publisher.publish("room", "humidity", 48.0f).success);
+    TEST_ASSERT_TRUE(PubSubClient::wasLastRetained());
+    TEST_ASSERT_EQUAL_STRING("48.00", PubSubClient::getRetained("sensors/node-7/room/humidity"));
+}
+
+void test_batch_skips_failed_readings(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+    ISensor::Readings readings;
+    readings.push_back(ISensor::Reading(MeasurementKind::TEMPERATURE, 21.5f));
+    readings.push_back(ISensor::Reading::failed(MeasurementKind::HUMIDITY, ISensor::Status::COMMUNICATION_ERROR,
+                                                ISensor::ErrorCode::COMMUNICATION));
+
+    TEST_ASSERT_EQUAL(1, publisher.publishBatch("DHT11", "room", readings));
+    const char* payload = PubSubClient::getLastPayload();
+    TEST_ASSERT_NOT_NULL(strstr(payload, "\"sensor\":\"DHT11\""));
+    TEST_ASSERT_EQUAL(1, countOf(payload, "\"location\""));
+    TEST_ASSERT_NULL(strstr(payload, "humidity"));
+}
+
+void test_unreachable_broker_blocks_once_per_interval(void) {
+    MqttPublisher publisher = makePublisher();
+    native::simulation().mqttAvailable = false;
+
+    unsigned long start = millis();
+    TEST_ASSERT_FALSE(publisher.initialize());
+    TEST_ASSERT_LESS_OR_EQUAL(Config::MQTT_CONNECT_BUDGET_MS, millis() - start);
+
+    // Further attempts fail fast until the reconnect interval has passed
+    std::vector<DataPoint> points = makePoints(3);
+    start = millis();
+    TEST_ASSERT_EQUAL(0, publisher.publishCycle(points));
+    TEST_ASSERT_EQUAL_UINT32(0, millis() - start);
+    TEST_ASSERT_FALSE(points[0].published);
+
+    native::simulation().mqttAvailable = true;
+    TEST_ASSERT_EQUAL(0, publisher.publishCycle(points));
+    delay(Config::MQTT_RECONNECT_INTERVAL_MS);
+    TEST_ASSERT_EQUAL(3, publisher.publishCycle(points));
+    TEST_ASSERT_TRUE(publisher.isReady());
+}
+
+void test_lost_connection_is_restored_on_publish(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+
+    native::simulation().mqttAvailable = false;
+    TEST_ASSERT_FALSE(publisher.isReady());
+    native::simulation().mqttAvailable = true;
+
+    std::vector<DataPoint> points = makePoints(2);
+    TEST_ASSERT_EQUAL(2, publisher.publishCycle(points));
+}
+
+void test_disconnect_marks_the_device_offline(void) {
+    MqttPublisher publisher = makePublisher();
+    TEST_ASSERT_TRUE(publisher.initialize());
+    publisher.disconnect();
+
+    TEST_ASSERT_FALSE(publisher.isReady());
+    TEST_ASSERT_EQUAL_STRING("offline", PubSubClient::getRetained("sensors/node-7/status"));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_initialize_announces_the_device_online);
+    RUN_TEST(test_cycle_is_one_message);
+    RUN_TEST(test_cycle_larger_than_the_buffer_is_split);
+    RUN_TEST(test_single_reading_is_retained_per_location_and_type);
+    RUN_TEST(test_batch_skips_failed_readings);
+    RUN_TEST(test_unreachable_broker_blocks_once_per_interval);
+    RUN_TEST(test_lost_connection_is_restored_on_publish);
+    RUN_TEST(test_disconnect_marks_the_device_offline);
+    return UNITY_END();
+}
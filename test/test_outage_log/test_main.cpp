@@ -0,0 +1,244 @@
+/**
+ * @file test_main.cpp
+ * @brief OutageLog append, replay and torn-frame recovery on the LittleFS stand-in
+ */
+
+#include <unity.h>
+#include <unistd.h>
+#include <string>
+#include <LittleFS.h>
+#include "NativeSimulation.h"
+#include "OutageLog.h"
+
+namespace {
+
+using DataPoint = IDataPublisher::DataPoint;
+
+constexpr uint32_t UTC_BASE = 1767225600; // 2026-01-01T00:00:00Z
+
+/**
+ * @brief Publisher that records what it is given and can be made to fail
+ */
+class RecordingPublisher : public IDataPublisher {
+public:
+    std::vector<DataPoint> received;
+    std::vector<std::string> receivedLocations; // The points' names only last for the cycle
+    bool failing = false;
+    int cycles = 0;
+
+    bool initialize() override { return true; }
+    bool isReady() const override { return true; }
+    PublishResult publish(const String&, const String&, float) override { return PublishResult(!failing); }
+    int publishBatch(const String&, const String&, const ISensor::Readings&) override { return 0; }
+    String getName() const override { return "Recording"; }
+
+    int publishCycle(std::vector<DataPoint>& points) override {
+        cycles++;
+        if (failing) {
+            return 0;
+        }
+        for (auto& point : points) {
+            point.published = true;
+            received.push_back(point);
+            receivedLocations.push_back(point.location);
+        }
+        return (int)points.size();
+    }
+};
+
+char flashDirectory[] = "/tmp/outage-log-test-XXXXXX";
+
+std::vector<DataPoint> makePoints(size_t count, uint32_t firstTimestamp) {
+    static const char* LOCATIONS[] = {"room", "outside", "cellar"};
+    std::vector<DataPoint> points;
+    for (size_t i = 0; i < count; i++) {
+        points.emplace_back(LOCATIONS[i % 3], MeasurementKind::TEMPERATURE, 20.0f + i * 0.25f,
+                            firstTimestamp != 0 ? firstTimestamp + (uint32_t)i * 60 : 0);
+    }
+    return points;
+}
+
+void appendRaw(const char* path, const uint8_t* bytes, size_t length) {
+    LittleFS.begin();
+    File file = LittleFS.open(path, FILE_APPEND);
+    TEST_ASSERT_TRUE(file);
+    TEST_ASSERT_EQUAL(length, file.write(bytes, length));
+    file.close();
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    strcpy(flashDirectory + strlen(flashDirectory) - 6, "XXXXXX");
+    native::simulation().flashDirectory = mkdtemp(flashDirectory);
+    OutageLog::unmount();
+}
+
+void tearDown(void) {
+    LittleFS.begin();
+    LittleFS.format();
+    OutageLog::unmount();
+    rmdir(native::simulation().flashDirectory);
+}
+
+void test_empty_log_has_nothing_pending(void) {
+    RecordingPublisher publisher;
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+    TEST_ASSERT_EQUAL(0, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_EQUAL(0, publisher.cycles);
+}
+
+void test_replay_returns_appended_points(void) {
+    RecordingPublisher publisher;
+    std::vector<DataPoint> points = makePoints(5, UTC_BASE);
+    points.emplace_back("room", MeasurementKind::CO2, 612.0f, UTC_BASE + 30);
+
+    TEST_ASSERT_TRUE(OutageLog::append(points, OutageLog::TimeBase::UTC));
+    TEST_ASSERT_TRUE(OutageLog::hasPending());
+
+    TEST_ASSERT_EQUAL(points.size(), OutageLog::replay(publisher, UTC_BASE + 3600, 0));
+    TEST_ASSERT_EQUAL(points.size(), publisher.received.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        TEST_ASSERT_EQUAL_STRING(points[i].location, publisher.receivedLocations[i].c_str());
+        TEST_ASSERT_EQUAL(points[i].kind, publisher.received[i].kind);
+        TEST_ASSERT_FLOAT_WITHIN(0.005f, points[i].value, publisher.received[i].value);
+        TEST_ASSERT_EQUAL_UINT32(points[i].timestamp, publisher.received[i].timestamp);
+    }
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+}
+
+void test_buffer_clock_times_are_converted_at_replay(void) {
+    RecordingPublisher publisher;
+    std::vector<DataPoint> points;
+    points.emplace_back("room", MeasurementKind::HUMIDITY, 48.0f, 1000);
+    TEST_ASSERT_TRUE(OutageLog::append(points, OutageLog::TimeBase::BUFFER_CLOCK));
+
+    // Read 600 s before the replay
+    TEST_ASSERT_EQUAL(1, OutageLog::replay(publisher, UTC_BASE, 1600));
+    TEST_ASSERT_EQUAL_UINT32(UTC_BASE - 600, publisher.received[0].timestamp);
+}
+
+void test_buffer_clock_times_from_before_a_power_loss_are_dropped(void) {
+    RecordingPublisher publisher;
+    std::vector<DataPoint> points;
+    points.emplace_back("room", MeasurementKind::HUMIDITY, 48.0f, 5000);
+    TEST_ASSERT_TRUE(OutageLog::append(points, OutageLog::TimeBase::BUFFER_CLOCK));
+
+    // The clock restarted below the reading's time: upload without a timestamp
+    TEST_ASSERT_EQUAL(1, OutageLog::replay(publisher, UTC_BASE, 20));
+    TEST_ASSERT_EQUAL_UINT32(0, publisher.received[0].timestamp);
+}
+
+void test_failed_replay_keeps_the_log(void) {
+    RecordingPublisher publisher;
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(4, UTC_BASE), OutageLog::TimeBase::UTC));
+    uint32_t pendingBytes = OutageLog::getPendingBytes();
+
+    publisher.failing = true;
+    TEST_ASSERT_EQUAL(0, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_EQUAL_UINT32(pendingBytes, OutageLog::getPendingBytes());
+
+    publisher.failing = false;
+    TEST_ASSERT_EQUAL(4, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+}
+
+void test_log_survives_a_reboot(void) {
+    RecordingPublisher publisher;
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(3, UTC_BASE), OutageLog::TimeBase::UTC));
+    OutageLog::unmount();
+
+    TEST_ASSERT_TRUE(OutageLog::hasPending());
+    TEST_ASSERT_EQUAL(3, OutageLog::replay(publisher, UTC_BASE, 0));
+}
+
+void test_replay_is_bounded_per_wake(void) {
+    RecordingPublisher publisher;
+    const size_t perWake = Config::OUTAGE_LOG_REPLAY_BATCH_SIZE * Config::OUTAGE_LOG_REPLAY_BATCHES_PER_WAKE;
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(perWake + 10, UTC_BASE), OutageLog::TimeBase::UTC));
+
+    TEST_ASSERT_EQUAL(perWake, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_EQUAL(Config::OUTAGE_LOG_REPLAY_BATCHES_PER_WAKE, publisher.cycles);
+    TEST_ASSERT_TRUE(OutageLog::hasPending());
+
+    TEST_ASSERT_EQUAL(10, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 20.0f + (perWake + 9) * 0.25f, publisher.received.back().value);
+}
+
+void test_torn_frame_is_skipped_and_new_frames_go_to_a_new_segment(void) {
+    RecordingPublisher publisher;
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(3, UTC_BASE), OutageLog::TimeBase::UTC));
+
+    // Power lost halfway through the next frame: its header made it to flash,
+    // the cursor update did not
+    OutageLog::unmount();
+    const uint8_t torn[] = {0x4F, 0x4C, 0x00, 0x01, 0x02, 0x00, 0x1E};
+    appendRaw("/outage/00000001.log", torn, sizeof(torn));
+
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(2, UTC_BASE + 3600), OutageLog::TimeBase::UTC));
+    TEST_ASSERT_TRUE(LittleFS.exists("/outage/00000002.log"));
+
+    TEST_ASSERT_EQUAL(5, OutageLog::replay(publisher, UTC_BASE + 7200, 0));
+    TEST_ASSERT_EQUAL_UINT32(UTC_BASE, publisher.received[0].timestamp);
+    TEST_ASSERT_EQUAL_UINT32(UTC_BASE + 3600, publisher.received[3].timestamp);
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+}
+
+void test_corrupted_frame_is_not_replayed(void) {
+    RecordingPublisher publisher;
+    TEST_ASSERT_TRUE(OutageLog::append(makePoints(3, UTC_BASE), OutageLog::TimeBase::UTC));
+    OutageLog::unmount();
+
+    // Flip a value byte without touching the length: only the CRC catches it
+    LittleFS.begin();
+    File file = LittleFS.open("/outage/00000001.log", FILE_READ);
+    size_t size = file.size();
+    uint8_t bytes[256];
+    TEST_ASSERT_EQUAL(size, file.read(bytes, size));
+    file.close();
+    bytes[size - 8] ^= 0x40;
+    file = LittleFS.open("/outage/00000001.log", FILE_WRITE);
+    file.write(bytes, size);
+    file.close();
+
+    TEST_ASSERT_EQUAL(0, OutageLog::replay(publisher, UTC_BASE, 0));
+    TEST_ASSERT_EQUAL(0, publisher.cycles);
+    TEST_ASSERT_FALSE(OutageLog::hasPending());
+}
+
+void test_replay_keeps_names_across_many_locations(void) {
+    // More distinct names than one replay batch holds
+    char names[40][8];
+    std::vector<DataPoint> points;
+    for (size_t i = 0; i < 40; i++) {
+        snprintf(names[i], sizeof(names[i]), "loc%02d", (int)i);
+        points.emplace_back(names[i], MeasurementKind::HUMIDITY, 40.0f + i, UTC_BASE + (uint32_t)i);
+    }
+    TEST_ASSERT_TRUE(OutageLog::append(points, OutageLog::TimeBase::UTC));
+
+    RecordingPublisher publisher;
+    TEST_ASSERT_EQUAL(points.size(), OutageLog::replay(publisher, UTC_BASE + 3600, 0));
+    TEST_ASSERT_TRUE(publisher.cycles > 1);
+    TEST_ASSERT_EQUAL(points.size(), publisher.receivedLocations.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        TEST_ASSERT_EQUAL_STRING(names[i], publisher.receivedLocations[i].c_str());
+        TEST_ASSERT_FLOAT_WITHIN(0.005f, 40.0f + i, publisher.received[i].value);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_log_has_nothing_pending);
+    RUN_TEST(test_replay_returns_appended_points);
+    RUN_TEST(test_buffer_clock_times_are_converted_at_replay);
+    RUN_TEST(test_buffer_clock_times_from_before_a_power_loss_are_dropped);
+    RUN_TEST(test_failed_replay_keeps_the_log);
+    RUN_TEST(test_log_survives_a_reboot);
+    RUN_TEST(test_replay_is_bounded_per_wake);
+    RUN_TEST(test_torn_frame_is_skipped_and_new_frames_go_to_a_new_segment);
+    RUN_TEST(test_corrupted_frame_is_not_replayed);
+    RUN_TEST(test_replay_keeps_names_across_many_locations);
+    return UNITY_END();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_main.cpp
+ * @brief ReadingBuffer upload schedule on the buffer clock, across simulated wakes
+ */
+
+#include <unity.h>
+#include "NativeSimulation.h"
+#include "ReadingBuffer.h"
+
+namespace {
+
+/**
+ * @brief Sleep as the firmware does: advance the buffer clock, then the virtual clock
+ */
+void sleepFor(uint32_t seconds) {
+    ReadingBuffer::prepareSleep(seconds);
+    native::clock().advanceMicros(static_cast<uint64_t>(seconds) * 1000000ULL);
+}
+
+void wake(size_t points = 0) {
+    native::clock().startBoot();
+    ReadingBuffer::beginWake();
+    for (size_t i = 0; i < points; i++) {
+        ReadingBuffer::append(IDataPublisher::DataPoint("room", MeasurementKind::TEMPERATURE, 20.0f + i));
+    }
+}
+
+/**
+ * @brief Wake every sleepSeconds until an upload is due
+ * @return Buffer clock seconds from the call to the due wake
+ */
+uint32_t secondsUntilDue(uint32_t sleepSeconds) {
+    uint32_t start = ReadingBuffer::getClockSeconds();
+    for (int i = 0; i < 1000; i++) {
+        sleepFor(sleepSeconds);
+        wake(1);
+        if (ReadingBuffer::isUploadDue()) {
+            uint32_t elapsed = ReadingBuffer::getClockSeconds() - start;
+            ReadingBuffer::clear();
+            return elapsed;
+        }
+    }
+    TEST_FAIL_MESSAGE("upload never became due");
+    return 0;
+}
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+}
+
+void tearDown(void) {
+    ReadingBuffer::clear();
+}
+
+// Must run first: RTC memory is only zeroed when the process starts
+void test_upload_is_due_at_power_on(void) {
+    wake();
+    TEST_ASSERT_TRUE(ReadingBuffer::isUploadDue());
+    TEST_ASSERT_EQUAL_UINT32(0, ReadingBuffer::getSecondsUntilUpload());
+
+    ReadingBuffer::clear();
+    TEST_ASSERT_FALSE(ReadingBuffer::isUploadDue());
+    TEST_ASSERT_EQUAL_UINT32(Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS,
+                             ReadingBuffer::getSecondsUntilUpload());
+}
+
+void test_upload_interval_is_time_based(void) {
+    // The same interval however often the node wakes
+    TEST_ASSERT_EQUAL_UINT32(Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS, secondsUntilDue(300));
+    TEST_ASSERT_EQUAL_UINT32(Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS, secondsUntilDue(900));
+    TEST_ASSERT_EQUAL_UINT32(Config::READING_BUFFER_UPLOAD_INTERVAL_SECONDS, secondsUntilDue(1800));
+
+    // Due on the first wake past the interval
+    TEST_ASSERT_EQUAL_UINT32(3 * 1400, secondsUntilDue(1400));
+}
+
+void test_upload_is_due_before_the_buffer_overflows(void) {
+    ReadingBuffer::clear();
+    const size_t perWake = Config::READING_BUFFER_CAPACITY / 3;
+
+    sleepFor(60);
+    wake(perWake);
+    TEST_ASSERT_FALSE(ReadingBuffer::isUploadDue());
+
+    // Two more wakes like the last one would no longer fit
+    sleepFor(60);
+    wake(perWake);
+    TEST_ASSERT_TRUE(ReadingBuffer::isUploadDue());
+    TEST_ASSERT_EQUAL(2 * perWake, ReadingBuffer::getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, ReadingBuffer::getDroppedCount());
+}
+
+void test_timestamps_follow_the_buffer_clock(void) {
+    ReadingBuffer::clear();
+    wake(1);
+    sleepFor(600);
+    wake(1);
+
+    const uint32_t utcNow = 1767225600;
+    std::vector<IDataPublisher::DataPoint> points = ReadingBuffer::getDataPoints(utcNow);
+    TEST_ASSERT_EQUAL(2, points.size());
+    TEST_ASSERT_EQUAL_UINT32(utcNow - 600, points[0].timestamp);
+    TEST_ASSERT_EQUAL_UINT32(utcNow, points[1].timestamp);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 20.0f, points[1].value);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_upload_is_due_at_power_on);
+    RUN_TEST(test_upload_interval_is_time_based);
+    RUN_TEST(test_upload_is_due_before_the_buffer_overflows);
+    RUN_TEST(test_timestamps_follow_the_buffer_clock);
+    return UNITY_END();
+}
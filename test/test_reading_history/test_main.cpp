@@ -0,0 +1,95 @@
+/**
+ * @file test_main.cpp
+ * @brief ReadingHistory slot averaging and gaps for time without readings
+ */
+
+#include <unity.h>
+#include "ReadingHistory.h"
+
+namespace {
+
+constexpr uint32_t SLOT = Config::HISTORY_SLOT_SECONDS;
+
+// One clock for the whole run: the ring is process-wide like RTC memory
+uint32_t now = 0;
+
+} // namespace
+
+void setUp(void) {
+    // Start each test on a fresh slot boundary
+    now = (now / SLOT + 2) * SLOT;
+    ReadingHistory::advance(now);
+}
+
+void tearDown(void) {
+}
+
+void test_slot_holds_the_average_of_its_readings(void) {
+    ReadingHistory::add(4.0f, now);
+    ReadingHistory::add(5.0f, now + 60);
+    ReadingHistory::add(6.0f, now + 120);
+    now += SLOT;
+    ReadingHistory::advance(now);
+
+    int16_t samples[1];
+    TEST_ASSERT_EQUAL(1, ReadingHistory::getSamples(samples, 1));
+    TEST_ASSERT_EQUAL_INT16(500, samples[0]);
+}
+
+void test_time_without_readings_becomes_gaps(void) {
+    ReadingHistory::add(4.0f, now);
+    uint32_t closedBefore = ReadingHistory::getClosedCount();
+
+    // An outage of three slots; drawing advances the ring without a reading
+    now += 3 * SLOT;
+    ReadingHistory::advance(now);
+    TEST_ASSERT_EQUAL_UINT32(closedBefore + 3, ReadingHistory::getClosedCount());
+
+    int16_t samples[3];
+    TEST_ASSERT_EQUAL(3, ReadingHistory::getSamples(samples, 3));
+    TEST_ASSERT_EQUAL_INT16(400, samples[0]);
+    TEST_ASSERT_EQUAL_INT16(ReadingHistory::NO_SAMPLE, samples[1]);
+    TEST_ASSERT_EQUAL_INT16(ReadingHistory::NO_SAMPLE, samples[2]);
+
+    float min = 0.0f;
+    float max = 0.0f;
+    TEST_ASSERT_TRUE(ReadingHistory::getRange(1, min, max));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, min);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, max);
+}
+
+void test_advance_does_not_change_the_open_slot(void) {
+    ReadingHistory::add(7.0f, now);
+    ReadingHistory::advance(now + 60);
+    ReadingHistory::add(9.0f, now + 120);
+    now += SLOT;
+    ReadingHistory::advance(now);
+
+    int16_t samples[1];
+    ReadingHistory::getSamples(samples, 1);
+    TEST_ASSERT_EQUAL_INT16(800, samples[0]);
+}
+
+void test_clock_going_backwards_restarts_the_open_slot(void) {
+    uint32_t closedBefore = ReadingHistory::getClosedCount();
+    ReadingHistory::add(3.0f, now + 100);
+
+    // millis() restarted after a reset
+    ReadingHistory::add(5.0f, 10);
+    TEST_ASSERT_EQUAL_UINT32(closedBefore, ReadingHistory::getClosedCount());
+    ReadingHistory::advance(10 + SLOT);
+
+    int16_t samples[1];
+    ReadingHistory::getSamples(samples, 1);
+    TEST_ASSERT_EQUAL_INT16(400, samples[0]);
+    now = 10 + SLOT;
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_slot_holds_the_average_of_its_readings);
+    RUN_TEST(test_time_without_readings_becomes_gaps);
+    RUN_TEST(test_advance_does_not_change_the_open_slot);
+    RUN_TEST(test_clock_going_backwards_restarts_the_open_slot);
+    return UNITY_END();
+}
@@ -0,0 +1,284 @@
+/**
+ * @file test_main.cpp
+ * @brief SensorSet concurrent acquisition on the virtual clock, without heap
+ *        allocations
+ */
+
+#include <unity.h>
+#include <string>
+#include "SensorSet.h"
+#include "DHT11Sensor.h"
+#include "DS18B20Sensor.h"
+#include "SCD41Sensor.h"
+
+namespace {
+
+constexpr uint32_t NEVER = 0xFFFFFFFF;
+
+/**
+ * @brief Sensor whose conversion takes a fixed time on the virtual clock
+ */
+class FakeSensor : public ISensor {
+public:
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::TEMPERATURE};
+    static constexpr MeasurementKind PUBLISHED_KINDS[] = {MeasurementKind::TEMPERATURE};
+
+    FakeSensor(const char* location, uint32_t conversionMs, float value)
+        : location(location), conversionMs(conversionMs), value(value) {}
+
+    bool startFails = false;
+    bool collectFails = false;
+    int started = 0;
+
+    bool initialize() override { initialized = true; return true; }
+    bool isReady() const override { return initialized; }
+    const char* getName() const override { return "Fake"; }
+    const char* getLocation() const override { return location; }
+    const char* label() const { return location; }
+
+    bool startReading() override {
+        if (startFails) {
+            setError(ErrorCode::COMMUNICATION, "start failed");
+            return false;
+        }
+        started++;
+        startedAt = millis();
+        return true;
+    }
+
+    bool isReadingComplete() override {
+        return conversionMs != NEVER && millis() - startedAt >= conversionMs;
+    }
+
+    bool collectReading(Readings& readings) override {
+        readings.clear();
+        if (collectFails) {
+            setError(ErrorCode::INVALID_DATA, "bad data");
+            return false;
+        }
+        readings.push_back(Reading(KINDS[0], value));
+        return true;
+    }
+
+protected:
+    const char* location;
+    uint32_t conversionMs;
+    float value;
+    unsigned long startedAt = 0;
+};
+
+/**
+ * @brief Reports humidity as well, but only temperature is published
+ */
+class FakeClimateSensor : public FakeSensor {
+public:
+    static constexpr MeasurementKind KINDS[] = {MeasurementKind::TEMPERATURE, MeasurementKind::HUMIDITY};
+    static constexpr MeasurementKind PUBLISHED_KINDS[] = {MeasurementKind::TEMPERATURE};
+
+    using FakeSensor::FakeSensor;
+
+    bool collectReading(Readings& readings) override {
+        if (!FakeSensor::collectReading(readings)) {
+            return false;
+        }
+        readings.push_back(Reading(MeasurementKind::HUMIDITY, 55.0f));
+        return true;
+    }
+};
+
+using Set = SensorSet<FakeSensor, FakeClimateSensor, FakeSensor>;
+
+Set makeSet(uint32_t firstMs, uint32_t secondMs, uint32_t thirdMs) {
+    return Set(FakeSensor("room", firstMs, 20.0f),
+               FakeClimateSensor("cellar", secondMs, 12.0f),
+               FakeSensor("outside", thirdMs, 4.0f));
+}
+
+/**
+ * @brief Records the order sensors complete in
+ */
+struct CompletionLog {
+    const char* order[Set::SIZE] = {};
+    size_t count = 0;
+
+    template <typename Sensor, typename Result>
+    void operator()(const Sensor& sensor, const Result& result) {
+        TEST_ASSERT_TRUE(result.completed);
+        TEST_ASSERT_LESS_THAN(Set::SIZE + 1, count + 1);
+        order[count++] = sensor.label();
+    }
+};
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    native::clock().startBoot();
+}
+
+void tearDown(void) {
+}
+
+void test_sizes_follow_the_sensor_kinds(void) {
+    TEST_ASSERT_EQUAL(3, Set::SIZE);
+    TEST_ASSERT_EQUAL(4, Set::MAX_READINGS);
+    TEST_ASSERT_EQUAL(3, Set::MAX_DATA_POINTS);
+}
+
+void test_acquisition_waits_for_the_slowest_sensor_not_the_sum(void) {
+    Set sensors = makeSet(750, 100, 2000);
+    TEST_ASSERT_TRUE(sensors.initialize());
+    CompletionLog log;
+
+    unsigned long start = millis();
+    TEST_ASSERT_EQUAL(3, sensors.run(log));
+    unsigned long elapsed = millis() - start;
+
+    TEST_ASSERT_GREATER_OR_EQUAL(2000, elapsed);
+    TEST_ASSERT_LESS_THAN(2000 + 2 * Config::SENSOR_POLL_INTERVAL_MS, elapsed);
+    TEST_ASSERT_EQUAL(1, sensors.get<0>().started);
+
+    // Each result is collected as soon as its sensor is done
+    TEST_ASSERT_EQUAL(3, log.count);
+    TEST_ASSERT_EQUAL_STRING("cellar", log.order[0]);
+    TEST_ASSERT_EQUAL_STRING("room", log.order[1]);
+    TEST_ASSERT_EQUAL_STRING("outside", log.order[2]);
+    TEST_ASSERT_UINT32_WITHIN(Config::SENSOR_POLL_INTERVAL_MS, 100, sensors.getResult<1>().durationMs);
+    TEST_ASSERT_UINT32_WITHIN(Config::SENSOR_POLL_INTERVAL_MS, 750, sensors.getResult<0>().durationMs);
+    TEST_ASSERT_UINT32_WITHIN(Config::SENSOR_POLL_INTERVAL_MS, 2000, sensors.getResult<2>().durationMs);
+    TEST_ASSERT_EQUAL(2, sensors.getResult<1>().readings.size());
+}
+
+void test_unfinished_sensor_times_out(void) {
+    Set sensors = makeSet(100, NEVER, 300);
+    sensors.initialize();
+    CompletionLog log;
+
+    unsigned long start = millis();
+    TEST_ASSERT_EQUAL(2, sensors.run(log, 1000));
+    TEST_ASSERT_UINT32_WITHIN(Config::SENSOR_POLL_INTERVAL_MS, 1000, millis() - start);
+
+    TEST_ASSERT_EQUAL(3, log.count);
+    TEST_ASSERT_EQUAL_STRING("cellar", log.order[2]);
+    TEST_ASSERT_TRUE(sensors.getResult<1>().completed);
+    TEST_ASSERT_FALSE(sensors.getResult<1>().success);
+    TEST_ASSERT_TRUE(sensors.getResult<2>().success);
+}
+
+void test_failed_start_does_not_hold_up_the_others(void) {
+    Set sensors = makeSet(500, 100, 200);
+    sensors.initialize();
+    sensors.get<0>().startFails = true;
+    CompletionLog log;
+
+    unsigned long start = millis();
+    TEST_ASSERT_EQUAL(2, sensors.run(log));
+    TEST_ASSERT_LESS_THAN(200 + 2 * Config::SENSOR_POLL_INTERVAL_MS, millis() - start);
+
+    // Reported before any conversion finished
+    TEST_ASSERT_EQUAL_STRING("room", log.order[0]);
+    TEST_ASSERT_FALSE(sensors.getResult<0>().success);
+    TEST_ASSERT_EQUAL_UINT32(0, sensors.getResult<0>().durationMs);
+}
+
+void test_data_points_cover_successful_published_kinds(void) {
+    Set sensors = makeSet(100, 100, 100);
+    sensors.initialize();
+    sensors.get<2>().collectFails = true;
+    TEST_ASSERT_EQUAL(2, sensors.run([](const auto&, const auto&) {}));
+
+    std::vector<IDataPublisher::DataPoint> points;
+    TEST_ASSERT_EQUAL(2, sensors.appendDataPoints(points));
+    TEST_ASSERT_EQUAL(2, points.size());
+    TEST_ASSERT_EQUAL_STRING("room", points[0].location);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f, points[0].value);
+    TEST_ASSERT_EQUAL_STRING("cellar", points[1].location);
+    TEST_ASSERT_EQUAL(MeasurementKind::TEMPERATURE, points[1].kind);
+}
+
+void test_results_are_reset_between_runs(void) {
+    Set sensors = makeSet(100, 100, 100);
+    sensors.initialize();
+    TEST_ASSERT_EQUAL(3, sensors.run([](const auto&, const auto&) {}));
+
+    sensors.get<0>().collectFails = true;
+    TEST_ASSERT_EQUAL(2, sensors.run([](const auto&, const auto&) {}));
+    TEST_ASSERT_FALSE(sensors.getResult<0>().success);
+    TEST_ASSERT_EQUAL(0, sensors.getResult<0>().readings.size());
+    TEST_ASSERT_EQUAL(2, sensors.get<0>().started);
+}
+
+void test_guard_counts_allocations(void) {
+    size_t before = native::guardedAllocationCount();
+    {
+        native::HeapAllocationGuard guard("test");
+        std::string text(64, 'x');
+        TEST_ASSERT_EQUAL(64, text.size());
+    }
+    TEST_ASSERT_EQUAL(before + 1, native::guardedAllocationCount());
+}
+
+void test_acquisition_does_not_allocate(void) {
+    // Failure, timeout and success paths, all of which print
+    Set sensors = makeSet(100, NEVER, 300);
+    sensors.initialize();
+    sensors.get<0>().collectFails = true;
+    sensors.get<2>().startFails = true;
+
+    size_t before = native::guardedAllocationCount();
+    sensors.run([](const auto& sensor, const auto& result) {
+        if (!result.success) {
+            Serial.printf("%s failed: %s\n", sensor.getName(), sensor.getErrorMessage());
+        }
+    }, 500);
+    TEST_ASSERT_EQUAL(before, native::guardedAllocationCount());
+}
+
+void test_data_points_do_not_allocate_once_reserved(void) {
+    Set sensors = makeSet(100, 100, 100);
+    sensors.initialize();
+    TEST_ASSERT_EQUAL(3, sensors.run([](const auto&, const auto&) {}));
+
+    std::vector<IDataPublisher::DataPoint> points;
+    points.reserve(Set::MAX_DATA_POINTS);
+    size_t before = native::guardedAllocationCount();
+    TEST_ASSERT_EQUAL(Set::MAX_DATA_POINTS, sensors.appendDataPoints(points));
+    TEST_ASSERT_EQUAL(before, native::guardedAllocationCount());
+    TEST_ASSERT_EQUAL_STRING("room", points[0].location);
+}
+
+void test_firmware_sensors_acquire_without_allocating(void) {
+    native::attachSimulatedDevices();
+    DS18B20Bus bus;
+    SensorSet<DHT11Sensor, DS18B20Sensor, SCD41Sensor> sensors(
+        DHT11Sensor("room"), DS18B20Sensor(bus, "fridge"), SCD41Sensor("room"));
+    TEST_ASSERT_TRUE(sensors.initialize());
+
+    size_t before = native::guardedAllocationCount();
+    TEST_ASSERT_EQUAL(3, sensors.run([](const auto&, const auto&) {}));
+    TEST_ASSERT_EQUAL(before, native::guardedAllocationCount());
+
+    // A sensor that stopped answering goes through the error paths
+    native::simulation().scd41Present = false;
+    native::attachSimulatedDevices();
+    before = native::guardedAllocationCount();
+    TEST_ASSERT_EQUAL(2, sensors.run([](const auto&, const auto&) {}));
+    native::simulation().scd41Present = true;
+    native::attachSimulatedDevices();
+    TEST_ASSERT_EQUAL(before, native::guardedAllocationCount());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sizes_follow_the_sensor_kinds);
+    RUN_TEST(test_acquisition_waits_for_the_slowest_sensor_not_the_sum);
+    RUN_TEST(test_unfinished_sensor_times_out);
+    RUN_TEST(test_failed_start_does_not_hold_up_the_others);
+    RUN_TEST(test_data_points_cover_successful_published_kinds);
+    RUN_TEST(test_results_are_reset_between_runs);
+    RUN_TEST(test_guard_counts_allocations);
+    RUN_TEST(test_acquisition_does_not_allocate);
+    RUN_TEST(test_data_points_do_not_allocate_once_reserved);
+    RUN_TEST(test_firmware_sensors_acquire_without_allocating);
+    return UNITY_END();
+}
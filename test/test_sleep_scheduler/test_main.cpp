@@ -0,0 +1,170 @@
+/**
+ * @file test_main.cpp
+ * @brief SleepScheduler policy and its response to a replayed temperature trace
+ */
+
+#include <unity.h>
+#include "SleepScheduler.h"
+
+namespace {
+
+using Trend = SleepScheduler::Trend;
+
+Trend trend(MeasurementKind kind, float value, float ratePerHour) {
+    Trend result;
+    result.kind = kind;
+    result.value = value;
+    result.ratePerHour = ratePerHour;
+    return result;
+}
+
+/**
+ * @brief Runs wakes against SleepScheduler's RTC state like the firmware does
+ */
+struct TraceRunner {
+    uint32_t clock = 0;
+    uint32_t previousSleep = 0;
+
+    uint32_t wake(float temperature) {
+        std::vector<IDataPublisher::DataPoint> points;
+        points.emplace_back("room", MeasurementKind::TEMPERATURE, temperature);
+        SleepScheduler::record(points, clock);
+
+        uint32_t sleep = SleepScheduler::nextSleepSeconds();
+        TEST_ASSERT_GREATER_OR_EQUAL(Config::SLEEP_MIN_SECONDS, sleep);
+        TEST_ASSERT_LESS_OR_EQUAL(Config::SLEEP_MAX_SECONDS, sleep);
+        if (previousSleep != 0) {
+            TEST_ASSERT_LESS_OR_EQUAL(previousSleep * 2, sleep);
+        }
+        previousSleep = sleep;
+        clock += sleep;
+        return sleep;
+    }
+};
+
+} // namespace
+
+void setUp(void) {
+    Serial.setMuted(true);
+    SleepScheduler::reset();
+}
+
+void tearDown(void) {
+}
+
+void test_no_trends_uses_the_default_sleep(void) {
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_DURATION_SECONDS,
+                             SleepScheduler::computeSleepSeconds(nullptr, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_DURATION_SECONDS,
+                             SleepScheduler::computeSleepSeconds(nullptr, 0, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_flat_readings_sleep_longest(void) {
+    Trend trends[] = {trend(MeasurementKind::TEMPERATURE, 20.0f, 0.0f),
+                      trend(MeasurementKind::HUMIDITY, 50.0f, 0.0f)};
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MAX_SECONDS,
+                             SleepScheduler::computeSleepSeconds(trends, 2, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_sleep_grows_at_most_twofold(void) {
+    Trend trends[] = {trend(MeasurementKind::TEMPERATURE, 20.0f, 0.0f)};
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_DURATION_SECONDS,
+                             SleepScheduler::computeSleepSeconds(trends, 1, 0));
+    TEST_ASSERT_EQUAL_UINT32(1800, SleepScheduler::computeSleepSeconds(trends, 1, 900));
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MAX_SECONDS, SleepScheduler::computeSleepSeconds(trends, 1, 1800));
+}
+
+void test_sleep_is_one_deadband_of_movement(void) {
+    // 1 °C/h takes 720 s to move the 0.2 °C deadband; shortening is immediate
+    Trend trends[] = {trend(MeasurementKind::TEMPERATURE, 20.0f, 1.0f)};
+    TEST_ASSERT_UINT32_WITHIN(1, 720, SleepScheduler::computeSleepSeconds(trends, 1, Config::SLEEP_MAX_SECONDS));
+
+    // A falling value counts the same
+    trends[0].ratePerHour = -1.0f;
+    TEST_ASSERT_UINT32_WITHIN(1, 720, SleepScheduler::computeSleepSeconds(trends, 1, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_fastest_stream_wins(void) {
+    // 20 %RH/h moves the 2 %RH deadband in 360 s
+    Trend trends[] = {trend(MeasurementKind::TEMPERATURE, 20.0f, 0.0f),
+                      trend(MeasurementKind::HUMIDITY, 50.0f, 20.0f),
+                      trend(MeasurementKind::CO2, 600.0f, 10.0f)};
+    TEST_ASSERT_UINT32_WITHIN(1, 360, SleepScheduler::computeSleepSeconds(trends, 3, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_sleep_is_clamped_to_the_minimum(void) {
+    Trend trends[] = {trend(MeasurementKind::TEMPERATURE, 20.0f, 10.0f)};
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MIN_SECONDS,
+                             SleepScheduler::computeSleepSeconds(trends, 1, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_close_to_an_alert_threshold_samples_fastest(void) {
+    Trend frost[] = {trend(MeasurementKind::TEMPERATURE, Config::DS18B20_ALERT_LOW_C + 0.5f, 0.0f)};
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MIN_SECONDS,
+                             SleepScheduler::computeSleepSeconds(frost, 1, Config::SLEEP_MAX_SECONDS));
+
+    Trend stale[] = {trend(MeasurementKind::CO2, Config::SLEEP_CO2_ALERT_PPM - 50.0f, 0.0f)};
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MIN_SECONDS,
+                             SleepScheduler::computeSleepSeconds(stale, 1, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_heading_for_a_threshold_wakes_twice_before_it(void) {
+    // 0.2 °C above the frost margin at -0.2 °C/h: one hour to go, so 30 min,
+    // although the deadband alone would allow the full hour
+    Trend frost[] = {trend(MeasurementKind::TEMPERATURE,
+                           Config::DS18B20_ALERT_LOW_C + Config::DS18B20_ALERT_MARGIN_C + 0.2f, -0.2f)};
+    TEST_ASSERT_UINT32_WITHIN(1, 1800, SleepScheduler::computeSleepSeconds(frost, 1, Config::SLEEP_MAX_SECONDS));
+
+    // 20 ppm below the CO2 margin at 60 ppm/h: 20 minutes to go
+    Trend co2[] = {trend(MeasurementKind::CO2,
+                         Config::SLEEP_CO2_ALERT_PPM - Config::SLEEP_CO2_ALERT_MARGIN_PPM - 20.0f, 60.0f)};
+    TEST_ASSERT_UINT32_WITHIN(1, 600, SleepScheduler::computeSleepSeconds(co2, 1, Config::SLEEP_MAX_SECONDS));
+}
+
+void test_trace_flat_ramp_flat(void) {
+    TraceRunner runner;
+
+    // Flat: the first wake has no trend, then the sleep doubles up to the maximum
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_DURATION_SECONDS, runner.wake(20.0f));
+    uint32_t sleep = 0;
+    for (int i = 0; i < 4 && sleep != Config::SLEEP_MAX_SECONDS; i++) {
+        sleep = runner.wake(20.0f);
+    }
+    TEST_ASSERT_EQUAL_UINT32(Config::SLEEP_MAX_SECONDS, sleep);
+
+    // A 2 °C/h ramp (a door left open) starts during that sleep. It shortens
+    // the sleep on every wake until it settles at one deadband of movement, 360 s
+    uint32_t rampStart = runner.clock - Config::SLEEP_MAX_SECONDS / 2;
+    auto ramp = [&]() { return 20.0f + 2.0f * (runner.clock - rampStart) / 3600.0f; };
+    sleep = Config::SLEEP_MAX_SECONDS;
+    for (int i = 0; i < Config::SLEEP_HISTORY_SAMPLES && sleep > 365; i++) {
+        uint32_t next = runner.wake(ramp());
+        TEST_ASSERT_LESS_THAN(sleep, next);
+        sleep = next;
+    }
+    TEST_ASSERT_UINT32_WITHIN(5, 360, sleep);
+    while (runner.clock - rampStart < 3 * 3600) {
+        TEST_ASSERT_UINT32_WITHIN(5, 360, runner.wake(ramp()));
+    }
+
+    // Flat again: back to the maximum once the ramp has left the history
+    float plateau = ramp();
+    int wakes = 0;
+    while (runner.wake(plateau) != Config::SLEEP_MAX_SECONDS) {
+        TEST_ASSERT_LESS_THAN(Config::SLEEP_HISTORY_SAMPLES + 8, ++wakes);
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_trends_uses_the_default_sleep);
+    RUN_TEST(test_flat_readings_sleep_longest);
+    RUN_TEST(test_sleep_grows_at_most_twofold);
+    RUN_TEST(test_sleep_is_one_deadband_of_movement);
+    RUN_TEST(test_fastest_stream_wins);
+    RUN_TEST(test_sleep_is_clamped_to_the_minimum);
+    RUN_TEST(test_close_to_an_alert_threshold_samples_fastest);
+    RUN_TEST(test_heading_for_a_threshold_wakes_twice_before_it);
+    RUN_TEST(test_trace_flat_ramp_flat);
+    return UNITY_END();
+}
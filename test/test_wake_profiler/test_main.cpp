@@ -0,0 +1,95 @@
+/**
+ * @file test_main.cpp
+ * @brief WakeProfiler statistics and its timed summary window
+ */
+
+#include <unity.h>
+#include "WakeProfiler.h"
+
+using Phase = WakeProfiler::Phase;
+
+void setUp(void) {
+    Serial.setMuted(true);
+    WakeProfiler::reset(0);
+}
+
+void tearDown(void) {
+}
+
+void test_records_min_mean_max(void) {
+    WakeProfiler::record(Phase::PUBLISH, 300);
+    WakeProfiler::record(Phase::PUBLISH, 100);
+    WakeProfiler::record(Phase::PUBLISH, 200);
+
+    const WakeProfiler::PhaseStats& stats = WakeProfiler::getStats(Phase::PUBLISH);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.minMs);
+    TEST_ASSERT_EQUAL_UINT32(200, stats.meanMs());
+    TEST_ASSERT_EQUAL_UINT32(300, stats.maxMs);
+    TEST_ASSERT_EQUAL_UINT32(0, WakeProfiler::getStats(Phase::WIFI_CONNECT).count);
+}
+
+void test_summary_is_due_after_the_interval_not_a_wake_count(void) {
+    // Few long sleeps
+    uint32_t clock = 0;
+    while (clock < Config::PROFILER_SUMMARY_INTERVAL_SECONDS) {
+        WakeProfiler::beginWake(clock);
+        TEST_ASSERT_FALSE(WakeProfiler::isSummaryDue(clock));
+        clock += 3600;
+    }
+    WakeProfiler::beginWake(clock);
+    TEST_ASSERT_TRUE(WakeProfiler::isSummaryDue(clock));
+    TEST_ASSERT_EQUAL_UINT32(Config::PROFILER_SUMMARY_INTERVAL_SECONDS / 3600 + 1, WakeProfiler::getWakeCount());
+
+    // Many short ones: a new window starts at the reset
+    WakeProfiler::reset(clock);
+    uint32_t windowStart = clock;
+    while (clock - windowStart < Config::PROFILER_SUMMARY_INTERVAL_SECONDS) {
+        WakeProfiler::beginWake(clock);
+        TEST_ASSERT_FALSE(WakeProfiler::isSummaryDue(clock));
+        clock += 300;
+    }
+    TEST_ASSERT_TRUE(WakeProfiler::isSummaryDue(clock));
+}
+
+void test_summary_payload_lists_every_phase(void) {
+    WakeProfiler::beginWake(0);
+    WakeProfiler::record(Phase::AWAKE_TOTAL, 1234);
+
+    String payload = WakeProfiler::createSummaryPayload("aa:bb");
+    TEST_ASSERT_TRUE(payload.indexOf("\"device_id\": \"aa:bb\"") >= 0);
+    TEST_ASSERT_TRUE(payload.indexOf("\"wake_count\": 1") >= 0);
+    TEST_ASSERT_TRUE(payload.indexOf("\"awake_total\": {\"count\": 1, \"min_ms\": 1234") >= 0);
+    for (size_t i = 0; i < static_cast<size_t>(Phase::COUNT); i++) {
+        String key = String("\"") + WakeProfiler::getPhaseName(static_cast<Phase>(i)) + "\"";
+        TEST_ASSERT_TRUE(payload.indexOf(key) >= 0);
+    }
+}
+
+void test_awake_total_is_recorded_by_the_next_wake(void) {
+    WakeProfiler::beginWake(0);
+    WakeProfiler::endWake(12721);
+    TEST_ASSERT_EQUAL_UINT32(0, WakeProfiler::getStats(Phase::AWAKE_TOTAL).count);
+
+    WakeProfiler::beginWake(300);
+    const WakeProfiler::PhaseStats& stats = WakeProfiler::getStats(Phase::AWAKE_TOTAL);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(12721, stats.maxMs);
+
+    // Recorded once only, and carried into the window that follows a summary
+    WakeProfiler::reset(300);
+    WakeProfiler::endWake(9267);
+    WakeProfiler::beginWake(600);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(9267, stats.minMs);
+    TEST_ASSERT_EQUAL_UINT32(1, WakeProfiler::getWakeCount());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_records_min_mean_max);
+    RUN_TEST(test_summary_is_due_after_the_interval_not_a_wake_count);
+    RUN_TEST(test_summary_payload_lists_every_phase);
+    RUN_TEST(test_awake_total_is_recorded_by_the_next_wake);
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file test_main.cpp
+ * @brief WiFiConnectionCache validation, reuse limit and corruption checks
+ */
+
+#include <unity.h>
+#include <stddef.h>
+#include <string.h>
+#include "WiFiConnectionCache.h"
+
+namespace {
+
+constexpr const char* SSID = "greenhouse";
+constexpr uint8_t BSSID[6] = {0x9C, 0x53, 0x22, 0x41, 0x7E, 0x10};
+constexpr uint32_t LOCAL_IP = 0x5701A8C0;   // 192.168.1.87
+constexpr uint32_t GATEWAY = 0x0101A8C0;
+constexpr uint32_t SUBNET = 0x00FFFFFF;
+
+WiFiConnectionCache::Record record;
+
+void storeDefault(WiFiConnectionCache& cache) {
+    cache.store(SSID, BSSID, 6, LOCAL_IP, GATEWAY, SUBNET, GATEWAY);
+}
+
+} // namespace
+
+void setUp(void) {
+    // RTC memory holds whatever was there at power-on
+    memset(&record, 0xA5, sizeof(record));
+}
+
+void tearDown(void) {
+}
+
+void test_uninitialized_record_is_not_usable(void) {
+    WiFiConnectionCache cache(record);
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+
+    memset(&record, 0, sizeof(record));
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+}
+
+void test_stored_connection_is_usable(void) {
+    WiFiConnectionCache cache(record);
+    storeDefault(cache);
+
+    TEST_ASSERT_TRUE(cache.isUsableFor(SSID));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(BSSID, cache.get().bssid, 6);
+    TEST_ASSERT_EQUAL_UINT8(6, cache.get().channel);
+    TEST_ASSERT_EQUAL_UINT32(LOCAL_IP, cache.get().localIP);
+    TEST_ASSERT_EQUAL_UINT32(GATEWAY, cache.get().gateway);
+    TEST_ASSERT_EQUAL_UINT32(SUBNET, cache.get().subnet);
+    TEST_ASSERT_EQUAL_UINT32(0, cache.get().reuseCount);
+}
+
+void test_record_is_not_used_for_another_network(void) {
+    WiFiConnectionCache cache(record);
+    storeDefault(cache);
+    TEST_ASSERT_FALSE(cache.isUsableFor("greenhouse-5g"));
+    TEST_ASSERT_FALSE(cache.isUsableFor(""));
+}
+
+void test_incomplete_connection_is_not_stored(void) {
+    WiFiConnectionCache cache(record);
+
+    storeDefault(cache);
+    cache.store(SSID, nullptr, 6, LOCAL_IP, GATEWAY, SUBNET, GATEWAY);
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+
+    storeDefault(cache);
+    cache.store(SSID, BSSID, 0, LOCAL_IP, GATEWAY, SUBNET, GATEWAY);
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+
+    storeDefault(cache);
+    cache.store(SSID, BSSID, 6, 0, GATEWAY, SUBNET, GATEWAY);
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+}
+
+void test_lease_is_renewed_after_the_reuse_limit(void) {
+    WiFiConnectionCache cache(record);
+    storeDefault(cache);
+
+    for (uint32_t i = 0; i < Config::WIFI_CACHE_MAX_REUSES; i++) {
+        TEST_ASSERT_TRUE(cache.isUsableFor(SSID));
+        cache.markReused();
+    }
+    TEST_ASSERT_EQUAL_UINT32(Config::WIFI_CACHE_MAX_REUSES, cache.get().reuseCount);
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+
+    // A full connection starts the count again
+    storeDefault(cache);
+    TEST_ASSERT_TRUE(cache.isUsableFor(SSID));
+}
+
+void test_invalidate_forgets_the_connection(void) {
+    WiFiConnectionCache cache(record);
+    storeDefault(cache);
+    cache.invalidate();
+
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+    TEST_ASSERT_EQUAL_UINT32(0, cache.get().localIP);
+    TEST_ASSERT_EQUAL_UINT8(0, cache.get().channel);
+}
+
+void test_corrupted_record_is_rejected(void) {
+    WiFiConnectionCache cache(record);
+
+    // Every byte before the CRC is covered, not only the checked fields
+    for (size_t offset = 0; offset < offsetof(WiFiConnectionCache::Record, crc); offset++) {
+        storeDefault(cache);
+        reinterpret_cast<uint8_t*>(&record)[offset] ^= 0x01;
+        TEST_ASSERT_FALSE_MESSAGE(cache.isUsableFor(SSID), "bit flip not detected");
+    }
+
+    storeDefault(cache);
+    record.crc ^= 0x80000000;
+    TEST_ASSERT_FALSE(cache.isUsableFor(SSID));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_uninitialized_record_is_not_usable);
+    RUN_TEST(test_stored_connection_is_usable);
+    RUN_TEST(test_record_is_not_used_for_another_network);
+    RUN_TEST(test_incomplete_connection_is_not_stored);
+    RUN_TEST(test_lease_is_renewed_after_the_reuse_limit);
+    RUN_TEST(test_invalidate_forgets_the_connection);
+    RUN_TEST(test_corrupted_record_is_rejected);
+    return UNITY_END();
+}